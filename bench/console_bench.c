@@ -0,0 +1,109 @@
+/*
+ * Console benchmark: a 320x180 cell grid on the CP437 sheet, rendered
+ * headless on SDL's software renderer against the 16.7 ms of a 60 FPS frame.
+ *
+ *   full    every cell changes every frame (worst case, all cells redrawn)
+ *   5%      a twentieth of the cells change per frame (a busy game screen)
+ *   idle    nothing changes: a diff and the cache copy
+ *
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -std=gnu11 -Isrc bench/console_bench.c src/core/render/console.c \
+ *       src/core/render/sprite_batch.c src/core/render/glyph_cache.c \
+ *       src/core/resources/texture_atlas.c src/core/resources/resource_paths.c \
+ *       src/core/resources/resource_cache.c \
+ *       $(sdl2-config --cflags --libs) -lSDL2_image -lSDL2_ttf -o console_bench
+ *   ./console_bench [frames]
+ */
+#define CONQUEST_LOG_IMPLEMENTATION
+#include "utils/log.h"
+#include "core/render/console.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define COLS        320
+#define ROWS        180
+#define CELL        8
+#define SHEET       "src/resources/images/fonts/cp437_8x8.png"
+#define FRAME_MS    (1000.0 / 60.0)
+
+static double now_ms(void) {
+    return (double)SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static SDL_Color random_color(void) {
+    return (SDL_Color){(Uint8)rand(), (Uint8)rand(), (Uint8)rand(), 255};
+}
+
+static void scribble(Console *con, int cells) {
+    for (int i = 0; i < cells; i++)
+        console_put(con, rand() % COLS, rand() % ROWS, 0x21 + rand() % 0x5E,
+                    random_color(), random_color());
+}
+
+/* Returns the average frame time; |changes| cells are rewritten per frame */
+static double run(Console *con, SDL_Renderer *ren, int frames, int changes,
+                  ConsoleStats *last) {
+    double t0 = now_ms();
+    for (int f = 0; f < frames; f++) {
+        if (changes >= COLS * ROWS) {
+            for (int y = 0; y < ROWS; y++)
+                for (int x = 0; x < COLS; x++)
+                    console_put(con, x, y, 0x21 + (x + y + f) % 0x5E,
+                                random_color(), random_color());
+        } else {
+            scribble(con, changes);
+        }
+        console_render(con, ren, NULL);
+        SDL_RenderPresent(ren);
+    }
+    *last = console_stats(con);
+    return (now_ms() - t0) / frames;
+}
+
+static void report(const char *name, double ms, ConsoleStats s) {
+    printf("%-5s %8.3f ms/frame  %6d cells  %3d draw calls  %s\n", name, ms,
+           s.cells_drawn, s.draw_calls, ms <= FRAME_MS ? "60 FPS" : "over budget");
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 120;
+    if (frames < 1) frames = 1;
+    log_init(NULL);
+    log_set_level(LOG_LEVEL_WARN);
+    if (SDL_Init(SDL_INIT_VIDEO) != 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        fprintf(stderr, "init: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Surface *target = SDL_CreateRGBSurfaceWithFormat(0, COLS * CELL, ROWS * CELL, 32,
+                                                         SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer *ren = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+    SDL_Surface *sheet = IMG_Load(SHEET);
+    if (!ren || !sheet) {
+        fprintf(stderr, "setup: %s\n", SDL_GetError());
+        return 1;
+    }
+    AtlasRegion font = {SDL_CreateTextureFromSurface(ren, sheet), {0, 0, sheet->w, sheet->h}, -1};
+    SDL_FreeSurface(sheet);
+    Console *con = font.texture ? console_create(COLS, ROWS, font, CELL, CELL) : NULL;
+    if (!con) return 1;
+
+    srand(1);
+    console_clear(con, (SDL_Color){0, 0, 0, 255});
+    ConsoleStats stats;
+    printf("%dx%d cells, %d frames, software renderer\n", COLS, ROWS, frames);
+    report("full", run(con, ren, frames, COLS * ROWS, &stats), stats);
+    report("5%", run(con, ren, frames, COLS * ROWS / 20, &stats), stats);
+    report("idle", run(con, ren, frames, 0, &stats), stats);
+
+    console_destroy(con);
+    SDL_DestroyTexture(font.texture);
+    SDL_DestroyRenderer(ren);
+    SDL_FreeSurface(target);
+    IMG_Quit();
+    SDL_Quit();
+    log_shutdown();
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * ECS benchmark: one million entities with Position and Velocity.
+ *
+ *   create    ecs_create_many into one archetype, then values set per entity
+ *   iterate   a query over both columns integrating positions, per frame
+ *   lookup    ecs_get of Position for entities in random order
+ *   churn     destroy every other entity, then create as many again
+ *
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -std=gnu11 -Isrc bench/ecs_bench.c src/game/entities/ecs.c \
+ *       src/game/entities/entity.c src/game/entities/sparse_set.c \
+ *       $(sdl2-config --cflags --libs) -o ecs_bench
+ *   ./ecs_bench [entities] [frames]
+ */
+#define CONQUEST_LOG_IMPLEMENTATION
+#include "utils/log.h"
+#include "game/entities/ecs.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct Position { float x, y; } Position;
+typedef struct Velocity { float dx, dy; } Velocity;
+
+static double now_ms(void) {
+    return SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static void report(const char *name, double ms, int ops) {
+    printf("%-8s %10.3f ms  %8.2f ns/entity\n", name, ms, ms * 1e6 / ops);
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    int frames = argc > 2 ? atoi(argv[2]) : 20;
+    if (count < 2) count = 2;
+    if (frames < 1) frames = 1;
+    log_init(NULL);
+    log_set_level(LOG_LEVEL_WARN);
+
+    EcsWorld *w = ecs_world_create();
+    Entity *ids = malloc(sizeof *ids * count);
+    if (!w || !ids) return 1;
+    ComponentId pos = ECS_REGISTER(w, Position);
+    ComponentId vel = ECS_REGISTER(w, Velocity);
+    ComponentId both[] = {pos, vel};
+    printf("%d entities, %d frames\n", count, frames);
+
+    double t = now_ms();
+    int made = ecs_create_many(w, both, 2, count, ids);
+    for (int i = 0; i < made; i++) {
+        ecs_set(w, ids[i], pos, &(Position){(float)i, 0.0f});
+        ecs_set(w, ids[i], vel, &(Velocity){1.0f, (float)(i & 7)});
+    }
+    report("create", now_ms() - t, count);
+    if (made != count) {
+        fprintf(stderr, "only %d of %d entities made\n", made, count);
+        return 1;
+    }
+
+    EcsQuery q;
+    ecs_query_init(&q, both, 2, NULL, 0);
+    ecs_query_update(&q, w);
+    t = now_ms();
+    for (int f = 0; f < frames; f++) {
+        EcsIter it = ecs_query_iter(w, &q);
+        while (ecs_iter_next(&it)) {
+            Position *p = ECS_COLUMN_MUT(&it, Position, pos);
+            const Velocity *v = ECS_COLUMN(&it, Velocity, vel);
+            for (int i = 0; i < it.count; i++) {
+                p[i].x += v[i].dx * (1.0f / 60.0f);
+                p[i].y += v[i].dy * (1.0f / 60.0f);
+            }
+        }
+    }
+    report("iterate", (now_ms() - t) / frames, count);
+
+    /* shuffled so every lookup misses the previous one's cache line */
+    srand(1);
+    for (int i = count - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        Entity swap = ids[i];
+        ids[i] = ids[j];
+        ids[j] = swap;
+    }
+    float sum = 0.0f;
+    t = now_ms();
+    for (int i = 0; i < count; i++)
+        sum += ((const Position *)ecs_get(w, ids[i], pos))->x;
+    report("lookup", now_ms() - t, count);
+
+    int half = count / 2;
+    t = now_ms();
+    for (int i = 0; i < half; i++)
+        ecs_destroy(w, ids[i * 2]);
+    ecs_create_many(w, both, 2, half, NULL);
+    report("churn", now_ms() - t, half * 2);
+
+    printf("(checksum %.1f, %d alive)\n", sum, ecs_count(w));
+    ecs_query_free(&q);
+    ecs_world_destroy(w);
+    free(ids);
+    log_shutdown();
+    return 0;
+}
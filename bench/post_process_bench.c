@@ -0,0 +1,108 @@
+/*
+ * Post-process benchmark: each filter alone on a 1920x1080 frame, on every
+ * SIMD path the CPU supports, single threaded so the kernels are compared
+ * and not the pool. Each path's output is checked against the scalar one.
+ *
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -std=gnu11 -Isrc bench/post_process_bench.c src/core/render/post_process.c \
+ *       src/core/jobs/worker_pool.c $(sdl2-config --cflags --libs) -lm \
+ *       -o post_process_bench
+ *   ./post_process_bench [frames]
+ */
+#define CONQUEST_LOG_IMPLEMENTATION
+#include "utils/log.h"
+#include "core/render/post_process.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FRAME_W 1920
+#define FRAME_H 1080
+#define FOG_COLS 120
+#define FOG_ROWS 68
+
+static const char *FILTER_NAMES[POST_FILTER_COUNT] = {"lut", "fog", "vignette", "scanlines"};
+static const char *SIMD_NAMES[] = {"scalar", "sse2", "avx2"};
+
+static void configure(PostProcess *pp) {
+    Uint8 r[256], g[256], b[256];
+    for (int i = 0; i < 256; i++) {
+        r[i] = (Uint8)(i * i / 255);
+        g[i] = (Uint8)i;
+        b[i] = (Uint8)(255 - (255 - i) * (255 - i) / 255);
+    }
+    post_process_set_lut(pp, r, g, b);
+
+    static Uint8 light[FOG_COLS * FOG_ROWS];
+    for (int i = 0; i < FOG_COLS * FOG_ROWS; i++)
+        light[i] = (Uint8)((i * 37) & 0xFF);
+    SDL_FRect area = {0.f, 0.f, (float)FRAME_W, (float)FRAME_H};
+    post_process_set_fog(pp, light, FOG_COLS, FOG_ROWS, &area);
+    post_process_set_vignette(pp, 0.6f, 0.3f);
+    post_process_set_scanlines(pp, 2, 0.35f);
+}
+
+/* Largest per-channel difference between two frames */
+static int max_error(const Uint32 *a, const Uint32 *b, size_t n) {
+    int worst = 0;
+    for (size_t i = 0; i < n; i++)
+        for (int shift = 0; shift < 32; shift += 8) {
+            int d = abs((int)(a[i] >> shift & 0xFF) - (int)(b[i] >> shift & 0xFF));
+            if (d > worst) worst = d;
+        }
+    return worst;
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 60;
+    if (frames < 1) frames = 1;
+    log_init(NULL);
+    log_set_level(LOG_LEVEL_WARN);
+
+    size_t n = (size_t)FRAME_W * FRAME_H;
+    Uint32 *source = malloc(n * sizeof *source);
+    Uint32 *frame = malloc(n * sizeof *frame);
+    Uint32 *reference = malloc(n * sizeof *reference);
+    PostProcess *pp = post_process_create();
+    if (!source || !frame || !reference || !pp) return 1;
+    srand(1);
+    for (size_t i = 0; i < n; i++)
+        source[i] = 0xFF000000u | ((Uint32)rand() << 8 ^ (Uint32)rand());
+    configure(pp);
+
+    PostSimd best = post_process_simd(pp);
+    printf("%dx%d, %d frames per run, best path %s\n", FRAME_W, FRAME_H, frames,
+           SIMD_NAMES[best]);
+    printf("%-10s", "filter");
+    for (int s = POST_SIMD_SCALAR; s <= (int)best; s++)
+        printf("  %9s ms  err", SIMD_NAMES[s]);
+    printf("\n");
+
+    for (int f = 0; f < POST_FILTER_COUNT; f++) {
+        for (int other = 0; other < POST_FILTER_COUNT; other++)
+            post_process_set_enabled(pp, (PostFilter)other, other == f);
+        printf("%-10s", FILTER_NAMES[f]);
+
+        for (int s = POST_SIMD_SCALAR; s <= (int)best; s++) {
+            post_process_set_simd(pp, (PostSimd)s);
+            double ms = 0.0;
+            for (int i = 0; i < frames; i++) {
+                memcpy(frame, source, n * sizeof *frame);
+                post_process_apply(pp, frame, FRAME_W, FRAME_H, FRAME_W * 4, NULL);
+                ms += post_process_stats(pp).filter_ms[f];
+            }
+            if (s == POST_SIMD_SCALAR) memcpy(reference, frame, n * sizeof *frame);
+            printf("  %12.3f  %3d", ms / frames, max_error(reference, frame, n));
+        }
+        printf("\n");
+    }
+
+    post_process_destroy(pp);
+    free(reference);
+    free(frame);
+    free(source);
+    log_shutdown();
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * Render command benchmark: 64 recorded lists of 500 sprites each per frame
+ * on SDL's software renderer, all on one atlas page, the way small recorded
+ * layers share the tileset.
+ *
+ *   record    every list filled on the main thread
+ *   parallel  the same lists filled on the worker pool, one job per list
+ *   per-list  one render_cmd_execute() per list, as separate passes
+ *   merged    one render_cmd_execute() over all the lists
+ *
+ * Rendering goes to an offscreen surface; no window.
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -std=gnu11 -Isrc bench/render_commands_bench.c \
+ *       src/core/render/render_commands.c src/core/render/sprite_batch.c \
+ *       src/core/render/glyph_cache.c src/core/jobs/worker_pool.c \
+ *       src/core/resources/texture_atlas.c src/core/resources/resource_paths.c \
+ *       src/core/resources/resource_cache.c \
+ *       $(sdl2-config --cflags --libs) -lSDL2_image -lSDL2_ttf -o render_commands_bench
+ *   ./render_commands_bench [frames]
+ */
+#define CONQUEST_LOG_IMPLEMENTATION
+#include "utils/log.h"
+#include "core/jobs/worker_pool.h"
+#include "core/render/render_commands.h"
+#include "core/render/sprite_batch.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LISTS     64
+#define SPRITES   500
+#define SCREEN_W  1280
+#define SCREEN_H  720
+
+typedef struct Recording {
+    RenderCommandList *list;
+    SDL_Texture       *texture;
+    unsigned           seed;
+} Recording;
+
+static double now_ms(void) {
+    return (double)SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static unsigned next_rand(unsigned *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+/* What a props or entity layer does: walk its items, emit one sprite each */
+static void record_list(void *userdata) {
+    Recording *r = userdata;
+    unsigned seed = r->seed;
+    SDL_Color white = {255, 255, 255, 255};
+    render_cmd_list_reset(r->list);
+    for (int i = 0; i < SPRITES; i++) {
+        unsigned v = next_rand(&seed);
+        SDL_Rect src = {(int)(v % 8) * 8, (int)(v / 8 % 8) * 8, 8, 8};
+        SDL_FRect dst = {(float)(next_rand(&seed) % (SCREEN_W - 8)),
+                         (float)(next_rand(&seed) % (SCREEN_H - 8)), 8.0f, 8.0f};
+        render_cmd_sprite(r->list, r->texture, &src, &dst, white);
+    }
+}
+
+static SDL_Texture *make_texture(SDL_Renderer *ren) {
+    SDL_Surface *s = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!s) return NULL;
+    SDL_FillRect(s, NULL, SDL_MapRGBA(s->format, 90, 200, 120, 255));
+    SDL_Texture *t = SDL_CreateTextureFromSurface(ren, s);
+    SDL_FreeSurface(s);
+    return t;
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 60;
+    if (frames < 1) frames = 1;
+    log_init(NULL);
+    log_set_level(LOG_LEVEL_WARN);
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        fprintf(stderr, "SDL_Init: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Surface *target = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_W, SCREEN_H, 32,
+                                                         SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer *ren = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+    SDL_Texture *texture = ren ? make_texture(ren) : NULL;
+    if (!texture) {
+        fprintf(stderr, "software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SpriteBatch *batch = sprite_batch_create(LISTS * SPRITES);
+    WorkerPool *pool = worker_pool_create(0);
+    RenderCommandList *lists[LISTS];
+    Recording recordings[LISTS];
+    for (int l = 0; l < LISTS; l++) {
+        lists[l] = render_cmd_list_create();
+        if (!lists[l]) return 1;
+        recordings[l] = (Recording){lists[l], texture, 0x9E3779B9u * (unsigned)(l + 1)};
+    }
+    if (!batch) return 1;
+
+    double t0 = now_ms();
+    for (int f = 0; f < frames; f++)
+        for (int l = 0; l < LISTS; l++)
+            record_list(&recordings[l]);
+    double record_ms = (now_ms() - t0) / frames;
+
+    WorkerBatch jobs = {0};
+    t0 = now_ms();
+    for (int f = 0; f < frames; f++) {
+        for (int l = 0; l < LISTS; l++)
+            if (worker_pool_submit_batch(pool, &jobs, record_list, &recordings[l]) != 0)
+                record_list(&recordings[l]);
+        worker_pool_wait_batch(pool, &jobs);
+    }
+    double parallel_ms = (now_ms() - t0) / frames;
+
+    RenderCmdOrder order = {0};
+    int per_list_calls = 0;
+    t0 = now_ms();
+    for (int f = 0; f < frames; f++) {
+        SDL_RenderClear(ren);
+        per_list_calls = 0;
+        for (int l = 0; l < LISTS; l++) {
+            render_cmd_execute(&lists[l], 1, &order, ren, batch, NULL);
+            per_list_calls += sprite_batch_stats(batch).draw_calls;
+        }
+        SDL_RenderPresent(ren);
+    }
+    double per_list_ms = (now_ms() - t0) / frames;
+
+    t0 = now_ms();
+    for (int f = 0; f < frames; f++) {
+        SDL_RenderClear(ren);
+        render_cmd_execute(lists, LISTS, &order, ren, batch, NULL);
+        SDL_RenderPresent(ren);
+    }
+    double merged_ms = (now_ms() - t0) / frames;
+    int merged_calls = sprite_batch_stats(batch).draw_calls;
+
+    printf("%d lists x %d sprites, %d frames, %d worker threads\n", LISTS, SPRITES,
+           frames, worker_pool_thread_count(pool));
+    printf("record    %8.3f ms/frame\n", record_ms);
+    printf("parallel  %8.3f ms/frame\n", parallel_ms);
+    printf("per-list  %8.3f ms/frame  %6d draw calls\n", per_list_ms, per_list_calls);
+    printf("merged    %8.3f ms/frame  %6d draw calls\n", merged_ms, merged_calls);
+
+    render_cmd_order_free(&order);
+    for (int l = 0; l < LISTS; l++)
+        render_cmd_list_destroy(lists[l]);
+    worker_pool_destroy(pool);
+    sprite_batch_destroy(batch);
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(ren);
+    SDL_FreeSurface(target);
+    SDL_Quit();
+    log_shutdown();
+    return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * System scheduler benchmark: ten systems over 500k entities.
+ *
+ *   inline    no worker pool, systems run one after the other
+ *   pool      a worker pool borrowed the way the game lends the
+ *             RenderService one; systems split into chunk ranges and
+ *             non-conflicting ones overlap
+ *   empty     a run with no systems registered, the per-frame floor
+ *
+ * Every entity has ten float components; each system writes one and most
+ * read another, so some pairs conflict and keep their order while the
+ * rest may run side by side.
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -std=gnu11 -Isrc bench/scheduler_bench.c src/game/entities/scheduler.c \
+ *       src/game/entities/ecs.c src/game/entities/entity.c src/game/entities/sparse_set.c \
+ *       src/game/entities/command_buffer.c src/core/jobs/worker_pool.c \
+ *       $(sdl2-config --cflags --libs) -o scheduler_bench
+ *   ./scheduler_bench [entities] [frames]
+ */
+#define CONQUEST_LOG_IMPLEMENTATION
+#include "utils/log.h"
+#include "game/entities/scheduler.h"
+#include "core/jobs/worker_pool.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define COMPONENTS 10
+#define NO_READ    (-1)
+
+static const char *NAMES[COMPONENTS] = {
+    "Position", "Velocity", "Accel", "Health", "Regen",
+    "Heat", "Age", "Score", "Color", "Spin",
+};
+
+/* Written and read component of each system, by index into NAMES */
+static const int SYSTEMS[][2] = {
+    {1, 2},        /* accelerate: Velocity from Accel   */
+    {0, 1},        /* integrate:  Position from Velocity */
+    {3, 4},        /* regen:      Health from Regen      */
+    {5, NO_READ},  /* cool                                */
+    {6, NO_READ},  /* age                                 */
+    {7, 6},        /* score:      Score from Age         */
+    {9, NO_READ},  /* spin                                */
+    {8, 5},        /* fade:       Color from Heat        */
+    {0, NO_READ},  /* wrap:       Position again         */
+    {2, NO_READ},  /* drag                                */
+};
+#define SYSTEM_COUNT (int)(sizeof SYSTEMS / sizeof SYSTEMS[0])
+
+typedef struct Columns {
+    ComponentId write, read;
+    bool        has_read;
+} Columns;
+
+static double now_ms(void) {
+    return SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static void system_step(EcsIter *it, float dt, void *userdata) {
+    const Columns *c = userdata;
+    float *out = ecs_iter_column_mut(it, c->write);
+    const float *in = c->has_read ? ecs_iter_column(it, c->read) : NULL;
+    for (int i = 0; i < it->count; i++)
+        out[i] = out[i] * 0.999f + (in ? in[i] : 1.0f) * dt;
+}
+
+/* Runs |frames| frames and returns ms per frame; |with_systems| false
+   leaves the scheduler empty */
+static double run(WorkerPool *pool, int count, int frames, bool with_systems) {
+    EcsWorld *w = ecs_world_create();
+    if (!w) exit(1);
+    ComponentId ids[COMPONENTS];
+    for (int i = 0; i < COMPONENTS; i++)
+        ids[i] = ecs_register_component(w, NAMES[i], sizeof(float), _Alignof(float),
+                                        ECS_STORAGE_TABLE);
+    ecs_create_many(w, ids, COMPONENTS, count, NULL);
+
+    EcsScheduler *s = ecs_scheduler_create(w, pool);
+    static Columns columns[SYSTEM_COUNT];
+    for (int i = 0; with_systems && i < SYSTEM_COUNT; i++) {
+        Columns *c = &columns[i];
+        c->write = ids[SYSTEMS[i][0]];
+        c->has_read = SYSTEMS[i][1] != NO_READ;
+        c->read = c->has_read ? ids[SYSTEMS[i][1]] : 0;
+        ComponentId all[2] = {c->write, c->read};
+        ecs_scheduler_add(s, &(EcsSystemDesc){
+            .name = NAMES[SYSTEMS[i][0]],
+            .all = all, .all_count = c->has_read ? 2 : 1,
+            .writes = &c->write, .write_count = 1,
+            .fn = system_step, .userdata = c,
+        });
+    }
+
+    ecs_scheduler_run(s, 1.0f / 60.0f);      /* plans and queries settle */
+    double start = now_ms();
+    for (int f = 0; f < frames; f++)
+        ecs_scheduler_run(s, 1.0f / 60.0f);
+    double ms = (now_ms() - start) / frames;
+
+    ecs_scheduler_destroy(s);
+    ecs_world_destroy(w);
+    return ms;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 500000;
+    int frames = argc > 2 ? atoi(argv[2]) : 30;
+    if (count < 1) count = 1;
+    if (frames < 1) frames = 1;
+    log_init(NULL);
+    log_set_level(LOG_LEVEL_WARN);
+
+    WorkerPool *pool = worker_pool_create(0);
+    printf("%d systems, %d entities, %d frames, %d worker threads\n", SYSTEM_COUNT,
+           count, frames, worker_pool_thread_count(pool));
+    printf("inline  %9.3f ms/frame\n", run(NULL, count, frames, true));
+    printf("pool    %9.3f ms/frame\n", run(pool, count, frames, true));
+    printf("empty   %9.3f us/frame\n", run(pool, count, frames, false) * 1000.0);
+
+    worker_pool_destroy(pool);
+    log_shutdown();
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * One-shot SFX benchmark: 1000 rapid plays of the same sound.
+ *
+ *   before  open + Mix_LoadWAV + play + free for every play, which is what
+ *           am_play_oneshot did before one-shots shared a cached chunk
+ *   after   am_play_oneshot through the ResourceManager chunk cache
+ *
+ * Runs headless on SDL's dummy audio driver unless SDL_AUDIODRIVER is set.
+ * Build and run from the repository root:
+ *
+ *   R=src/core/resources
+ *   gcc -O2 -std=gnu11 -Isrc bench/sfx_oneshot_bench.c src/core/audio/audio_manager.c \
+ *       $R/resource_manager.c $R/resource_cache.c $R/resource_groups.c \
+ *       $R/resource_paths.c $R/texture_atlas.c src/core/jobs/worker_pool.c \
+ *       src/core/render/glyph_cache.c src/core/render/sprite_batch.c \
+ *       $(sdl2-config --cflags --libs) -lSDL2_mixer -lSDL2_image -lSDL2_ttf \
+ *       -lpthread -o sfx_oneshot_bench
+ *   ./sfx_oneshot_bench [path/to/sound.wav]
+ */
+#define CONQUEST_LOG_IMPLEMENTATION
+#include "utils/log.h"
+#include "core/audio/audio_manager.h"
+#include "core/resources/resource_manager.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <stdio.h>
+
+#define PLAYS 1000
+
+static double now_ms(void) {
+    return (double)SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+/* The old path: check the file exists, decode it, play it, drop it */
+static int play_decoding(const char *path, int channel) {
+    SDL_RWops *probe = SDL_RWFromFile(path, "rb");
+    if (!probe) return 0;
+    SDL_RWclose(probe);
+    Mix_Chunk *chunk = Mix_LoadWAV(path);
+    if (!chunk) return 0;
+    Mix_HaltChannel(channel);
+    int ok = Mix_PlayChannel(channel, chunk, 0) != -1;
+    Mix_HaltChannel(channel);            /* stop it before the chunk goes */
+    Mix_FreeChunk(chunk);
+    return ok;
+}
+
+static void report(const char *name, int played, double ms) {
+    printf("%-8s %4d/%d plays  %8.2f ms  %7.2f us/play\n", name, played, PLAYS, ms,
+           ms * 1000.0 / PLAYS);
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "src/resources/audio/sfx/menu_select.wav";
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    log_init(NULL);
+    log_set_level(LOG_LEVEL_WARN);
+    if (SDL_Init(SDL_INIT_AUDIO) != 0) {
+        fprintf(stderr, "SDL_Init: %s\n", SDL_GetError());
+        return 1;
+    }
+    AudioManager *am = am_create(1);       /* opens the mixer */
+    ResourceManager *rm = resource_manager_create();
+    if (!am || !rm) return 1;
+    am_set_resource_manager(am, rm);
+
+    int played = 0;
+    double t0 = now_ms();
+    for (int i = 0; i < PLAYS; i++)
+        played += play_decoding(path, i % AM_CHANNELS);
+    report("before", played, now_ms() - t0);
+
+    played = 0;
+    t0 = now_ms();
+    for (int i = 0; i < PLAYS; i++)
+        played += am_play_oneshot(am, path, MIX_MAX_VOLUME / 4);
+    report("after", played, now_ms() - t0);
+
+    Mix_HaltChannel(-1);
+    am_destroy(am);
+    resource_manager_destroy(rm);
+    Mix_CloseAudio();
+    SDL_Quit();
+    log_shutdown();
+    return 0;
+}
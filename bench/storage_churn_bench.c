@@ -0,0 +1,122 @@
+/*
+ * Component storage benchmark: a component added to and removed from many
+ * entities every frame, stored in archetype tables or in a sparse set.
+ *
+ *   churn     ecs_add then ecs_remove of Burning on a rotating tenth of
+ *             the entities
+ *   iterate   a Position/Velocity query over everyone afterwards, which
+ *             pays for any archetype fragmentation the churn left behind
+ *   burning   a query for Burning entities only
+ *
+ * A table component moves its entity between archetypes on every add and
+ * remove; a sparse one leaves the rows where they are.
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -std=gnu11 -Isrc bench/storage_churn_bench.c src/game/entities/ecs.c \
+ *       src/game/entities/entity.c src/game/entities/sparse_set.c \
+ *       $(sdl2-config --cflags --libs) -o storage_churn_bench
+ *   ./storage_churn_bench [entities] [frames]
+ */
+#define CONQUEST_LOG_IMPLEMENTATION
+#include "utils/log.h"
+#include "game/entities/ecs.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHURN_SHARE 10   /* one entity in this many changes per frame */
+
+typedef struct Position { float x, y; } Position;
+typedef struct Velocity { float dx, dy; } Velocity;
+typedef struct Burning  { float left; } Burning;
+
+typedef struct Timing {
+    double churn, iterate, burning;
+    float  checksum;
+} Timing;
+
+static double now_ms(void) {
+    return SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static float position_sum(EcsWorld *w, EcsQuery *q, ComponentId pos) {
+    float sum = 0.0f;
+    EcsIter it = ecs_query_iter(w, q);
+    while (ecs_iter_next(&it)) {
+        const Position *p = ECS_COLUMN(&it, Position, pos);
+        for (int i = 0; i < it.count; i++)
+            sum += p[i].x + 1.0f;
+    }
+    return sum;
+}
+
+static Timing run(EcsStorage storage, int count, int frames) {
+    Timing t = {0};
+    EcsWorld *w = ecs_world_create();
+    Entity *ids = malloc(sizeof *ids * count);
+    if (!w || !ids) exit(1);
+    ComponentId pos = ECS_REGISTER(w, Position);
+    ComponentId vel = ECS_REGISTER(w, Velocity);
+    ComponentId burn = ecs_register_component(w, "Burning", sizeof(Burning),
+                                              _Alignof(Burning), storage);
+    ComponentId moving[] = {pos, vel};
+    ecs_create_many(w, moving, 2, count, ids);
+
+    EcsQuery all, burning;
+    ecs_query_init(&all, moving, 2, NULL, 0);
+    ecs_query_init(&burning, &burn, 1, NULL, 0);
+    int share = count / CHURN_SHARE;
+
+    for (int f = 0; f < frames; f++) {
+        /* this frame's tenth catches fire, last frame's goes out */
+        int on = (f % CHURN_SHARE) * share;
+        int off = ((f + CHURN_SHARE - 1) % CHURN_SHARE) * share;
+        double start = now_ms();
+        for (int i = 0; i < share; i++) {
+            ecs_add(w, ids[on + i], burn);
+            if (f) ecs_remove(w, ids[off + i], burn);
+        }
+        t.churn += now_ms() - start;
+
+        start = now_ms();
+        ecs_query_update(&all, w);
+        t.checksum += position_sum(w, &all, pos);
+        t.iterate += now_ms() - start;
+
+        start = now_ms();
+        ecs_query_update(&burning, w);
+        t.checksum += position_sum(w, &burning, pos);
+        t.burning += now_ms() - start;
+    }
+
+    ecs_query_free(&all);
+    ecs_query_free(&burning);
+    ecs_world_destroy(w);
+    free(ids);
+    t.churn /= frames;
+    t.iterate /= frames;
+    t.burning /= frames;
+    return t;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 200000;
+    int frames = argc > 2 ? atoi(argv[2]) : 50;
+    if (count < CHURN_SHARE) count = CHURN_SHARE;
+    if (frames < 2) frames = 2;
+    log_init(NULL);
+    log_set_level(LOG_LEVEL_WARN);
+
+    printf("%d entities, %d changing per frame, %d frames (ms per frame)\n",
+           count, count / CHURN_SHARE * 2, frames);
+    printf("%-8s %10s %10s %10s %12s\n", "storage", "churn", "iterate", "burning", "checksum");
+    Timing table = run(ECS_STORAGE_TABLE, count, frames);
+    printf("%-8s %10.3f %10.3f %10.3f %12.0f\n", "table", table.churn, table.iterate,
+           table.burning, table.checksum);
+    Timing sparse = run(ECS_STORAGE_SPARSE, count, frames);
+    printf("%-8s %10.3f %10.3f %10.3f %12.0f\n", "sparse", sparse.churn, sparse.iterate,
+           sparse.burning, sparse.checksum);
+
+    log_shutdown();
+    return 0;
+}
@@ -1,11 +1,33 @@
 // audio_manager.c
 #include "audio_manager.h"
+#include "../resources/resource_manager.h"
 #include "../../utils/log.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define AM_ONESHOT_MAP_CAPACITY 64
+#define AM_RETRY_FIRST_MS       250    /* first wait after a failed load */
+#define AM_RETRY_MAX_MS         8000   /* backoff doubles up to this     */
+
+/* A one-shot sound and how many voices of it are currently playing */
+typedef struct OneShotSound {
+    char        *path;
+    int          max_voices;
+    SDL_atomic_t voices;
+    Mix_Chunk   *own_chunk;   /* only used when no ResourceManager is set */
+    Uint32       retry_at;    /* after a failed load, no disk hits until then */
+    Uint32       retry_ms;    /* current backoff, 0 while the sound loads */
+} OneShotSound;
+
+/* Which one-shot owns each mixer channel. Set on the main thread before the
+   channel starts; cleared by the mixer thread when the channel finishes. */
+static OneShotSound *volatile g_channel_sound[AM_CHANNELS];
+static Uint32 g_channel_started[AM_CHANNELS];
+
+static void channel_finished_callback(int channel);
+
 /* ───────────────── HELPER: one-time SDL_mixer init ─────────────── */
 static int mixer_init_once(void) {
     static int initialised = 0;
@@ -16,7 +38,8 @@ static int mixer_init_once(void) {
             LOG_ERROR("Mix_OpenAudio: %s\n", Mix_GetError());
             return -1;
         }
-        Mix_AllocateChannels(32); /* enough for normal SFX use-cases */
+        Mix_AllocateChannels(AM_CHANNELS); /* enough for normal SFX use-cases */
+        Mix_ChannelFinished(channel_finished_callback);
         initialised = 1;
     }
     return 0;
@@ -62,6 +85,7 @@ AudioManager *am_create(int max_count) {
     AudioManager *m = calloc(1, sizeof *m);
     m->audios = calloc(max_count, sizeof(Audio *));
     m->max_count = max_count;
+    m->oneshots = hashmap_create(AM_ONESHOT_MAP_CAPACITY);
     return m;
 }
 
@@ -71,6 +95,22 @@ void am_destroy(AudioManager *m) {
     for (int i = 0; i < m->count; ++i)
         audio_destroy(m->audios[i]);
     free(m->audios);
+
+    /* stop one-shots before their chunks and voice counters go away */
+    for (int ch = 0; ch < AM_CHANNELS; ++ch)
+        if (g_channel_sound[ch])
+            Mix_HaltChannel(ch);
+    HashMap *map = m->oneshots;
+    for (int i = 0; i < map->capacity; ++i) {
+        for (HashMapEntry *e = &map->entries[i]; e && e->key; e = e->next) {
+            OneShotSound *s = e->value;
+            if (s->own_chunk)
+                Mix_FreeChunk(s->own_chunk);
+            free(s->path);
+            free(s);
+        }
+    }
+    hashmap_destroy(map);
     free(m);
 
     /* If this was the last manager you could Mix_CloseAudio() here.
@@ -85,6 +125,15 @@ int am_register(AudioManager *m, Audio *audio) {
 }
 
 /* ───────────────── raw play/stop ───────────────── */
+/* One-shots set a volume on their channel and it outlives the sound; put
+   idle channels back to full before Mix_PlayChannel(-1) picks one. Not done
+   in channel_finished_callback: SDL_mixer must not be called from there. */
+static void reset_idle_channel_volumes(void) {
+    for (int ch = 0; ch < AM_CHANNELS; ++ch)
+        if (!g_channel_sound[ch] && !Mix_Playing(ch) && Mix_Volume(ch, -1) != MIX_MAX_VOLUME)
+            Mix_Volume(ch, MIX_MAX_VOLUME);
+}
+
 void play_audio_raw(Audio *a) {
     if (!a || a->is_playing)
         return;
@@ -116,6 +165,7 @@ void play_audio_raw(Audio *a) {
             }
         }
         Mix_VolumeChunk(a->handle.chunk, a->volume);
+        reset_idle_channel_volumes();
         a->channel = Mix_PlayChannel(-1, a->handle.chunk, a->loop ? -1 : 0);
         if (a->channel == -1) {
             LOG_ERROR("Mix_PlayChannel: %s\n", Mix_GetError());
@@ -166,12 +216,72 @@ void am_stop(AudioManager *m, Audio *a) {
         m->current_music = NULL;
 }
 
-// Callback for when a channel finishes playing
+void am_set_resource_manager(AudioManager *m, struct ResourceManager *rm) {
+    if (m)
+        m->resources = rm;
+}
+
+// Runs on the mixer thread: release the voice, the chunk stays cached
 static void channel_finished_callback(int channel) {
-    Mix_Chunk* chunk = Mix_GetChunk(channel);
-    if (chunk) {
-        Mix_FreeChunk(chunk);
+    if (channel < 0 || channel >= AM_CHANNELS)
+        return;
+    OneShotSound *s = g_channel_sound[channel];
+    if (s) {
+        g_channel_sound[channel] = NULL;
+        SDL_AtomicAdd(&s->voices, -1);
+    }
+}
+
+static OneShotSound *oneshot_get(AudioManager *m, const char *path) {
+    OneShotSound *s = hashmap_get(m->oneshots, path);
+    if (!s) {
+        s = calloc(1, sizeof *s);
+        s->path = strdup(path);
+        s->max_voices = AM_ONESHOT_DEFAULT_VOICES;
+        hashmap_put(m->oneshots, path, s);
+    }
+    return s;
+}
+
+static Mix_Chunk *oneshot_chunk(AudioManager *m, OneShotSound *s) {
+    if (s->retry_ms && (Sint32)(SDL_GetTicks() - s->retry_at) < 0)
+        return NULL;
+    /* ask the cache every time: a released group may have freed the chunk */
+    Mix_Chunk *chunk = m->resources ? load_chunk_file(m->resources, s->path)
+                                    : s->own_chunk;
+    if (!chunk && !m->resources) {
+        chunk = s->own_chunk = Mix_LoadWAV(s->path);
     }
+    if (!chunk) {
+        /* the file may be fixed or dropped in later: back off, don't give up */
+        s->retry_ms = s->retry_ms ? SDL_min(s->retry_ms * 2, AM_RETRY_MAX_MS)
+                                  : AM_RETRY_FIRST_MS;
+        s->retry_at = SDL_GetTicks() + s->retry_ms;
+        LOG_ERROR("One-shot sound unavailable: %s (%s), retrying in %u ms\n", s->path,
+                  Mix_GetError(), s->retry_ms);
+    } else {
+        s->retry_ms = 0;
+    }
+    return chunk;
+}
+
+/* A free channel, or the oldest voice of |s| once it hits its limit */
+static int oneshot_channel(OneShotSound *s) {
+    if (SDL_AtomicGet(&s->voices) >= s->max_voices) {
+        int oldest = -1;
+        for (int ch = 0; ch < AM_CHANNELS; ++ch)
+            if (g_channel_sound[ch] == s &&
+                (oldest < 0 || g_channel_started[ch] < g_channel_started[oldest]))
+                oldest = ch;
+        if (oldest >= 0) {
+            Mix_HaltChannel(oldest);   /* fires channel_finished_callback */
+            return oldest;
+        }
+    }
+    for (int ch = 0; ch < AM_CHANNELS; ++ch)
+        if (!g_channel_sound[ch] && !Mix_Playing(ch))
+            return ch;
+    return -1;
 }
 
 // Play a one-shot sound effect without requiring caller to manage the Audio object
@@ -180,38 +290,36 @@ int am_play_oneshot(AudioManager *mgr, const char *path, int volume) {
         LOG_ERROR("Invalid arguments to am_play_oneshot\n");
         return 0;
     }
-    
-    LOG_INFO("Loading one-shot sound from: %s\n", path);
-    
-    // First check if the file exists
-    SDL_RWops* file = SDL_RWFromFile(path, "rb");
-    if (!file) {
-        LOG_ERROR("Sound file does not exist at path: %s (SDL Error: %s)\n", 
-                 path, SDL_GetError());
+
+    OneShotSound *s = oneshot_get(mgr, path);
+    Mix_Chunk *chunk = oneshot_chunk(mgr, s);
+    if (!chunk)
         return 0;
-    }
-    SDL_RWclose(file);
-    
-    // Load the sound effect directly
-    Mix_Chunk* chunk = Mix_LoadWAV(path);
-    if (!chunk) {
-        LOG_ERROR("Mix_LoadWAV(%s): %s\n", path, Mix_GetError());
+
+    int channel = oneshot_channel(s);
+    if (channel < 0) {
+        LOG_WARN("No free mixer channel for one-shot %s\n", path);
         return 0;
     }
-    
-    // Set volume and play
-    Mix_VolumeChunk(chunk, volume);
-    
-    // Set up a channel finished callback to free the chunk when done playing
-    Mix_ChannelFinished(channel_finished_callback);
-    
-    int channel = Mix_PlayChannel(-1, chunk, 0);
-    if (channel == -1) {
+
+    /* claim the channel before it can finish and call back */
+    g_channel_sound[channel] = s;
+    g_channel_started[channel] = SDL_GetTicks();
+    SDL_AtomicAdd(&s->voices, 1);
+
+    /* the chunk is shared, so volume is per channel */
+    Mix_Volume(channel, volume);
+    if (Mix_PlayChannel(channel, chunk, 0) == -1) {
         LOG_ERROR("Mix_PlayChannel: %s\n", Mix_GetError());
-        Mix_FreeChunk(chunk);
+        g_channel_sound[channel] = NULL;
+        SDL_AtomicAdd(&s->voices, -1);
         return 0;
     }
-    
-    LOG_INFO("Successfully started playing one-shot sound\n");
     return 1;
 }
+
+void am_set_oneshot_limit(AudioManager *mgr, const char *path, int max_voices) {
+    if (!mgr || !path || max_voices < 1)
+        return;
+    oneshot_get(mgr, path)->max_voices = max_voices;
+}
@@ -2,6 +2,12 @@
 #pragma once
 #include <SDL2/SDL_mixer.h>
 
+#define AM_CHANNELS 32               /* mixer channels allocated at init     */
+#define AM_ONESHOT_DEFAULT_VOICES 4  /* simultaneous plays per one-shot sound */
+
+struct ResourceManager;
+struct HashMap;
+
 typedef enum { MUSIC, SFX, VOICE, AMBIENT } AudioType;
 
 typedef struct Audio {
@@ -29,6 +35,8 @@ typedef struct AudioManager {
     int             count;
     int             max_count;
     Audio          *current_music;
+    struct ResourceManager *resources; // shared chunk cache for one-shots
+    struct HashMap *oneshots;          // path → OneShotSound (voice counts)
 } AudioManager;
 
 // create/destroy
@@ -43,6 +51,13 @@ int            am_register(AudioManager *mgr, Audio *audio);
 void           am_play   (AudioManager *mgr, Audio *audio);
 void           am_stop   (AudioManager *mgr, Audio *audio);
 
-// Play a one-shot sound effect (creates, plays and manages cleanup internally)
+// Decode one-shots once through this manager's cache instead of per play
+void           am_set_resource_manager(AudioManager *mgr, struct ResourceManager *rm);
+
+// Play a one-shot sound effect. The decoded chunk is shared between plays;
+// when the sound's voice limit is reached its oldest voice is cut off.
 // Returns 1 on success, 0 on failure
 int            am_play_oneshot(AudioManager *mgr, const char *path, int volume);
+
+// Override how many copies of |path| may play at once (default 4)
+void           am_set_oneshot_limit(AudioManager *mgr, const char *path, int max_voices);
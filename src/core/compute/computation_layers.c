@@ -5,6 +5,9 @@
 #include "../state/state_manager.h"
 #include "../clock/clock_service.h"
 #include "../render/render_service.h"
+#include "../resources/hot_reload.h"
+#include "../resources/resource_groups.h"
+#include "../../game/entities/scheduler.h"
 #include <SDL2/SDL.h>
 
 void layer_state_input(GameHandle *gh) {
@@ -24,6 +27,13 @@ void layer_clock_update(GameHandle *gh) {
     clock_service_update(clock);
 }
 
+void layer_simulation(GameHandle *gh)
+{
+    EcsScheduler *sched = svc_get(gh->services, SIMULATION_SERVICE);
+    ClockService *clock = svc_get(gh->services, CLOCK_SERVICE);
+    if (sched) ecs_scheduler_run(sched, clock ? clock->delta_time : 0.0f);
+}
+
 void layer_state_render(GameHandle *gh)
 {
     /* begin the frame before individual render layers draw */
@@ -31,11 +41,29 @@ void layer_state_render(GameHandle *gh)
     if (R) renderer_begin_frame(R);
 }
 
+void layer_preload(GameHandle *gh)
+{
+    ResourceManager *rm = svc_get(gh->services, RESOURCE_MANAGER_SERVICE);
+    RenderService *R = svc_get(gh->services, RENDER_SERVICE);
+    if (rm && R) resource_preload_pump(rm, R->renderer);
+}
+
+void layer_hot_reload(GameHandle *gh)
+{
+    HotReload *hr = svc_get(gh->services, HOT_RELOAD_SERVICE);
+    RenderService *R = svc_get(gh->services, RENDER_SERVICE);
+    if (hr && R) hot_reload_poll(hr, R->renderer);
+}
+
 void register_standard_layers(GameHandle *gh)
 {
     /* highest priority first */
     push_layer(gh, "clock",   layer_clock_update,  LAYER_PRIORITY_CLOCK);
     push_layer(gh, "input",   layer_state_input,   LAYER_PRIORITY_INPUT);
+    push_layer(gh, "preload", layer_preload,       LAYER_PRIORITY_PRELOAD);
+    if (svc_get(gh->services, HOT_RELOAD_SERVICE))
+        push_layer(gh, "hot_reload", layer_hot_reload, LAYER_PRIORITY_HOT_RELOAD);
+    push_layer(gh, "simulation", layer_simulation, LAYER_PRIORITY_SIMULATION);
     push_layer(gh, "render",  layer_state_render,  LAYER_PRIORITY_RENDER);
     push_layer(gh, "present", layer_present,       LAYER_PRIORITY_PRESENT);
 }
\ No newline at end of file
@@ -7,15 +7,27 @@
 #define LAYER_PRIORITY_PRESENT 0      /* Present frame and update input */
 #define LAYER_PRIORITY_CLOCK 0        /* Update game clock */
 #define LAYER_PRIORITY_RENDER 100     /* Render game state */
+#define LAYER_PRIORITY_SIMULATION 150 /* Run the ECS systems */
+#define LAYER_PRIORITY_HOT_RELOAD 200 /* Swap in assets changed on disk */
+#define LAYER_PRIORITY_PRELOAD 250    /* Finish background asset loads */
 #define LAYER_PRIORITY_INPUT 300      /* Handle input processing */
 
 
 /* Layer for handling input in the state manager */
 void layer_state_input(GameHandle *gh);
 
+/* Layer for running the ECS systems through the scheduler */
+void layer_simulation(GameHandle *gh);
+
 /* Layer for rendering the state manager */
 void layer_state_render(GameHandle *gh);
 
+/* Layer for finishing preloaded asset groups on the main thread */
+void layer_preload(GameHandle *gh);
+
+/* Layer for applying hot-reloaded assets (dev mode only) */
+void layer_hot_reload(GameHandle *gh);
+
 /* Layer for presenting the rendered frame */
 void layer_present(GameHandle *gh);
 
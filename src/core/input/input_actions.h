@@ -16,6 +16,9 @@ typedef enum {
     ACTION_CANCEL,      // “B”, “Esc”, right-click
     ACTION_QUIT,        // Alt-F4, window close, etc.
 
+    /* developer */
+    ACTION_TOGGLE_INSPECTOR,    // F3: ECS inspector overlay
+
     ACTION_COUNT        // keep last
 } InputAction;
 
@@ -29,6 +29,8 @@ static InputAction key_to_action(SDL_Scancode sc) {
         return ACTION_CONFIRM;
     case SDL_SCANCODE_ESCAPE:
         return ACTION_CANCEL;
+    case SDL_SCANCODE_F3:
+        return ACTION_TOGGLE_INSPECTOR;
     default:
         return ACTION_NONE;
     }
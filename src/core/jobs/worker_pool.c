@@ -0,0 +1,186 @@
+#include "worker_pool.h"
+#include "../../utils/log.h"
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define WORKER_POOL_MAX_THREADS 32
+#define WORKER_POOL_SLAB_JOBS   256   /* job nodes allocated at a time */
+
+typedef struct Job {
+    JobFn        fn;
+    void        *userdata;
+    WorkerBatch *batch;
+    struct Job  *next;
+} Job;
+
+/* Job nodes come from slabs and go back on a free list once run, so a
+   steady frame of submits allocates nothing */
+typedef struct JobSlab {
+    struct JobSlab *next;
+    Job             jobs[WORKER_POOL_SLAB_JOBS];
+} JobSlab;
+
+struct WorkerPool {
+    SDL_Thread *threads[WORKER_POOL_MAX_THREADS];
+    int         thread_count;
+    SDL_mutex  *lock;
+    SDL_cond   *has_work;      /* signalled when a job is queued      */
+    SDL_cond   *idle;          /* signalled when the pool drains      */
+    SDL_cond   *batch_done;    /* signalled when a batch empties      */
+    Job        *head, *tail;
+    Job        *free_jobs;     /* finished nodes, reused by submits   */
+    JobSlab    *slabs;         /* every node allocated, freed on exit */
+    int         active;        /* jobs currently executing            */
+    int         quit;
+};
+
+/* Put another slab's nodes on the free list; under the pool lock */
+static bool slab_add(WorkerPool *pool) {
+    JobSlab *slab = malloc(sizeof *slab);
+    if (!slab) return false;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    for (int i = WORKER_POOL_SLAB_JOBS - 1; i >= 0; i--) {
+        slab->jobs[i].next = pool->free_jobs;
+        pool->free_jobs = &slab->jobs[i];
+    }
+    return true;
+}
+
+/* Under the pool lock. NULL when out of memory */
+static Job *job_alloc(WorkerPool *pool) {
+    if (!pool->free_jobs && !slab_add(pool)) return NULL;
+    Job *job = pool->free_jobs;
+    pool->free_jobs = job->next;
+    return job;
+}
+
+static int worker_main(void *userdata) {
+    WorkerPool *pool = userdata;
+    SDL_LockMutex(pool->lock);
+    for (;;) {
+        while (!pool->head && !pool->quit)
+            SDL_CondWait(pool->has_work, pool->lock);
+        if (!pool->head && pool->quit)
+            break;
+
+        Job *job = pool->head;
+        pool->head = job->next;
+        if (!pool->head) pool->tail = NULL;
+        pool->active++;
+        SDL_UnlockMutex(pool->lock);
+
+        WorkerBatch *batch = job->batch;
+        job->fn(job->userdata);
+
+        SDL_LockMutex(pool->lock);
+        job->next = pool->free_jobs;
+        pool->free_jobs = job;
+        if (batch && --batch->pending == 0)
+            SDL_CondBroadcast(pool->batch_done);
+        pool->active--;
+        if (!pool->head && pool->active == 0)
+            SDL_CondBroadcast(pool->idle);
+    }
+    SDL_UnlockMutex(pool->lock);
+    return 0;
+}
+
+WorkerPool *worker_pool_create(int threads) {
+    if (threads <= 0) threads = SDL_GetCPUCount() - 1;
+    if (threads < 1) threads = 1;
+    if (threads > WORKER_POOL_MAX_THREADS) threads = WORKER_POOL_MAX_THREADS;
+
+    WorkerPool *pool = calloc(1, sizeof *pool);
+    if (!pool) return NULL;
+    pool->lock = SDL_CreateMutex();
+    pool->has_work = SDL_CreateCond();
+    pool->idle = SDL_CreateCond();
+    pool->batch_done = SDL_CreateCond();
+    slab_add(pool);                        /* no thread runs yet */
+
+    for (int i = 0; i < threads; i++) {
+        pool->threads[i] = SDL_CreateThread(worker_main, "worker", pool);
+        if (!pool->threads[i]) {
+            LOG_WARN("WorkerPool: only %d of %d threads started: %s",
+                     i, threads, SDL_GetError());
+            break;
+        }
+        pool->thread_count++;
+    }
+    if (pool->thread_count == 0) {
+        worker_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void worker_pool_destroy(WorkerPool *pool) {
+    if (!pool) return;
+    SDL_LockMutex(pool->lock);
+    pool->quit = 1;
+    SDL_CondBroadcast(pool->has_work);
+    SDL_UnlockMutex(pool->lock);
+
+    for (int i = 0; i < pool->thread_count; i++)
+        SDL_WaitThread(pool->threads[i], NULL);
+
+    SDL_DestroyCond(pool->batch_done);
+    SDL_DestroyCond(pool->idle);
+    SDL_DestroyCond(pool->has_work);
+    SDL_DestroyMutex(pool->lock);
+    while (pool->slabs) {
+        JobSlab *next = pool->slabs->next;
+        free(pool->slabs);
+        pool->slabs = next;
+    }
+    free(pool);
+}
+
+int worker_pool_submit(WorkerPool *pool, JobFn fn, void *userdata) {
+    return worker_pool_submit_batch(pool, NULL, fn, userdata);
+}
+
+int worker_pool_submit_batch(WorkerPool *pool, WorkerBatch *batch,
+                             JobFn fn, void *userdata) {
+    if (!pool || !fn) return -1;
+    SDL_LockMutex(pool->lock);
+    Job *job = job_alloc(pool);
+    if (!job) {
+        SDL_UnlockMutex(pool->lock);
+        return -1;
+    }
+    job->fn = fn;
+    job->userdata = userdata;
+    job->batch = batch;
+    job->next = NULL;
+
+    if (batch) batch->pending++;
+    if (pool->tail) pool->tail->next = job;
+    else pool->head = job;
+    pool->tail = job;
+    SDL_CondSignal(pool->has_work);
+    SDL_UnlockMutex(pool->lock);
+    return 0;
+}
+
+void worker_pool_wait(WorkerPool *pool) {
+    if (!pool) return;
+    SDL_LockMutex(pool->lock);
+    while (pool->head || pool->active > 0)
+        SDL_CondWait(pool->idle, pool->lock);
+    SDL_UnlockMutex(pool->lock);
+}
+
+void worker_pool_wait_batch(WorkerPool *pool, WorkerBatch *batch) {
+    if (!pool || !batch) return;
+    SDL_LockMutex(pool->lock);
+    while (batch->pending > 0)
+        SDL_CondWait(pool->batch_done, pool->lock);
+    SDL_UnlockMutex(pool->lock);
+}
+
+int worker_pool_thread_count(const WorkerPool *pool) {
+    return pool ? pool->thread_count : 0;
+}
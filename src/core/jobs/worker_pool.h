@@ -0,0 +1,43 @@
+#ifndef CONQUEST_WORKER_POOL_H
+#define CONQUEST_WORKER_POOL_H
+
+/*
+ * Fixed-size pool of SDL worker threads pulling from one FIFO job queue.
+ * Jobs must not touch the SDL renderer – that stays on the main thread.
+ *
+ * One pool is shared by every subsystem (see RenderService), so callers
+ * that wait for their own jobs submit them under a WorkerBatch and wait on
+ * that: worker_pool_wait would also wait for unrelated work such as
+ * background asset decodes.
+ */
+typedef void (*JobFn)(void *userdata);
+
+typedef struct WorkerPool WorkerPool;
+
+/* Jobs of one caller still queued or running; guarded by the pool lock */
+typedef struct WorkerBatch {
+    int pending;
+} WorkerBatch;
+
+/* |threads| <= 0 picks one per CPU core minus the main thread */
+WorkerPool *worker_pool_create(int threads);
+
+/* Finishes every queued job, then joins the threads */
+void        worker_pool_destroy(WorkerPool *pool);
+
+/* Queue a job. Returns 0 on success, -1 if it could not be queued */
+int         worker_pool_submit(WorkerPool *pool, JobFn fn, void *userdata);
+
+/* Queue a job counted in |batch| (zero-initialised before first use) */
+int         worker_pool_submit_batch(WorkerPool *pool, WorkerBatch *batch,
+                                     JobFn fn, void *userdata);
+
+/* Block until the queue is empty and no job is running */
+void        worker_pool_wait(WorkerPool *pool);
+
+/* Block until every job of |batch| has finished; other jobs may still run */
+void        worker_pool_wait_batch(WorkerPool *pool, WorkerBatch *batch);
+
+int         worker_pool_thread_count(const WorkerPool *pool);
+
+#endif // CONQUEST_WORKER_POOL_H
@@ -0,0 +1,37 @@
+#include "camera.h"
+
+void camera_init(Camera *cam, int screen_w, int screen_h) {
+    if (!cam) return;
+    cam->zoom = 1.f;
+    cam->viewport = (SDL_Rect){0, 0, screen_w, screen_h};
+    cam->x = screen_w * 0.5f;
+    cam->y = screen_h * 0.5f;
+}
+
+SDL_FRect camera_view(const Camera *cam) {
+    float w = cam->viewport.w / cam->zoom;
+    float h = cam->viewport.h / cam->zoom;
+    return (SDL_FRect){cam->x - w * 0.5f, cam->y - h * 0.5f, w, h};
+}
+
+bool camera_visible(const Camera *cam, const SDL_FRect *b) {
+    SDL_FRect v = camera_view(cam);
+    return b->x < v.x + v.w && v.x < b->x + b->w &&
+           b->y < v.y + v.h && v.y < b->y + b->h;
+}
+
+SDL_FRect camera_to_screen(const Camera *cam, const SDL_FRect *world) {
+    SDL_FRect v = camera_view(cam);
+    return (SDL_FRect){
+        cam->viewport.x + (world->x - v.x) * cam->zoom,
+        cam->viewport.y + (world->y - v.y) * cam->zoom,
+        world->w * cam->zoom,
+        world->h * cam->zoom
+    };
+}
+
+void camera_to_world(const Camera *cam, float sx, float sy, float *wx, float *wy) {
+    SDL_FRect v = camera_view(cam);
+    if (wx) *wx = v.x + (sx - cam->viewport.x) / cam->zoom;
+    if (wy) *wy = v.y + (sy - cam->viewport.y) / cam->zoom;
+}
@@ -0,0 +1,28 @@
+#ifndef CONQUEST_CAMERA_H
+#define CONQUEST_CAMERA_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/*
+ * 2D camera: the world point (x, y) is shown at the centre of |viewport|,
+ * scaled by |zoom| (2 = everything twice as large).
+ */
+typedef struct Camera {
+    float    x, y;
+    float    zoom;
+    SDL_Rect viewport;   /* screen pixels */
+} Camera;
+
+void      camera_init(Camera *cam, int screen_w, int screen_h);
+
+/* World-space rectangle currently in view */
+SDL_FRect camera_view(const Camera *cam);
+
+/* Does |bounds| (world space) intersect the view? */
+bool      camera_visible(const Camera *cam, const SDL_FRect *bounds);
+
+SDL_FRect camera_to_screen(const Camera *cam, const SDL_FRect *world);
+void      camera_to_world(const Camera *cam, float sx, float sy, float *wx, float *wy);
+
+#endif // CONQUEST_CAMERA_H
@@ -0,0 +1,261 @@
+#include "console.h"
+#include "glyph_cache.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ─── CP437 ─── */
+
+/* Unicode of the sheet glyphs that are not plain ASCII (0x01–0x1F, 0x7F–0xFF) */
+static const Uint16 cp437_low[32] = {
+    0x0000, 0x263A, 0x263B, 0x2665, 0x2666, 0x2663, 0x2660, 0x2022,
+    0x25D8, 0x25CB, 0x25D9, 0x2642, 0x2640, 0x266A, 0x266B, 0x263C,
+    0x25BA, 0x25C4, 0x2195, 0x203C, 0x00B6, 0x00A7, 0x25AC, 0x21A8,
+    0x2191, 0x2193, 0x2192, 0x2190, 0x221F, 0x2194, 0x25B2, 0x25BC,
+};
+
+static const Uint16 cp437_high[129] = {
+    0x2302,
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0,
+};
+
+/* (unicode << 8 | sheet index), sorted, for the glyphs above */
+static Uint32 g_cp437_map[32 + 129];
+static int    g_cp437_count;
+
+static int map_compare(const void *a, const void *b) {
+    Uint32 x = *(const Uint32 *)a, y = *(const Uint32 *)b;
+    return (x > y) - (x < y);
+}
+
+static void cp437_build(void) {
+    if (g_cp437_count) return;
+    int n = 0;
+    for (int i = 1; i < 32; i++)
+        g_cp437_map[n++] = (Uint32)cp437_low[i] << 8 | i;
+    for (int i = 0; i < 129; i++)
+        g_cp437_map[n++] = (Uint32)cp437_high[i] << 8 | (0x7F + i);
+    qsort(g_cp437_map, n, sizeof *g_cp437_map, map_compare);
+    g_cp437_count = n;
+}
+
+static int cp437_index(Uint32 cp) {
+    if (cp < 0x7F) return (int)cp;          /* ASCII, and raw sheet 0x01–0x1F */
+    int lo = 0, hi = g_cp437_count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        Uint32 u = g_cp437_map[mid] >> 8;
+        if (u == cp) return (int)(g_cp437_map[mid] & 0xFF);
+        if (u < cp) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return '?';
+}
+
+/* ─── cells ─── */
+
+Console *console_create(int cols, int rows, AtlasRegion font, int cell_w, int cell_h) {
+    if (cols <= 0 || rows <= 0 || cell_w <= 0 || cell_h <= 0 || !font.texture ||
+        font.rect.w < CONSOLE_FONT_COLUMNS * cell_w ||
+        font.rect.h < 16 * cell_h) {
+        LOG_ERROR("Console: invalid %dx%d grid (cell %dx%d)", cols, rows, cell_w, cell_h);
+        return NULL;
+    }
+
+    cp437_build();
+    Console *con = calloc(1, sizeof *con);
+    if (!con) return NULL;
+    con->cols = cols;
+    con->rows = rows;
+    con->cell_w = cell_w;
+    con->cell_h = cell_h;
+    con->font = font;
+    con->back = calloc((size_t)cols * rows, sizeof *con->back);
+    con->front = calloc((size_t)cols * rows, sizeof *con->front);
+    /* a full redraw is two quads per cell */
+    con->batch = sprite_batch_create(2 * cols * rows);
+    if (!con->back || !con->front || !con->batch) {
+        LOG_ERROR("Console: could not create %dx%d grid", cols, rows);
+        console_destroy(con);
+        return NULL;
+    }
+    con->stale = true;
+    console_clear(con, (SDL_Color){0, 0, 0, 255});
+    return con;
+}
+
+void console_destroy(Console *con) {
+    if (!con) return;
+    if (con->cache) SDL_DestroyTexture(con->cache);
+    sprite_batch_destroy(con->batch);
+    free(con->back);
+    free(con->front);
+    free(con);
+}
+
+void console_clear(Console *con, SDL_Color bg) {
+    if (!con) return;
+    ConsoleCell blank = {' ', {255, 255, 255, 255}, bg};
+    size_t n = (size_t)con->cols * con->rows;
+    for (size_t i = 0; i < n; i++)
+        con->back[i] = blank;
+}
+
+ConsoleCell *console_cell(Console *con, int x, int y) {
+    if (!con || x < 0 || y < 0 || x >= con->cols || y >= con->rows)
+        return NULL;
+    return &con->back[(size_t)y * con->cols + x];
+}
+
+void console_put(Console *con, int x, int y, Uint32 codepoint,
+                 SDL_Color fg, SDL_Color bg) {
+    ConsoleCell *c = console_cell(con, x, y);
+    if (!c) return;
+    c->codepoint = codepoint;
+    c->fg = fg;
+    c->bg = bg;
+}
+
+int console_print(Console *con, int x, int y, const char *utf8,
+                  SDL_Color fg, SDL_Color bg) {
+    if (!con || !utf8 || y < 0 || y >= con->rows) return 0;
+    const unsigned char *p = (const unsigned char *)utf8;
+    int written = 0;
+    Uint32 cp;
+    while (x < con->cols && (cp = glyph_utf8_next(&p)) != 0) {
+        if (x >= 0) {
+            console_put(con, x, y, cp, fg, bg);
+            written++;
+        }
+        x++;
+    }
+    return written;
+}
+
+void console_invalidate(Console *con) {
+    if (con) con->stale = true;
+}
+
+/* ─── drawing ─── */
+
+static SDL_Rect glyph_src(const Console *con, int index) {
+    return (SDL_Rect){
+        con->font.rect.x + (index % CONSOLE_FONT_COLUMNS) * con->cell_w,
+        con->font.rect.y + (index / CONSOLE_FONT_COLUMNS) * con->cell_h,
+        con->cell_w, con->cell_h,
+    };
+}
+
+/* Background and glyph quads of one cell; all share the font texture and
+   one layer, so the batch keeps them in order within a single call */
+static void cell_queue(Console *con, const ConsoleCell *c, const SDL_Rect *solid,
+                       float x, float y, float w, float h) {
+    SDL_FRect dst = {x, y, w, h};
+    SDL_Color bg = c->bg;
+    bg.a = 255;
+    sprite_batch_draw(con->batch, con->font.texture, solid, &dst, bg, 0);
+    if (c->codepoint && c->codepoint != ' ') {
+        SDL_Rect src = glyph_src(con, cp437_index(c->codepoint));
+        sprite_batch_draw(con->batch, con->font.texture, &src, &dst, c->fg, 0);
+    }
+}
+
+/* Queue the cells that differ from the front buffer and adopt them */
+static int queue_changes(Console *con, bool all, const SDL_Rect *solid) {
+    int drawn = 0;
+    size_t row_bytes = sizeof(ConsoleCell) * con->cols;
+    for (int y = 0; y < con->rows; y++) {
+        ConsoleCell *back = &con->back[(size_t)y * con->cols];
+        ConsoleCell *front = &con->front[(size_t)y * con->cols];
+        if (!all && memcmp(back, front, row_bytes) == 0)
+            continue;
+        for (int x = 0; x < con->cols; x++) {
+            if (!all && memcmp(&back[x], &front[x], sizeof *back) == 0)
+                continue;
+            cell_queue(con, &back[x], solid, (float)(x * con->cell_w),
+                       (float)(y * con->cell_h), (float)con->cell_w, (float)con->cell_h);
+            front[x] = back[x];
+            drawn++;
+        }
+    }
+    return drawn;
+}
+
+static bool cache_ready(Console *con, SDL_Renderer *ren) {
+    if (con->cache) return true;
+    if (con->direct) return false;
+    if (!SDL_RenderTargetSupported(ren)) {
+        con->direct = true;
+        return false;
+    }
+    con->cache = SDL_CreateTexture(ren, SDL_PIXELFORMAT_RGBA8888,
+                                   SDL_TEXTUREACCESS_TARGET,
+                                   con->cols * con->cell_w, con->rows * con->cell_h);
+    if (!con->cache) {
+        LOG_WARN("Console: cache texture failed, drawing every cell: %s",
+                 SDL_GetError());
+        con->direct = true;
+        return false;
+    }
+    /* every cell is opaque, so the copy out needs no blending */
+    SDL_SetTextureBlendMode(con->cache, SDL_BLENDMODE_NONE);
+    con->stale = true;
+    return true;
+}
+
+void console_render(Console *con, SDL_Renderer *ren, const SDL_FRect *dst) {
+    if (!con || !ren) return;
+    SDL_FRect out = dst ? *dst
+                        : (SDL_FRect){0.f, 0.f, (float)(con->cols * con->cell_w),
+                                      (float)(con->rows * con->cell_h)};
+    SDL_Rect solid = glyph_src(con, CONSOLE_SOLID_GLYPH);
+    /* one texel from the middle of the block, so edges never bleed in */
+    solid.x += solid.w / 2;
+    solid.y += solid.h / 2;
+    solid.w = solid.h = 1;
+
+    con->stats = (ConsoleStats){0};
+
+    if (!cache_ready(con, ren)) {
+        float sx = out.w / (con->cols * con->cell_w);
+        float sy = out.h / (con->rows * con->cell_h);
+        for (int y = 0; y < con->rows; y++)
+            for (int x = 0; x < con->cols; x++)
+                cell_queue(con, &con->back[(size_t)y * con->cols + x], &solid,
+                           out.x + x * con->cell_w * sx, out.y + y * con->cell_h * sy,
+                           con->cell_w * sx, con->cell_h * sy);
+        con->stats.cells_drawn = con->cols * con->rows;
+        con->stats.draw_calls = sprite_batch_flush(con->batch, ren);
+        return;
+    }
+
+    int drawn = queue_changes(con, con->stale, &solid);
+    con->stale = false;
+    if (drawn) {
+        SDL_Texture *prev = SDL_GetRenderTarget(ren);
+        SDL_SetRenderTarget(ren, con->cache);
+        con->stats.draw_calls = sprite_batch_flush(con->batch, ren);
+        SDL_SetRenderTarget(ren, prev);
+    }
+    con->stats.cells_drawn = drawn;
+    SDL_RenderCopyF(ren, con->cache, NULL, &out);
+}
+
+ConsoleStats console_stats(const Console *con) {
+    return con ? con->stats : (ConsoleStats){0};
+}
@@ -0,0 +1,78 @@
+#ifndef CONQUEST_CONSOLE_H
+#define CONQUEST_CONSOLE_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "sprite_batch.h"
+#include "../resources/texture_atlas.h"
+
+/*
+ * Glyph-grid console on a bitmap font.
+ *
+ * The game writes cells (codepoint, foreground, background) into the back
+ * buffer; console_render() diffs it against the front buffer – what the
+ * cached render target already shows – and redraws only the cells that
+ * changed, backgrounds and glyphs together in one batched geometry call,
+ * before the cache is copied out. Unchanged frames cost a diff and a copy.
+ *
+ * The font is a CP437 sheet of 16 glyphs per row, white on transparent so
+ * the colours tint it. Codepoints are Unicode and are mapped to the sheet
+ * (box drawing, shades, ☺ …); anything without a CP437 glyph draws as '?'.
+ * Backgrounds are stretched from the full block (0xDB), which therefore
+ * has to be solid.
+ */
+#define CONSOLE_FONT_COLUMNS 16
+#define CONSOLE_SOLID_GLYPH  0xDB
+
+typedef struct ConsoleCell {
+    Uint32    codepoint;     /* 0 or ' ': background only */
+    SDL_Color fg, bg;
+} ConsoleCell;
+
+typedef struct ConsoleStats {
+    int cells_drawn;         /* cells redrawn by the last render  */
+    int draw_calls;          /* geometry calls by the last render */
+} ConsoleStats;
+
+typedef struct Console {
+    int          cols, rows;
+    int          cell_w, cell_h;     /* pixels */
+    AtlasRegion  font;
+
+    ConsoleCell *back;               /* written by the game          */
+    ConsoleCell *front;              /* shown by |cache|             */
+    SDL_Texture *cache;              /* cols·cell_w × rows·cell_h    */
+    bool         stale;              /* cache content is not |front| */
+    bool         direct;             /* no cache: draw every cell    */
+
+    SpriteBatch *batch;
+    ConsoleStats stats;
+} Console;
+
+/* |font| may be an atlas region; it is borrowed, not owned */
+Console *console_create(int cols, int rows, AtlasRegion font, int cell_w, int cell_h);
+void     console_destroy(Console *con);
+
+/* Fill the back buffer with blanks on |bg| */
+void     console_clear(Console *con, SDL_Color bg);
+
+void     console_put(Console *con, int x, int y, Uint32 codepoint,
+                     SDL_Color fg, SDL_Color bg);
+
+/* Back-buffer cell, NULL outside the grid */
+ConsoleCell *console_cell(Console *con, int x, int y);
+
+/* Write |utf8| from (x, y) to the end of the row. Returns cells written */
+int      console_print(Console *con, int x, int y, const char *utf8,
+                       SDL_Color fg, SDL_Color bg);
+
+/* Redraw every cell next frame, e.g. after the render targets were lost */
+void     console_invalidate(Console *con);
+
+/* Bring the cache up to date and draw it to |dst| (NULL: natural size at
+   the origin). Without render targets every cell is drawn each frame */
+void     console_render(Console *con, SDL_Renderer *ren, const SDL_FRect *dst);
+
+ConsoleStats console_stats(const Console *con);
+
+#endif // CONQUEST_CONSOLE_H
@@ -0,0 +1,68 @@
+#include "dirty_region.h"
+
+static long rect_area(const SDL_Rect *r) {
+    return (long)r->w * r->h;
+}
+
+/* overlapping or touching – merging them costs no extra pixels of note */
+static bool rects_touch(const SDL_Rect *a, const SDL_Rect *b) {
+    return a->x <= b->x + b->w && b->x <= a->x + a->w &&
+           a->y <= b->y + b->h && b->y <= a->y + a->h;
+}
+
+void dirty_region_add(DirtyRegion *d, const SDL_Rect *rect) {
+    if (!d || d->full) return;
+    if (!rect) {
+        dirty_region_invalidate(d);
+        return;
+    }
+    if (rect->w <= 0 || rect->h <= 0) return;
+
+    SDL_Rect r = *rect;
+
+    /* absorb every rectangle the new one touches; a merge can make the
+       result touch others, so rescan until nothing changes */
+    for (int i = 0; i < d->count;) {
+        if (rects_touch(&r, &d->rects[i])) {
+            SDL_UnionRect(&r, &d->rects[i], &r);
+            d->rects[i] = d->rects[--d->count];
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+
+    if (d->count < DIRTY_REGION_MAX_RECTS) {
+        d->rects[d->count++] = r;
+        return;
+    }
+
+    int best = 0;
+    long best_growth = -1;
+    for (int i = 0; i < d->count; i++) {
+        SDL_Rect u;
+        SDL_UnionRect(&r, &d->rects[i], &u);
+        long growth = rect_area(&u) - rect_area(&d->rects[i]);
+        if (best_growth < 0 || growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    SDL_UnionRect(&r, &d->rects[best], &d->rects[best]);
+}
+
+void dirty_region_invalidate(DirtyRegion *d) {
+    if (!d) return;
+    d->full = true;
+    d->count = 0;
+}
+
+void dirty_region_clear(DirtyRegion *d) {
+    if (!d) return;
+    d->full = false;
+    d->count = 0;
+}
+
+bool dirty_region_empty(const DirtyRegion *d) {
+    return !d || (!d->full && d->count == 0);
+}
@@ -0,0 +1,26 @@
+#ifndef CONQUEST_DIRTY_REGION_H
+#define CONQUEST_DIRTY_REGION_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#define DIRTY_REGION_MAX_RECTS 8
+
+/*
+ * Screen areas that changed since a retained layer was last drawn.
+ * Overlapping rectangles are merged; once the list is full a new rectangle
+ * is folded into whichever existing one grows the least.
+ */
+typedef struct DirtyRegion {
+    SDL_Rect rects[DIRTY_REGION_MAX_RECTS];
+    int      count;
+    bool     full;      /* everything must be redrawn */
+} DirtyRegion;
+
+/* |rect| NULL marks the whole target dirty */
+void dirty_region_add(DirtyRegion *d, const SDL_Rect *rect);
+void dirty_region_invalidate(DirtyRegion *d);
+void dirty_region_clear(DirtyRegion *d);
+bool dirty_region_empty(const DirtyRegion *d);
+
+#endif // CONQUEST_DIRTY_REGION_H
@@ -0,0 +1,265 @@
+#include "glyph_cache.h"
+#include "../resources/texture_atlas.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define GLYPH_PADDING     1
+#define GLYPH_MIN_SLOTS   256     /* hash capacity, power of two */
+#define GLYPH_REPLACEMENT 0xFFFD
+
+typedef struct Glyph {
+    TTF_Font *font;          /* NULL: free slot */
+    Uint32    codepoint;
+    SDL_Rect  src;           /* w == 0: nothing to draw (space, missing) */
+    Sint16    x_off;         /* surface origin relative to the pen */
+    Sint16    advance;
+    Sint8     page;
+} Glyph;
+
+struct GlyphCache {
+    SDL_Renderer  *renderer;
+    SDL_Texture   *pages[GLYPH_MAX_PAGES];
+    SkylinePacker  packers[GLYPH_MAX_PAGES];
+    int            page_count;
+    bool           pages_full;     /* logged once */
+    Glyph         *slots;
+    int            cap, count;
+    SpriteBatch   *batch;          /* for glyph_cache_draw_now */
+};
+
+/* ─── UTF-8 ─── */
+
+Uint32 glyph_utf8_next(const unsigned char **s) {
+    const unsigned char *p = *s;
+    if (!*p) return 0;
+    Uint32 cp;
+    int extra;
+    if (*p < 0x80)       { cp = *p;        extra = 0; }
+    else if (*p >= 0xF0 && *p < 0xF8) { cp = *p & 0x07; extra = 3; }
+    else if (*p >= 0xE0) { cp = *p & 0x0F; extra = 2; }
+    else if (*p >= 0xC2) { cp = *p & 0x1F; extra = 1; }
+    else { *s = p + 1; return GLYPH_REPLACEMENT; }
+
+    p++;
+    for (int i = 0; i < extra; i++, p++) {
+        if ((*p & 0xC0) != 0x80) { *s = p; return GLYPH_REPLACEMENT; }
+        cp = (cp << 6) | (*p & 0x3F);
+    }
+    *s = p;
+    if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+        return GLYPH_REPLACEMENT;
+    return cp;
+}
+
+/* ─── table ─── */
+
+static Uint32 glyph_hash(const TTF_Font *font, Uint32 cp) {
+    Uint32 h = (Uint32)((uintptr_t)font >> 4) * 2654435761u;
+    return h ^ (cp * 0x9E3779B1u);
+}
+
+static Glyph *slot_find(Glyph *slots, int cap, const TTF_Font *font, Uint32 cp) {
+    Uint32 mask = cap - 1, h = glyph_hash(font, cp) & mask;
+    while (slots[h].font && (slots[h].font != font || slots[h].codepoint != cp))
+        h = (h + 1) & mask;
+    return &slots[h];
+}
+
+static bool table_rehash(GlyphCache *c, int cap, const TTF_Font *drop) {
+    Glyph *slots = calloc(cap, sizeof *slots);
+    if (!slots) return false;
+    int count = 0;
+    for (int i = 0; i < c->cap; i++) {
+        if (!c->slots[i].font || c->slots[i].font == drop) continue;
+        *slot_find(slots, cap, c->slots[i].font, c->slots[i].codepoint) = c->slots[i];
+        count++;
+    }
+    free(c->slots);
+    c->slots = slots;
+    c->cap = cap;
+    c->count = count;
+    return true;
+}
+
+/* ─── rasterising ─── */
+
+static bool glyph_place(GlyphCache *c, SDL_Surface *s, Glyph *g) {
+    int w = s->w + GLYPH_PADDING, h = s->h + GLYPH_PADDING, x, y;
+    if (w > GLYPH_PAGE_SIZE || h > GLYPH_PAGE_SIZE) {
+        /* no page could hold it: don't open one for nothing */
+        LOG_WARN("GlyphCache: %dx%d glyph is larger than a page, dropped", s->w, s->h);
+        return false;
+    }
+    for (int p = 0; p < c->page_count; p++) {
+        if (skyline_pack(&c->packers[p], w, h, &x, &y)) {
+            g->page = (Sint8)p;
+            g->src = (SDL_Rect){x, y, s->w, s->h};
+            return true;
+        }
+    }
+    if (c->page_count == GLYPH_MAX_PAGES) {
+        if (!c->pages_full)
+            LOG_WARN("GlyphCache: all %d pages full, new glyphs are dropped",
+                     GLYPH_MAX_PAGES);
+        c->pages_full = true;
+        return false;
+    }
+
+    SDL_Texture *page = SDL_CreateTexture(c->renderer, SDL_PIXELFORMAT_ARGB8888,
+                                          SDL_TEXTUREACCESS_STATIC,
+                                          GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE);
+    if (!page) {
+        LOG_ERROR("GlyphCache: page texture failed: %s", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+    /* start transparent so filtering at glyph edges never picks up garbage */
+    void *clear = calloc(GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE * 4);
+    if (clear) {
+        SDL_UpdateTexture(page, NULL, clear, GLYPH_PAGE_SIZE * 4);
+        free(clear);
+    }
+
+    int p = c->page_count++;
+    c->pages[p] = page;
+    skyline_init(&c->packers[p], GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE);
+    if (!skyline_pack(&c->packers[p], w, h, &x, &y))
+        return false;                       /* bigger than a page */
+    g->page = (Sint8)p;
+    g->src = (SDL_Rect){x, y, s->w, s->h};
+    return true;
+}
+
+static void glyph_rasterise(GlyphCache *c, TTF_Font *font, Uint32 cp, Glyph *g) {
+    int minx, maxx, miny, maxy, advance;
+    if (TTF_GlyphMetrics32(font, cp, &minx, &maxx, &miny, &maxy, &advance) != 0)
+        return;
+    g->advance = (Sint16)advance;
+    g->x_off = (Sint16)(minx < 0 ? minx : 0);
+    if (maxx <= minx || maxy <= miny)
+        return;                             /* whitespace */
+
+    SDL_Surface *s = TTF_RenderGlyph32_Blended(font, cp, (SDL_Color){255, 255, 255, 255});
+    if (!s) return;
+    SDL_Surface *argb = s->format->format == SDL_PIXELFORMAT_ARGB8888
+                        ? s : SDL_ConvertSurfaceFormat(s, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (argb && glyph_place(c, argb, g)) {
+        if (SDL_UpdateTexture(c->pages[g->page], &g->src, argb->pixels, argb->pitch) != 0) {
+            LOG_ERROR("GlyphCache: upload failed: %s", SDL_GetError());
+            g->src.w = 0;
+        }
+    }
+    if (argb && argb != s) SDL_FreeSurface(argb);
+    SDL_FreeSurface(s);
+}
+
+static const Glyph *glyph_get(GlyphCache *c, TTF_Font *font, Uint32 cp) {
+    Glyph *g = slot_find(c->slots, c->cap, font, cp);
+    if (g->font) return g;
+
+    if (!TTF_GlyphIsProvided32(font, cp) && cp != GLYPH_REPLACEMENT && cp != '?')
+        return glyph_get(c, font, TTF_GlyphIsProvided32(font, GLYPH_REPLACEMENT)
+                                  ? GLYPH_REPLACEMENT : '?');
+
+    if ((c->count + 1) * 10 > c->cap * 7) {
+        if (!table_rehash(c, c->cap * 2, NULL)) return NULL;
+        g = slot_find(c->slots, c->cap, font, cp);
+    }
+    memset(g, 0, sizeof *g);
+    g->font = font;
+    g->codepoint = cp;
+    c->count++;
+    glyph_rasterise(c, font, cp, g);
+    return g;
+}
+
+/* ─── public ─── */
+
+GlyphCache *glyph_cache_create(SDL_Renderer *renderer) {
+    if (!renderer) return NULL;
+    GlyphCache *c = calloc(1, sizeof *c);
+    if (!c) return NULL;
+    c->renderer = renderer;
+    c->cap = GLYPH_MIN_SLOTS;
+    c->slots = calloc(c->cap, sizeof *c->slots);
+    c->batch = sprite_batch_create(0);
+    if (!c->slots || !c->batch) {
+        glyph_cache_destroy(c);
+        return NULL;
+    }
+    return c;
+}
+
+void glyph_cache_destroy(GlyphCache *c) {
+    if (!c) return;
+    for (int p = 0; p < c->page_count; p++)
+        SDL_DestroyTexture(c->pages[p]);
+    sprite_batch_destroy(c->batch);
+    free(c->slots);
+    free(c);
+}
+
+void glyph_cache_forget_font(GlyphCache *c, TTF_Font *font) {
+    /* atlas space is not reclaimed; the glyphs just stop matching */
+    if (c && font) table_rehash(c, c->cap, font);
+}
+
+/* Lay the text out from (x, y); queue quads when |batch| is set */
+static void text_layout(GlyphCache *c, SpriteBatch *batch, TTF_Font *font,
+                        const char *utf8, float x, float y, SDL_Color color,
+                        int layer, float *out_w, float *out_h) {
+    const unsigned char *p = (const unsigned char *)utf8;
+    int skip = TTF_FontLineSkip(font);
+    float pen = x, line_y = y, width = 0.f;
+    Uint32 prev = 0, cp;
+
+    while ((cp = glyph_utf8_next(&p)) != 0) {
+        if (cp == '\n') {
+            if (pen - x > width) width = pen - x;
+            pen = x;
+            line_y += skip;
+            prev = 0;
+            continue;
+        }
+        if (prev)
+            pen += TTF_GetFontKerningSizeGlyphs32(font, prev, cp);
+        const Glyph *g = glyph_get(c, font, cp);
+        if (!g) break;
+        if (batch && g->src.w) {
+            SDL_FRect dst = {pen + g->x_off, line_y, (float)g->src.w, (float)g->src.h};
+            sprite_batch_draw(batch, c->pages[g->page], &g->src, &dst, color, layer);
+        }
+        pen += g->advance;
+        prev = cp;
+    }
+    if (pen - x > width) width = pen - x;
+    if (out_w) *out_w = width;
+    if (out_h) *out_h = line_y - y + TTF_FontHeight(font);
+}
+
+float glyph_cache_draw(GlyphCache *c, SpriteBatch *batch, TTF_Font *font,
+                       const char *utf8, float x, float y, SDL_Color color,
+                       int layer) {
+    if (!c || !batch || !font || !utf8) return 0.f;
+    float w;
+    text_layout(c, batch, font, utf8, x, y, color, layer, &w, NULL);
+    return w;
+}
+
+float glyph_cache_draw_now(GlyphCache *c, TTF_Font *font, const char *utf8,
+                           float x, float y, SDL_Color color) {
+    if (!c) return 0.f;
+    float w = glyph_cache_draw(c, c->batch, font, utf8, x, y, color, 0);
+    sprite_batch_flush(c->batch, c->renderer);
+    return w;
+}
+
+void glyph_cache_measure(GlyphCache *c, TTF_Font *font, const char *utf8,
+                         int *w, int *h) {
+    float fw = 0.f, fh = 0.f;
+    if (c && font && utf8)
+        text_layout(c, NULL, font, utf8, 0.f, 0.f, (SDL_Color){0}, 0, &fw, &fh);
+    if (w) *w = (int)(fw + 0.5f);
+    if (h) *h = (int)(fh + 0.5f);
+}
@@ -0,0 +1,47 @@
+#ifndef CONQUEST_GLYPH_CACHE_H
+#define CONQUEST_GLYPH_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "sprite_batch.h"
+
+/*
+ * Text through a glyph atlas.
+ *
+ * Every (font, codepoint) pair is rasterised once – white, anti-aliased –
+ * into a shared atlas page and strings are drawn as tinted quads through a
+ * SpriteBatch, with the font's kerning applied. A font is opened per point
+ * size, so the font pointer already identifies the size. Changing text
+ * never creates textures; new codepoints only upload their own pixels.
+ *
+ * Strings are UTF-8; malformed bytes draw as U+FFFD and '\n' starts a new
+ * line at the original x.
+ */
+#define GLYPH_PAGE_SIZE 1024
+#define GLYPH_MAX_PAGES 8
+
+typedef struct GlyphCache GlyphCache;
+
+GlyphCache *glyph_cache_create(SDL_Renderer *renderer);
+void        glyph_cache_destroy(GlyphCache *cache);
+
+/* Drop every glyph of |font| (call before the font is closed) */
+void        glyph_cache_forget_font(GlyphCache *cache, TTF_Font *font);
+
+/* Queue |utf8| with its top-left at (x, y). Returns the width drawn */
+float glyph_cache_draw(GlyphCache *cache, SpriteBatch *batch, TTF_Font *font,
+                       const char *utf8, float x, float y, SDL_Color color,
+                       int layer);
+
+/* Same, drawn immediately through the cache's own batch */
+float glyph_cache_draw_now(GlyphCache *cache, TTF_Font *font, const char *utf8,
+                           float x, float y, SDL_Color color);
+
+/* Size of the text's box, laid out exactly as glyph_cache_draw would */
+void  glyph_cache_measure(GlyphCache *cache, TTF_Font *font, const char *utf8,
+                          int *w, int *h);
+
+/* Decode one codepoint and advance |s|; 0 at the end of the string */
+Uint32 glyph_utf8_next(const unsigned char **s);
+
+#endif // CONQUEST_GLYPH_CACHE_H
@@ -0,0 +1,114 @@
+#include "image_diff.h"
+#include "../../utils/log.h"
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static SDL_Surface *as_argb(SDL_Surface *s) {
+    if (s->format->format == SDL_PIXELFORMAT_ARGB8888) return s;
+    return SDL_ConvertSurfaceFormat(s, SDL_PIXELFORMAT_ARGB8888, 0);
+}
+
+/* Walk both images; |mask| (same size, ARGB8888) marks differing pixels */
+static int diff_pixels(SDL_Surface *a, SDL_Surface *b, int tolerance,
+                       ImageDiff *out, SDL_Surface *mask) {
+    ImageDiff d = {a->w, a->h, 0, 0, 0.0};
+    Uint64 sum = 0;
+    for (int y = 0; y < a->h; y++) {
+        const Uint32 *pa = (const Uint32 *)((const Uint8 *)a->pixels + (size_t)y * a->pitch);
+        const Uint32 *pb = (const Uint32 *)((const Uint8 *)b->pixels + (size_t)y * b->pitch);
+        Uint32 *pm = mask ? (Uint32 *)((Uint8 *)mask->pixels + (size_t)y * mask->pitch) : NULL;
+        for (int x = 0; x < a->w; x++) {
+            int worst = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                int delta = abs((int)((pa[x] >> shift) & 0xFF) - (int)((pb[x] >> shift) & 0xFF));
+                sum += delta;
+                if (delta > worst) worst = delta;
+            }
+            if (worst > d.max_delta) d.max_delta = worst;
+            bool over = worst > tolerance;
+            d.pixels_over += over;
+            /* differences in red over a dimmed copy of the expected frame */
+            if (pm)
+                pm[x] = over ? 0xFFFF0000u : 0xFF000000u | ((pb[x] >> 2) & 0x003F3F3Fu);
+        }
+    }
+    if (a->w && a->h)
+        d.mean_delta = (double)sum / ((double)a->w * a->h * 4);
+    if (out) *out = d;
+    return d.pixels_over;
+}
+
+int image_diff(SDL_Surface *actual, SDL_Surface *expected, int tolerance,
+               ImageDiff *out) {
+    if (out) memset(out, 0, sizeof *out);
+    if (!actual || !expected) return -1;
+    if (actual->w != expected->w || actual->h != expected->h) {
+        LOG_WARN("Image diff: size %dx%d vs expected %dx%d", actual->w, actual->h,
+                 expected->w, expected->h);
+        return -1;
+    }
+    SDL_Surface *a = as_argb(actual), *b = as_argb(expected);
+    int over = a && b ? diff_pixels(a, b, tolerance, out, NULL) : -1;
+    if (a && a != actual) SDL_FreeSurface(a);
+    if (b && b != expected) SDL_FreeSurface(b);
+    return over;
+}
+
+/* <golden without .png><suffix> */
+static void sibling_path(char *buf, size_t size, const char *golden, const char *suffix) {
+    size_t len = strlen(golden);
+    if (len > 4 && SDL_strcasecmp(golden + len - 4, ".png") == 0)
+        len -= 4;
+    snprintf(buf, size, "%.*s%s", (int)len, golden, suffix);
+}
+
+bool image_diff_golden(SDL_Surface *actual, const char *golden_path,
+                       int tolerance, int max_pixels, ImageDiff *out) {
+    ImageDiff d = {0};
+    if (out) *out = d;
+    if (!actual || !golden_path) return false;
+
+    SDL_Surface *golden = IMG_Load(golden_path);
+    if (!golden) {
+        /* never becomes the golden by itself: a missing one always fails */
+        char path[1024];
+        sibling_path(path, sizeof path, golden_path, ".actual.png");
+        LOG_ERROR("Golden %s missing, this frame is in %s", golden_path, path);
+        IMG_SavePNG(actual, path);
+        return false;
+    }
+
+    SDL_Surface *a = as_argb(actual), *b = as_argb(golden);
+    SDL_Surface *mask = NULL;
+    int over = -1;
+    if (a && b && a->w == b->w && a->h == b->h) {
+        mask = SDL_CreateRGBSurfaceWithFormat(0, a->w, a->h, 32, SDL_PIXELFORMAT_ARGB8888);
+        over = diff_pixels(a, b, tolerance, &d, mask);
+    } else if (a && b) {
+        LOG_ERROR("Golden %s is %dx%d, frame is %dx%d", golden_path, b->w, b->h,
+                  a->w, a->h);
+    }
+
+    bool match = over >= 0 && over <= max_pixels;
+    if (!match) {
+        char path[1024];
+        sibling_path(path, sizeof path, golden_path, ".actual.png");
+        if (a) IMG_SavePNG(a, path);
+        if (mask) {
+            sibling_path(path, sizeof path, golden_path, ".diff.png");
+            IMG_SavePNG(mask, path);
+        }
+        if (over >= 0)
+            LOG_ERROR("Golden %s: %d pixels over tolerance %d (max delta %d)",
+                      golden_path, over, tolerance, d.max_delta);
+    }
+
+    if (mask) SDL_FreeSurface(mask);
+    if (a && a != actual) SDL_FreeSurface(a);
+    if (b && b != golden) SDL_FreeSurface(b);
+    SDL_FreeSurface(golden);
+    if (out) *out = d;
+    return match;
+}
@@ -0,0 +1,36 @@
+#ifndef CONQUEST_IMAGE_DIFF_H
+#define CONQUEST_IMAGE_DIFF_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/*
+ * Pixel comparison of rendered frames against golden images.
+ *
+ * A pixel counts as different when any channel differs by more than the
+ * tolerance, which absorbs the rounding that differs between renderers.
+ * Images of different sizes never match.
+ */
+typedef struct ImageDiff {
+    int    width, height;
+    int    pixels_over;     /* pixels beyond the tolerance    */
+    int    max_delta;       /* largest channel difference     */
+    double mean_delta;      /* mean channel difference        */
+} ImageDiff;
+
+/* Compare two surfaces of any format. Returns the pixels over |tolerance|,
+   or -1 if they cannot be compared (size, memory) */
+int  image_diff(SDL_Surface *actual, SDL_Surface *expected, int tolerance,
+                ImageDiff *out);
+
+/*
+ * Compare |actual| with the PNG at |golden_path|; true when at most
+ * |max_pixels| pixels are over |tolerance|. On a mismatch the frame and a
+ * difference mask are written next to the golden (<name>.actual.png,
+ * <name>.diff.png). A missing golden is a failure too; only the frame is
+ * written, and the golden itself is never created here.
+ */
+bool image_diff_golden(SDL_Surface *actual, const char *golden_path,
+                       int tolerance, int max_pixels, ImageDiff *out);
+
+#endif // CONQUEST_IMAGE_DIFF_H
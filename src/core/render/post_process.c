@@ -0,0 +1,410 @@
+#include "post_process.h"
+#include "../../utils/log.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define POST_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(POST_HAVE_SSE2) && defined(__GNUC__)
+#define POST_HAVE_AVX2 1
+#include <immintrin.h>
+#define POST_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#define POST_MAX_BANDS     64
+#define POST_MIN_BAND_ROWS 16
+
+typedef struct PostBand {
+    PostProcess *pp;
+    Uint32      *pixels;
+    int          pitch, w, y0, y1;
+    Uint8       *scratch;          /* one row of factors */
+    int          scratch_cap;
+    Uint64       ticks[POST_FILTER_COUNT];
+} PostBand;
+
+struct PostProcess {
+    bool      enabled[POST_FILTER_COUNT];
+    bool      ready[POST_FILTER_COUNT];   /* set up for the current apply */
+    PostSimd  simd, simd_max;
+
+    Uint32    lut[3][256];                /* r << 16, g << 8, b */
+
+    Uint8    *fog;
+    int       fog_cols, fog_rows;
+    SDL_FRect fog_area;
+    int      *fog_col;                    /* grid column per x, -1 outside */
+    int       fog_col_cap;
+
+    float     vig_strength, vig_radius;
+    Uint8    *vig_mask;                   /* w×h factors */
+    int       vig_w, vig_h;
+    bool      vig_stale;
+
+    int       scan_period;
+    Uint8     scan_factor;
+
+    PostBand  bands[POST_MAX_BANDS];
+    WorkerBatch band_jobs;                /* on a pool shared with others */
+    PostProcessStats stats;
+};
+
+/* ─── kernels ─── */
+
+/* Every kernel scales channels by (f + 1) / 256, so 255 leaves a pixel
+   unchanged, and forces alpha to opaque */
+typedef void (*ScaleRowFn)(Uint32 *px, const Uint8 *f, int n);
+typedef void (*LutRowFn)(Uint32 *px, const Uint32 (*lut)[256], int n);
+
+static void scale_row_scalar(Uint32 *px, const Uint8 *f, int n) {
+    for (int i = 0; i < n; i++) {
+        Uint32 p = px[i], k = f[i] + 1u;
+        Uint32 rb = ((p & 0x00FF00FFu) * k >> 8) & 0x00FF00FFu;
+        Uint32 g  = ((p & 0x0000FF00u) * k >> 8) & 0x0000FF00u;
+        px[i] = 0xFF000000u | rb | g;
+    }
+}
+
+static void lut_row_scalar(Uint32 *px, const Uint32 (*lut)[256], int n) {
+    for (int i = 0; i < n; i++) {
+        Uint32 p = px[i];
+        px[i] = 0xFF000000u | lut[0][(p >> 16) & 0xFF] | lut[1][(p >> 8) & 0xFF] |
+                lut[2][p & 0xFF];
+    }
+}
+
+#ifdef POST_HAVE_SSE2
+static void scale_row_sse2(Uint32 *px, const Uint8 *f, int n) {
+    const __m128i zero = _mm_setzero_si128(), one = _mm_set1_epi16(1);
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000u);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int fi;
+        memcpy(&fi, f + i, sizeof fi);
+        __m128i k = _mm_add_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(fi), zero), one);
+        k = _mm_unpacklo_epi16(k, k);
+        __m128i k01 = _mm_unpacklo_epi32(k, k), k23 = _mm_unpackhi_epi32(k, k);
+
+        __m128i p = _mm_loadu_si128((const __m128i *)(px + i));
+        __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), k01), 8);
+        __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), k23), 8);
+        _mm_storeu_si128((__m128i *)(px + i), _mm_or_si128(_mm_packus_epi16(lo, hi), alpha));
+    }
+    scale_row_scalar(px + i, f + i, n - i);
+}
+#endif
+
+#ifdef POST_HAVE_AVX2
+POST_TARGET_AVX2
+static void scale_row_avx2(Uint32 *px, const Uint8 *f, int n) {
+    const __m256i zero = _mm256_setzero_si256(), one = _mm256_set1_epi32(1);
+    const __m256i alpha = _mm256_set1_epi32((int)0xFF000000u);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        /* factor per pixel, then four 16-bit copies per pixel; unpacks work
+           within 128-bit lanes, which pairs pixels 0,1 / 4,5 and 2,3 / 6,7 */
+        __m256i k = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(f + i)));
+        k = _mm256_add_epi32(k, one);
+        k = _mm256_or_si256(k, _mm256_slli_epi32(k, 16));
+        __m256i klo = _mm256_unpacklo_epi32(k, k), khi = _mm256_unpackhi_epi32(k, k);
+
+        __m256i p = _mm256_loadu_si256((const __m256i *)(px + i));
+        __m256i lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(p, zero), klo), 8);
+        __m256i hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(p, zero), khi), 8);
+        _mm256_storeu_si256((__m256i *)(px + i),
+                            _mm256_or_si256(_mm256_packus_epi16(lo, hi), alpha));
+    }
+    scale_row_scalar(px + i, f + i, n - i);
+}
+
+POST_TARGET_AVX2
+static void lut_row_avx2(Uint32 *px, const Uint32 (*lut)[256], int n) {
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    const __m256i alpha = _mm256_set1_epi32((int)0xFF000000u);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i p = _mm256_loadu_si256((const __m256i *)(px + i));
+        __m256i r = _mm256_i32gather_epi32((const int *)lut[0],
+                        _mm256_and_si256(_mm256_srli_epi32(p, 16), mask), 4);
+        __m256i g = _mm256_i32gather_epi32((const int *)lut[1],
+                        _mm256_and_si256(_mm256_srli_epi32(p, 8), mask), 4);
+        __m256i b = _mm256_i32gather_epi32((const int *)lut[2],
+                        _mm256_and_si256(p, mask), 4);
+        _mm256_storeu_si256((__m256i *)(px + i),
+                            _mm256_or_si256(_mm256_or_si256(r, g), _mm256_or_si256(b, alpha)));
+    }
+    lut_row_scalar(px + i, lut, n - i);
+}
+#endif
+
+static ScaleRowFn scale_row_for(PostSimd simd) {
+#ifdef POST_HAVE_AVX2
+    if (simd == POST_SIMD_AVX2) return scale_row_avx2;
+#endif
+#ifdef POST_HAVE_SSE2
+    if (simd >= POST_SIMD_SSE2) return scale_row_sse2;
+#endif
+    return scale_row_scalar;
+}
+
+/* SSE2 has no gather, so below AVX2 the table lookups stay scalar */
+static LutRowFn lut_row_for(PostSimd simd) {
+#ifdef POST_HAVE_AVX2
+    if (simd == POST_SIMD_AVX2) return lut_row_avx2;
+#endif
+    return lut_row_scalar;
+}
+
+static PostSimd simd_detect(void) {
+#ifdef POST_HAVE_AVX2
+    if (SDL_HasAVX2()) return POST_SIMD_AVX2;
+#endif
+#ifdef POST_HAVE_SSE2
+    if (SDL_HasSSE2()) return POST_SIMD_SSE2;
+#endif
+    return POST_SIMD_SCALAR;
+}
+
+/* ─── configuration ─── */
+
+PostProcess *post_process_create(void) {
+    PostProcess *pp = calloc(1, sizeof *pp);
+    if (!pp) return NULL;
+    pp->simd = pp->simd_max = simd_detect();
+    post_process_set_lut(pp, NULL, NULL, NULL);
+    post_process_set_vignette(pp, 0.5f, 0.5f);
+    post_process_set_scanlines(pp, 2, 0.25f);
+    for (int i = 0; i < POST_MAX_BANDS; i++)
+        pp->bands[i].pp = pp;
+    return pp;
+}
+
+void post_process_destroy(PostProcess *pp) {
+    if (!pp) return;
+    for (int i = 0; i < POST_MAX_BANDS; i++)
+        free(pp->bands[i].scratch);
+    free(pp->fog);
+    free(pp->fog_col);
+    free(pp->vig_mask);
+    free(pp);
+}
+
+void post_process_set_enabled(PostProcess *pp, PostFilter filter, bool enabled) {
+    if (pp && filter >= 0 && filter < POST_FILTER_COUNT)
+        pp->enabled[filter] = enabled;
+}
+
+bool post_process_enabled(const PostProcess *pp, PostFilter filter) {
+    return pp && filter >= 0 && filter < POST_FILTER_COUNT && pp->enabled[filter];
+}
+
+bool post_process_active(const PostProcess *pp) {
+    if (!pp) return false;
+    for (int f = 0; f < POST_FILTER_COUNT; f++)
+        if (pp->enabled[f]) return true;
+    return false;
+}
+
+void post_process_set_lut(PostProcess *pp, const Uint8 r[256],
+                          const Uint8 g[256], const Uint8 b[256]) {
+    if (!pp) return;
+    for (int i = 0; i < 256; i++) {
+        pp->lut[0][i] = (Uint32)(r ? r[i] : i) << 16;
+        pp->lut[1][i] = (Uint32)(g ? g[i] : i) << 8;
+        pp->lut[2][i] = (Uint32)(b ? b[i] : i);
+    }
+}
+
+void post_process_set_fog(PostProcess *pp, const Uint8 *light, int cols, int rows,
+                          const SDL_FRect *area) {
+    if (!pp) return;
+    if (!light || cols <= 0 || rows <= 0 || !area || area->w <= 0 || area->h <= 0) {
+        free(pp->fog);
+        pp->fog = NULL;
+        pp->fog_cols = pp->fog_rows = 0;
+        return;
+    }
+    if (cols * rows != pp->fog_cols * pp->fog_rows) {
+        Uint8 *fog = realloc(pp->fog, (size_t)cols * rows);
+        if (!fog) {
+            LOG_ERROR("PostProcess: out of memory for a %dx%d fog grid", cols, rows);
+            return;
+        }
+        pp->fog = fog;
+    }
+    memcpy(pp->fog, light, (size_t)cols * rows);
+    pp->fog_cols = cols;
+    pp->fog_rows = rows;
+    pp->fog_area = *area;
+}
+
+void post_process_set_vignette(PostProcess *pp, float strength, float radius) {
+    if (!pp) return;
+    pp->vig_strength = SDL_max(0.f, SDL_min(strength, 1.f));
+    pp->vig_radius = SDL_max(0.f, SDL_min(radius, 0.99f));
+    pp->vig_stale = true;
+}
+
+void post_process_set_scanlines(PostProcess *pp, int period, float darkness) {
+    if (!pp) return;
+    darkness = SDL_max(0.f, SDL_min(darkness, 1.f));
+    pp->scan_period = period < 2 ? 2 : period;
+    pp->scan_factor = (Uint8)((1.f - darkness) * 255.f + 0.5f);
+}
+
+void post_process_set_simd(PostProcess *pp, PostSimd level) {
+    if (pp) pp->simd = level < pp->simd_max ? level : pp->simd_max;
+}
+
+PostSimd post_process_simd(const PostProcess *pp) {
+    return pp ? pp->simd : POST_SIMD_SCALAR;
+}
+
+PostProcessStats post_process_stats(const PostProcess *pp) {
+    return pp ? pp->stats : (PostProcessStats){0};
+}
+
+/* ─── per-frame setup (main thread) ─── */
+
+static bool vignette_prepare(PostProcess *pp, int w, int h) {
+    if (pp->vig_mask && !pp->vig_stale && pp->vig_w == w && pp->vig_h == h)
+        return true;
+    Uint8 *mask = realloc(pp->vig_mask, (size_t)w * h);
+    if (!mask) {
+        LOG_ERROR("PostProcess: out of memory for a %dx%d vignette", w, h);
+        return false;
+    }
+    pp->vig_mask = mask;
+    pp->vig_w = w;
+    pp->vig_h = h;
+    pp->vig_stale = false;
+
+    float cx = w * 0.5f, cy = h * 0.5f;
+    float inv_diag = 1.f / sqrtf(cx * cx + cy * cy);
+    float inner = pp->vig_radius, span = 1.f - inner;
+    for (int y = 0; y < h; y++) {
+        float dy = (y + 0.5f - cy) * inv_diag;
+        for (int x = 0; x < w; x++) {
+            float dx = (x + 0.5f - cx) * inv_diag;
+            float t = (sqrtf(dx * dx + dy * dy) - inner) / span;
+            t = SDL_max(0.f, SDL_min(t, 1.f));
+            t = t * t * (3.f - 2.f * t);
+            mask[(size_t)y * w + x] = (Uint8)((1.f - pp->vig_strength * t) * 255.f + 0.5f);
+        }
+    }
+    return true;
+}
+
+static bool fog_prepare(PostProcess *pp, int w) {
+    if (!pp->fog) return false;
+    if (w > pp->fog_col_cap) {
+        int *cols = realloc(pp->fog_col, sizeof *cols * w);
+        if (!cols) return false;
+        pp->fog_col = cols;
+        pp->fog_col_cap = w;
+    }
+    float cell_w = pp->fog_area.w / pp->fog_cols;
+    for (int x = 0; x < w; x++) {
+        float gx = floorf((x + 0.5f - pp->fog_area.x) / cell_w);
+        pp->fog_col[x] = gx >= 0.f && gx < pp->fog_cols ? (int)gx : -1;
+    }
+    return true;
+}
+
+/* ─── bands ─── */
+
+static void fog_row(const PostProcess *pp, int y, Uint8 *out, int w) {
+    float gy = floorf((y + 0.5f - pp->fog_area.y) * pp->fog_rows / pp->fog_area.h);
+    if (gy < 0.f || gy >= pp->fog_rows) {
+        memset(out, 0, w);
+        return;
+    }
+    const Uint8 *light = pp->fog + (size_t)gy * pp->fog_cols;
+    for (int x = 0; x < w; x++) {
+        int c = pp->fog_col[x];
+        out[x] = c < 0 ? 0 : light[c];
+    }
+}
+
+static void band_run(void *userdata) {
+    PostBand *b = userdata;
+    const PostProcess *pp = b->pp;
+    ScaleRowFn scale = scale_row_for(pp->simd);
+    LutRowFn lut = lut_row_for(pp->simd);
+
+    for (int f = 0; f < POST_FILTER_COUNT; f++) {
+        if (!pp->ready[f]) continue;
+        if ((f == POST_FOG || f == POST_SCANLINES) && !b->scratch) continue;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int y = b->y0; y < b->y1; y++) {
+            Uint32 *row = (Uint32 *)((Uint8 *)b->pixels + (size_t)y * b->pitch);
+            switch (f) {
+            case POST_LUT:
+                lut(row, pp->lut, b->w);
+                break;
+            case POST_FOG:
+                fog_row(pp, y, b->scratch, b->w);
+                scale(row, b->scratch, b->w);
+                break;
+            case POST_VIGNETTE:
+                scale(row, pp->vig_mask + (size_t)y * b->w, b->w);
+                break;
+            case POST_SCANLINES:
+                if (y % pp->scan_period != pp->scan_period - 1) break;
+                memset(b->scratch, pp->scan_factor, b->w);
+                scale(row, b->scratch, b->w);
+                break;
+            }
+        }
+        b->ticks[f] += SDL_GetPerformanceCounter() - start;
+    }
+}
+
+void post_process_apply(PostProcess *pp, Uint32 *pixels, int w, int h, int pitch,
+                        WorkerPool *pool) {
+    if (!pp || !pixels || w <= 0 || h <= 0 || pitch < w * 4) return;
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    pp->ready[POST_LUT] = pp->enabled[POST_LUT];
+    pp->ready[POST_FOG] = pp->enabled[POST_FOG] && fog_prepare(pp, w);
+    pp->ready[POST_VIGNETTE] = pp->enabled[POST_VIGNETTE] && vignette_prepare(pp, w, h);
+    pp->ready[POST_SCANLINES] = pp->enabled[POST_SCANLINES];
+
+    int bands = pool ? worker_pool_thread_count(pool) + 1 : 1;
+    bands = SDL_min(bands, h / POST_MIN_BAND_ROWS);
+    bands = SDL_max(1, SDL_min(bands, POST_MAX_BANDS));
+
+    for (int i = 0; i < bands; i++) {
+        PostBand *b = &pp->bands[i];
+        b->pixels = pixels;
+        b->pitch = pitch;
+        b->w = w;
+        b->y0 = h * i / bands;
+        b->y1 = h * (i + 1) / bands;
+        memset(b->ticks, 0, sizeof b->ticks);
+        if (w > b->scratch_cap) {
+            free(b->scratch);
+            b->scratch = malloc(w);
+            b->scratch_cap = b->scratch ? w : 0;
+        }
+    }
+
+    /* the calling thread takes the first band itself */
+    for (int i = 1; i < bands; i++)
+        if (worker_pool_submit_batch(pool, &pp->band_jobs, band_run, &pp->bands[i]) != 0)
+            band_run(&pp->bands[i]);
+    band_run(&pp->bands[0]);
+    if (bands > 1)
+        worker_pool_wait_batch(pool, &pp->band_jobs);
+
+    double to_ms = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    memset(&pp->stats, 0, sizeof pp->stats);
+    for (int i = 0; i < bands; i++)
+        for (int f = 0; f < POST_FILTER_COUNT; f++)
+            pp->stats.filter_ms[f] += pp->bands[i].ticks[f] * to_ms;
+    pp->stats.bands = bands;
+    pp->stats.total_ms = (SDL_GetPerformanceCounter() - start) * to_ms;
+}
@@ -0,0 +1,80 @@
+#ifndef CONQUEST_POST_PROCESS_H
+#define CONQUEST_POST_PROCESS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "../jobs/worker_pool.h"
+
+/*
+ * CPU post-processing of a finished frame.
+ *
+ * Works on ARGB8888 pixels read back from the renderer, so it runs the same
+ * on the software renderer as on a GPU. The frame is cut into bands of rows
+ * that go through every enabled filter on a worker thread each, while the
+ * band is still in cache. Filters always run in this order:
+ *
+ *   LUT        per-channel colour grading curves
+ *   FOG        fog-of-war: dims the screen by a light grid (0 dark, 255 lit)
+ *   VIGNETTE   darkens towards the corners
+ *   SCANLINES  darkens every |period|-th row
+ *
+ * The kernels have AVX2 and SSE2 versions picked at run time, and a scalar
+ * fallback for everything else.
+ */
+typedef enum {
+    POST_LUT,
+    POST_FOG,
+    POST_VIGNETTE,
+    POST_SCANLINES,
+    POST_FILTER_COUNT
+} PostFilter;
+
+typedef enum {
+    POST_SIMD_SCALAR,
+    POST_SIMD_SSE2,
+    POST_SIMD_AVX2
+} PostSimd;
+
+typedef struct PostProcessStats {
+    double filter_ms[POST_FILTER_COUNT];  /* CPU time, summed over threads */
+    double total_ms;                      /* wall time of the whole chain  */
+    int    bands;
+} PostProcessStats;
+
+typedef struct PostProcess PostProcess;
+
+PostProcess *post_process_create(void);
+void         post_process_destroy(PostProcess *pp);
+
+void post_process_set_enabled(PostProcess *pp, PostFilter filter, bool enabled);
+bool post_process_enabled(const PostProcess *pp, PostFilter filter);
+/* True if any filter is enabled */
+bool post_process_active(const PostProcess *pp);
+
+/* Curves map each 0–255 channel value; NULL keeps that channel unchanged */
+void post_process_set_lut(PostProcess *pp, const Uint8 r[256],
+                          const Uint8 g[256], const Uint8 b[256]);
+
+/* |light| is cols×rows, row-major, and is copied. |area| is the screen
+   rectangle the grid covers; pixels outside it are treated as dark */
+void post_process_set_fog(PostProcess *pp, const Uint8 *light, int cols, int rows,
+                          const SDL_FRect *area);
+
+/* |strength| 0–1 at the corners; no darkening inside |radius| (0–1 of the
+   half diagonal) */
+void post_process_set_vignette(PostProcess *pp, float strength, float radius);
+
+/* Every |period|-th row (>= 2) is darkened by |darkness| 0–1 */
+void post_process_set_scanlines(PostProcess *pp, int period, float darkness);
+
+/* Highest supported level by default; lower it to compare paths */
+void     post_process_set_simd(PostProcess *pp, PostSimd level);
+PostSimd post_process_simd(const PostProcess *pp);
+
+/* Run the enabled filters over |pixels| in place. |pool| may be NULL */
+void post_process_apply(PostProcess *pp, Uint32 *pixels, int w, int h, int pitch,
+                        WorkerPool *pool);
+
+PostProcessStats post_process_stats(const PostProcess *pp);
+
+#endif // CONQUEST_POST_PROCESS_H
@@ -0,0 +1,272 @@
+#include "render_commands.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RENDER_CMD_MIN_CAPACITY 256
+#define RENDER_CMD_MAX_LISTS    0xFFFF
+
+struct RenderCommandList {
+    RenderCommand *cmds;
+    int            count, capacity;
+    char          *text;          /* NUL-separated strings for text runs */
+    int            text_len, text_cap;
+    short          layer;
+};
+
+/* ─── recording (any thread, one per list) ─── */
+
+RenderCommandList *render_cmd_list_create(void) {
+    return calloc(1, sizeof(RenderCommandList));
+}
+
+void render_cmd_list_destroy(RenderCommandList *list) {
+    if (!list) return;
+    free(list->cmds);
+    free(list->text);
+    free(list);
+}
+
+void render_cmd_list_reset(RenderCommandList *list) {
+    if (!list) return;
+    list->count = 0;
+    list->text_len = 0;
+    list->layer = 0;
+}
+
+int render_cmd_list_count(const RenderCommandList *list) {
+    return list ? list->count : 0;
+}
+
+void render_cmd_layer(RenderCommandList *list, int layer) {
+    if (!list) return;
+    if (layer < -32768) layer = -32768;
+    if (layer > 32767) layer = 32767;
+    list->layer = (short)layer;
+}
+
+static RenderCommand *cmd_push(RenderCommandList *list, RenderCommandType type) {
+    if (!list) return NULL;
+    if (list->count == list->capacity) {
+        int cap = list->capacity ? list->capacity * 2 : RENDER_CMD_MIN_CAPACITY;
+        RenderCommand *cmds = realloc(list->cmds, sizeof *cmds * cap);
+        if (!cmds) return NULL;
+        list->cmds = cmds;
+        list->capacity = cap;
+    }
+    RenderCommand *c = &list->cmds[list->count++];
+    c->type = type;
+    c->layer = list->layer;
+    return c;
+}
+
+void render_cmd_sprite(RenderCommandList *list, SDL_Texture *texture,
+                       const SDL_Rect *src, const SDL_FRect *dst, SDL_Color color) {
+    if (!texture || !dst) return;
+    RenderCommand *c = cmd_push(list, RENDER_CMD_SPRITE);
+    if (!c) return;
+    c->sprite.texture = texture;
+    c->sprite.whole = src == NULL;
+    c->sprite.src = src ? *src : (SDL_Rect){0};
+    c->sprite.dst = *dst;
+    c->sprite.color = color;
+}
+
+void render_cmd_fill(RenderCommandList *list, const SDL_FRect *rect, SDL_Color color) {
+    if (!rect) return;
+    RenderCommand *c = cmd_push(list, RENDER_CMD_FILL_RECT);
+    if (!c) return;
+    c->fill.rect = *rect;
+    c->fill.color = color;
+}
+
+void render_cmd_text(RenderCommandList *list, TTF_Font *font, const char *utf8,
+                     float x, float y, SDL_Color color) {
+    if (!list || !font || !utf8 || !*utf8) return;
+    int len = (int)strlen(utf8) + 1;
+    if (list->text_len + len > list->text_cap) {
+        int cap = list->text_cap ? list->text_cap : 1024;
+        while (cap < list->text_len + len) cap *= 2;
+        char *text = realloc(list->text, cap);
+        if (!text) return;
+        list->text = text;
+        list->text_cap = cap;
+    }
+    RenderCommand *c = cmd_push(list, RENDER_CMD_TEXT);
+    if (!c) return;
+    memcpy(list->text + list->text_len, utf8, len);
+    c->text.font = font;
+    c->text.text = list->text_len;
+    c->text.x = x;
+    c->text.y = y;
+    c->text.color = color;
+    list->text_len += len;
+}
+
+void render_cmd_clip(RenderCommandList *list, const SDL_Rect *rect) {
+    RenderCommand *c = cmd_push(list, RENDER_CMD_CLIP);
+    if (!c) return;
+    c->clip.enabled = rect != NULL;
+    c->clip.rect = rect ? *rect : (SDL_Rect){0};
+}
+
+void render_cmd_target(RenderCommandList *list, SDL_Texture *texture) {
+    RenderCommand *c = cmd_push(list, RENDER_CMD_TARGET);
+    if (c) c->target.texture = texture;
+}
+
+/* ─── submission (main thread) ─── */
+
+void render_cmd_order_free(RenderCmdOrder *order) {
+    if (!order) return;
+    free(order->keys);
+    order->keys = NULL;
+    order->capacity = 0;
+}
+
+static int order_compare(const void *a, const void *b) {
+    Uint64 x = *(const Uint64 *)a, y = *(const Uint64 *)b;
+    return (x > y) - (x < y);
+}
+
+/* Without a glyph cache: rasterise the run on the spot */
+static void draw_text(SDL_Renderer *ren, const RenderCommandList *list,
+                      const RenderCommand *c) {
+    SDL_Surface *s = TTF_RenderUTF8_Blended(c->text.font, list->text + c->text.text,
+                                            c->text.color);
+    if (!s) return;
+    SDL_Texture *tex = SDL_CreateTextureFromSurface(ren, s);
+    SDL_FRect dst = {c->text.x, c->text.y, (float)s->w, (float)s->h};
+    SDL_FreeSurface(s);
+    if (!tex) return;
+    SDL_RenderCopyF(ren, tex, NULL, &dst);
+    SDL_DestroyTexture(tex);
+}
+
+int render_cmd_execute(RenderCommandList *const *lists, int count,
+                       RenderCmdOrder *order, SDL_Renderer *ren,
+                       SpriteBatch *batch, GlyphCache *glyphs) {
+    if (!lists || count <= 0 || !order || !ren) return 0;
+    if (count > RENDER_CMD_MAX_LISTS) count = RENDER_CMD_MAX_LISTS;
+
+    int total = 0;
+    for (int l = 0; l < count; l++)
+        total += render_cmd_list_count(lists[l]);
+    if (!total) return 0;
+
+    if (total > order->capacity) {
+        Uint64 *keys = realloc(order->keys, sizeof *keys * total);
+        if (!keys) {
+            LOG_ERROR("Render commands: out of memory for %d commands", total);
+            return 0;
+        }
+        order->keys = keys;
+        order->capacity = total;
+    }
+
+    /* layer:16 list:16 index:32 – unique, so ordering by key is stable */
+    Uint64 *keys = order->keys;
+
+    int n = 0, sorted = 1;
+    for (int l = 0; l < count; l++) {
+        const RenderCommandList *list = lists[l];
+        for (int i = 0; list && i < list->count; i++) {
+            Uint64 key = ((Uint64)(list->cmds[i].layer + 32768) << 48) |
+                         ((Uint64)l << 32) | (Uint32)i;
+            if (n && key < keys[n - 1]) sorted = 0;
+            keys[n++] = key;
+        }
+    }
+    if (!sorted)
+        qsort(keys, n, sizeof *keys, order_compare);
+
+    SDL_Texture *base_target = SDL_GetRenderTarget(ren);
+    SDL_Texture *target = base_target;
+    bool clipped = false;
+    Uint64 segment = ~(Uint64)0;
+
+    /* consecutive quads of one texture share a batch layer, so the batch
+       merges them into one draw call without ever reordering anything */
+    SDL_Texture *run_texture = NULL;
+    int run = -32768;
+
+    for (int k = 0; k < n; k++) {
+        int l = (int)((keys[k] >> 32) & 0xFFFF);
+        const RenderCommandList *list = lists[l];
+        const RenderCommand *c = &list->cmds[(Uint32)keys[k]];
+
+        /* a new list or layer only breaks the run if it has state to reset */
+        bool next_segment = (keys[k] >> 32) != segment;
+        bool reset = next_segment && (clipped || target != base_target);
+        bool is_quad = c->type == RENDER_CMD_SPRITE || c->type == RENDER_CMD_FILL_RECT ||
+                       (c->type == RENDER_CMD_TEXT && batch && glyphs);
+        if (!is_quad || reset)
+            sprite_batch_flush(batch, ren), run = -32768, run_texture = NULL;
+
+        if (next_segment) {
+            segment = keys[k] >> 32;
+            if (clipped) SDL_RenderSetClipRect(ren, NULL), clipped = false;
+            if (target != base_target)
+                SDL_SetRenderTarget(ren, base_target), target = base_target;
+        }
+
+        switch (c->type) {
+        case RENDER_CMD_SPRITE:
+        case RENDER_CMD_FILL_RECT: {
+            SDL_Texture *tex = c->type == RENDER_CMD_SPRITE ? c->sprite.texture : NULL;
+            if (tex != run_texture || run == -32768) {
+                if (run == 32767)
+                    sprite_batch_flush(batch, ren), run = -32768;
+                run++;
+                run_texture = tex;
+            }
+            if (!batch) {
+                if (tex) {
+                    SDL_SetTextureColorMod(tex, c->sprite.color.r, c->sprite.color.g,
+                                           c->sprite.color.b);
+                    SDL_SetTextureAlphaMod(tex, c->sprite.color.a);
+                    SDL_RenderCopyF(ren, tex, c->sprite.whole ? NULL : &c->sprite.src,
+                                    &c->sprite.dst);
+                } else {
+                    SDL_SetRenderDrawColor(ren, c->fill.color.r, c->fill.color.g,
+                                           c->fill.color.b, c->fill.color.a);
+                    SDL_RenderFillRectF(ren, &c->fill.rect);
+                }
+            } else if (tex) {
+                sprite_batch_draw(batch, tex, c->sprite.whole ? NULL : &c->sprite.src,
+                                  &c->sprite.dst, c->sprite.color, run);
+            } else {
+                sprite_batch_fill(batch, &c->fill.rect, c->fill.color, run);
+            }
+            break;
+        }
+        case RENDER_CMD_TEXT:
+            if (!is_quad) {
+                draw_text(ren, list, c);
+                break;
+            }
+            /* a text run gets batch layers of its own: its glyphs may sit on
+               several atlas pages, and nothing around it may move */
+            if (run >= 32766)
+                sprite_batch_flush(batch, ren), run = -32768;
+            glyph_cache_draw(glyphs, batch, c->text.font, list->text + c->text.text,
+                             c->text.x, c->text.y, c->text.color, ++run);
+            run_texture = NULL;
+            run++;
+            break;
+        case RENDER_CMD_CLIP:
+            SDL_RenderSetClipRect(ren, c->clip.enabled ? &c->clip.rect : NULL);
+            clipped = c->clip.enabled;
+            break;
+        case RENDER_CMD_TARGET:
+            target = c->target.texture ? c->target.texture : base_target;
+            SDL_SetRenderTarget(ren, target);
+            break;
+        }
+    }
+
+    sprite_batch_flush(batch, ren);
+    if (clipped) SDL_RenderSetClipRect(ren, NULL);
+    if (target != base_target) SDL_SetRenderTarget(ren, base_target);
+    return n;
+}
@@ -0,0 +1,84 @@
+#ifndef CONQUEST_RENDER_COMMANDS_H
+#define CONQUEST_RENDER_COMMANDS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "sprite_batch.h"
+#include "glyph_cache.h"
+
+/*
+ * Plain-data draw commands.
+ *
+ * A RenderCommandList is filled by exactly one thread at a time and never
+ * calls SDL, so scene traversal can run on worker threads.  On the main
+ * thread render_cmd_execute() merges any number of lists, orders them by
+ * (layer, list, recording order) and submits them through a SpriteBatch;
+ * text runs become glyph quads in the same batch.
+ *
+ * Clip and target commands are state changes: they apply to the commands
+ * that follow them in the same list and layer, and are reset (no clip,
+ * default target) whenever execution moves to another list or layer.
+ * Otherwise the lists are one stream: a run of quads with the same texture
+ * goes out as one draw call even where it crosses from one list to the next.
+ */
+typedef enum {
+    RENDER_CMD_SPRITE,
+    RENDER_CMD_FILL_RECT,
+    RENDER_CMD_TEXT,
+    RENDER_CMD_CLIP,
+    RENDER_CMD_TARGET
+} RenderCommandType;
+
+typedef struct RenderCommand {
+    RenderCommandType type;
+    short             layer;
+    union {
+        struct { SDL_Texture *texture; SDL_Rect src; SDL_FRect dst;
+                 SDL_Color color; bool whole; }             sprite;
+        struct { SDL_FRect rect; SDL_Color color; }         fill;
+        struct { TTF_Font *font; int text; /* arena offset */
+                 float x, y; SDL_Color color; }             text;
+        struct { SDL_Rect rect; bool enabled; }             clip;
+        struct { SDL_Texture *texture; }                    target;
+    };
+} RenderCommand;
+
+typedef struct RenderCommandList RenderCommandList;
+
+/* Sort scratch for render_cmd_execute, kept by the caller between frames */
+typedef struct RenderCmdOrder {
+    Uint64 *keys;
+    int     capacity;
+} RenderCmdOrder;
+
+void render_cmd_order_free(RenderCmdOrder *order);
+
+RenderCommandList *render_cmd_list_create(void);
+void               render_cmd_list_destroy(RenderCommandList *list);
+
+/* Forget the recorded commands, keeping the memory for the next frame */
+void render_cmd_list_reset(RenderCommandList *list);
+int  render_cmd_list_count(const RenderCommandList *list);
+
+/* Layer for the commands recorded after this call (default 0) */
+void render_cmd_layer(RenderCommandList *list, int layer);
+
+/* |src| NULL means the whole texture */
+void render_cmd_sprite(RenderCommandList *list, SDL_Texture *texture,
+                       const SDL_Rect *src, const SDL_FRect *dst, SDL_Color color);
+void render_cmd_fill(RenderCommandList *list, const SDL_FRect *rect, SDL_Color color);
+/* |utf8| is copied into the list */
+void render_cmd_text(RenderCommandList *list, TTF_Font *font, const char *utf8,
+                     float x, float y, SDL_Color color);
+/* |rect| NULL disables clipping */
+void render_cmd_clip(RenderCommandList *list, const SDL_Rect *rect);
+/* |texture| NULL returns to the default target */
+void render_cmd_target(RenderCommandList *list, SDL_Texture *texture);
+
+/* Submit |lists| in order on the main thread, sorting through |order|.
+   Returns commands executed */
+int  render_cmd_execute(RenderCommandList *const *lists, int count,
+                        RenderCmdOrder *order, SDL_Renderer *renderer,
+                        SpriteBatch *batch, GlyphCache *glyphs);
+
+#endif // CONQUEST_RENDER_COMMANDS_H
@@ -1,4 +1,5 @@
 #include "render_service.h"
+#include "../../utils/log.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -18,15 +19,124 @@ RenderService *renderer_init(SDL_Renderer *renderer, SDL_Window *window) {
     SDL_SetRenderDrawBlendMode(R->renderer, SDL_BLENDMODE_BLEND);
     
     // Initialize layer system
-    R->layer_count = 0;
-    memset(R->layers, 0, sizeof(R->layers));
-    
+    R->layers = NULL;
+    R->order = NULL;
+    R->layer_cap = R->layer_high = R->layer_count = 0;
+    R->free_slot = -1;
+    R->next_seq = 0;
+
+    R->sprites = sprite_batch_create(0);
+    R->workers = worker_pool_create(0);
+    R->records.pending = 0;
+    R->record_lists = NULL;
+    R->record_lists_cap = 0;
+    R->record_order = (RenderCmdOrder){0};
+    R->glyphs = glyph_cache_create(renderer);
+    R->post = post_process_create();
+    R->post_target = R->post_frame = NULL;
+    R->post_pixels = NULL;
+    R->post_w = R->post_h = 0;
+    R->post_bound = false;
+
+    int w = 0, h = 0;
+    SDL_GetRendererOutputSize(renderer, &w, &h);
+    camera_init(&R->camera, w, h);
+    R->camera_fit_output = true;
+    memset(&R->stats, 0, sizeof R->stats);
+    memset(&R->last_stats, 0, sizeof R->last_stats);
+
     return R;
 }
 
+static void layer_release(RenderLayer *L) {
+    if (L->cache)
+        SDL_DestroyTexture(L->cache);
+    L->cache = NULL;
+    render_cmd_list_destroy(L->commands);
+    L->commands = NULL;
+}
+
+static void post_release(RenderService *R) {
+    if (R->post_target) SDL_DestroyTexture(R->post_target);
+    if (R->post_frame) SDL_DestroyTexture(R->post_frame);
+    free(R->post_pixels);
+    R->post_target = R->post_frame = NULL;
+    R->post_pixels = NULL;
+    R->post_w = R->post_h = 0;
+}
+
+/* Offscreen target (when supported), upload texture and pixel buffer at
+   output size */
+static bool post_ready(RenderService *R) {
+    int w, h;
+    if (SDL_GetRendererOutputSize(R->renderer, &w, &h) != 0 || w <= 0 || h <= 0)
+        return false;
+    if (R->post_frame && R->post_w == w && R->post_h == h)
+        return true;
+
+    post_release(R);
+    R->post_pixels = malloc((size_t)w * h * sizeof *R->post_pixels);
+    R->post_frame = SDL_CreateTexture(R->renderer, SDL_PIXELFORMAT_ARGB8888,
+                                      SDL_TEXTUREACCESS_STREAMING, w, h);
+    if (!R->post_pixels || !R->post_frame) {
+        LOG_ERROR("Post-process disabled, no %dx%d frame buffer: %s", w, h,
+                  SDL_GetError());
+        post_release(R);
+        return false;
+    }
+    SDL_SetTextureBlendMode(R->post_frame, SDL_BLENDMODE_NONE);
+    /* without render targets the back buffer itself is read back */
+    if (SDL_RenderTargetSupported(R->renderer))
+        R->post_target = SDL_CreateTexture(R->renderer, SDL_PIXELFORMAT_ARGB8888,
+                                           SDL_TEXTUREACCESS_TARGET, w, h);
+    if (R->post_target)
+        SDL_SetTextureBlendMode(R->post_target, SDL_BLENDMODE_NONE);
+    R->post_w = w;
+    R->post_h = h;
+    return true;
+}
+
+/* Read the frame back, filter it and put it on the screen */
+static void post_present(RenderService *R) {
+    int pitch = R->post_w * (int)sizeof *R->post_pixels;
+    SDL_Rect area = {0, 0, R->post_w, R->post_h};
+    int ok = SDL_RenderReadPixels(R->renderer, &area, SDL_PIXELFORMAT_ARGB8888,
+                                  R->post_pixels, pitch);
+    if (R->post_bound)
+        SDL_SetRenderTarget(R->renderer, NULL);
+    R->post_bound = false;
+    if (ok != 0) {
+        LOG_WARN("Post-process: read back failed: %s", SDL_GetError());
+        if (R->post_target)
+            SDL_RenderCopy(R->renderer, R->post_target, NULL, NULL);
+        return;
+    }
+
+    post_process_apply(R->post, R->post_pixels, R->post_w, R->post_h, pitch,
+                       R->workers);
+    SDL_UpdateTexture(R->post_frame, NULL, R->post_pixels, pitch);
+    SDL_RenderCopy(R->renderer, R->post_frame, NULL, NULL);
+}
+
 void renderer_shutdown(RenderService *R) {
     if (!R) return;
 
+    renderer_remove_all_layers(R);
+    free(R->layers);
+    free(R->order);
+    free(R->record_lists);
+    render_cmd_order_free(&R->record_order);
+
+    worker_pool_destroy(R->workers);
+    R->workers = NULL;
+    sprite_batch_destroy(R->sprites);
+    R->sprites = NULL;
+    glyph_cache_destroy(R->glyphs);
+    R->glyphs = NULL;
+    post_release(R);
+    post_process_destroy(R->post);
+    R->post = NULL;
+
     if (R->renderer) {
         SDL_DestroyRenderer(R->renderer);
         R->renderer = NULL;
@@ -37,92 +147,469 @@ void renderer_shutdown(RenderService *R) {
         R->window = NULL;
     }
 
-    // Clear layers
-    R->layer_count = 0;
-    memset(R->layers, 0, sizeof(R->layers));
-
     free(R);
 }
 
 void renderer_begin_frame(RenderService *R) {
     if (!R || !R->renderer) return;
 
+    R->last_stats = R->stats;
+    memset(&R->stats, 0, sizeof R->stats);
+    if (R->camera_fit_output)
+        SDL_GetRendererOutputSize(R->renderer, &R->camera.viewport.w,
+                                  &R->camera.viewport.h);
+
+    R->post_bound = false;
+    if (post_process_active(R->post) && post_ready(R) && R->post_target)
+        R->post_bound = SDL_SetRenderTarget(R->renderer, R->post_target) == 0;
+
     // Clear the screen with a default color (black)
     SDL_SetRenderDrawColor(R->renderer, 0, 0, 0, 255);
     SDL_RenderClear(R->renderer);
 }
 
-void renderer_present(RenderService *R)
-{
-    if (!R || !R->renderer) return;
+static void layer_draw(RenderService *R, RenderLayer *L) {
+    L->render_func(R->renderer, L->userdata);
+    if (sprite_batch_count(R->sprites))
+        sprite_batch_flush(R->sprites, R->renderer);
+}
+
+/* (Re)create the cache at output size; a new cache must be drawn in full */
+static bool layer_cache_ready(RenderService *R, RenderLayer *L) {
+    int w, h;
+    if (SDL_GetRendererOutputSize(R->renderer, &w, &h) != 0)
+        return false;
+    if (L->cache && L->cache_w == w && L->cache_h == h)
+        return true;
+
+    if (L->cache)
+        SDL_DestroyTexture(L->cache);
+    L->cache = NULL;
+    if (!SDL_RenderTargetSupported(R->renderer))
+        return false;
+    L->cache = SDL_CreateTexture(R->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                 SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!L->cache) {
+        LOG_WARN("Layer '%s' drawn immediate, no render target: %s",
+                 L->name, SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(L->cache, SDL_BLENDMODE_BLEND);
+    L->cache_w = w;
+    L->cache_h = h;
+    dirty_region_invalidate(L->dirty);
+    return true;
+}
 
+static void layer_draw_retained(RenderService *R, RenderLayer *L) {
+    SDL_Renderer *ren = R->renderer;
+    if (!layer_cache_ready(R, L)) {
+        layer_draw(R, L);
+        dirty_region_clear(L->dirty);
+        return;
+    }
+
+    if (!dirty_region_empty(L->dirty)) {
+        SDL_Rect whole = {0, 0, L->cache_w, L->cache_h};
+        const SDL_Rect *rects = L->dirty->full ? &whole : L->dirty->rects;
+        int count = L->dirty->full ? 1 : L->dirty->count;
+
+        SDL_Texture *prev = SDL_GetRenderTarget(ren);
+        SDL_SetRenderTarget(ren, L->cache);
+        for (int i = 0; i < count; i++) {
+            SDL_RenderSetClipRect(ren, &rects[i]);
+            SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_NONE);
+            SDL_SetRenderDrawColor(ren, 0, 0, 0, 0);
+            SDL_RenderFillRect(ren, &rects[i]);
+            SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+            layer_draw(R, L);
+        }
+        SDL_RenderSetClipRect(ren, NULL);
+        SDL_SetRenderTarget(ren, prev);
+        dirty_region_clear(L->dirty);
+    }
+    SDL_RenderCopy(ren, L->cache, NULL, NULL);
+}
+
+static void layer_record(void *userdata) {
+    RenderLayer *L = userdata;
+    render_cmd_list_reset(L->commands);
+    L->record_func(L->commands, L->userdata);
+}
+
+/* Record every recorded layer, in parallel when there is more than one */
+static void record_layers(RenderService *R) {
+    int pending = 0;
     for (int i = 0; i < R->layer_count; ++i) {
-        RenderLayer *L = &R->layers[i];
-        if (L->render_func)
-            L->render_func(R->renderer, L->userdata);
+        RenderLayer *L = &R->layers[R->order[i]];
+        pending += L->enabled && L->record_func;
     }
-    SDL_RenderPresent(R->renderer);
+    if (!pending) return;
+
+    for (int i = 0; i < R->layer_count; ++i) {
+        RenderLayer *L = &R->layers[R->order[i]];
+        if (!L->enabled || !L->record_func) continue;
+        if (pending > 1 && R->workers &&
+            worker_pool_submit_batch(R->workers, &R->records, layer_record, L) == 0)
+            continue;
+        layer_record(L);
+    }
+    worker_pool_wait_batch(R->workers, &R->records);
+}
+
+/* Execute the recorded lists gathered so far in one submission pass */
+static void execute_recorded(RenderService *R, int *count) {
+    if (*count)
+        render_cmd_execute(R->record_lists, *count, &R->record_order,
+                           R->renderer, R->sprites, R->glyphs);
+    *count = 0;
+}
+
+/* Record and draw every enabled layer onto the current target */
+static void draw_layers(RenderService *R) {
+    record_layers(R);
+
+    if (R->layer_count > R->record_lists_cap) {
+        RenderCommandList **lists =
+            realloc(R->record_lists, sizeof *lists * R->layer_count);
+        if (lists) {
+            R->record_lists = lists;
+            R->record_lists_cap = R->layer_count;
+        }
+    }
+
+    int recorded = 0;
+    for (int i = 0; i < R->layer_count; ++i) {
+        RenderLayer *L = &R->layers[R->order[i]];
+        if (!L->enabled)
+            continue;
+        R->stats.layers++;
+        if (L->record_func) {
+            if (recorded == R->record_lists_cap)   /* grow failed above */
+                execute_recorded(R, &recorded);
+            if (R->record_lists_cap)
+                R->record_lists[recorded++] = L->commands;
+            else
+                render_cmd_execute(&L->commands, 1, &R->record_order,
+                                   R->renderer, R->sprites, R->glyphs);
+            continue;
+        }
+        execute_recorded(R, &recorded);
+        if (!L->render_func)
+            continue;
+        if (L->dirty)
+            layer_draw_retained(R, L);
+        else
+            layer_draw(R, L);
+    }
+    execute_recorded(R, &recorded);
 }
 
-int renderer_add_layer(RenderService *R,
-                       RenderFunc     fn,
-                       void          *userdata,
-                       const char    *name)
+void renderer_present(RenderService *R)
 {
-    if (!R || !fn || R->layer_count >= MAX_RENDER_LAYERS) return -1;
-    RenderLayer *L   = &R->layers[R->layer_count++];
-    L->render_func   = fn;
-    L->userdata      = userdata;          /* NEW */
-    strncpy(L->name, name, sizeof L->name - 1);
-    return R->layer_count - 1;
+    if (!R || !R->renderer) return;
+
+    draw_layers(R);
+    if (R->post_bound || (post_process_active(R->post) && R->post_frame))
+        post_present(R);
+    SDL_RenderPresent(R->renderer);
 }
 
-void renderer_remove_layer_index(RenderService *R, int index) {
-    if (!R || index < 0 || index >= R->layer_count) {
-        return;
+SDL_Surface *renderer_capture(RenderService *R) {
+    if (!R || !R->renderer) return NULL;
+    SDL_Renderer *ren = R->renderer;
+    int w, h;
+    if (SDL_GetRendererOutputSize(ren, &w, &h) != 0 || w <= 0 || h <= 0)
+        return NULL;
+
+    SDL_Surface *shot = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32,
+                                                       SDL_PIXELFORMAT_ARGB8888);
+    if (!shot) {
+        LOG_ERROR("Capture: no %dx%d surface: %s", w, h, SDL_GetError());
+        return NULL;
     }
 
-    // Shift remaining layers down
-    for (int i = index; i < R->layer_count - 1; i++) {
-        R->layers[i] = R->layers[i + 1];
+    /* a frame of its own, so the stats and target of the frame in progress
+       are left alone; without render targets the back buffer is used */
+    RenderStats stats = R->stats;
+    memset(&R->stats, 0, sizeof R->stats);
+    SDL_Texture *prev = SDL_GetRenderTarget(ren);
+    SDL_Texture *target = NULL;
+    if (SDL_RenderTargetSupported(ren))
+        target = SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888,
+                                   SDL_TEXTUREACCESS_TARGET, w, h);
+    SDL_SetRenderTarget(ren, target);
+
+    SDL_SetRenderDrawColor(ren, 0, 0, 0, 255);
+    SDL_RenderClear(ren);
+    draw_layers(R);
+    int ok = SDL_RenderReadPixels(ren, NULL, SDL_PIXELFORMAT_ARGB8888,
+                                  shot->pixels, shot->pitch);
+    if (ok == 0 && post_process_active(R->post))
+        post_process_apply(R->post, shot->pixels, w, h, shot->pitch, R->workers);
+
+    SDL_SetRenderTarget(ren, prev);
+    if (target) SDL_DestroyTexture(target);
+    R->stats = stats;
+    if (ok != 0) {
+        LOG_ERROR("Capture: read back failed: %s", SDL_GetError());
+        SDL_FreeSurface(shot);
+        return NULL;
     }
-    
-    // Clear the last layer and decrement count
-    R->layers[R->layer_count - 1].render_func = NULL;
-    R->layers[R->layer_count - 1].name[0] = '\0';
+    return shot;
+}
+
+SpriteBatch *renderer_sprites(RenderService *R) {
+    return R ? R->sprites : NULL;
+}
+
+GlyphCache *renderer_glyphs(RenderService *R) {
+    return R ? R->glyphs : NULL;
+}
+
+PostProcess *renderer_post(RenderService *R) {
+    return R ? R->post : NULL;
+}
+
+Camera *renderer_camera(RenderService *R) {
+    return R ? &R->camera : NULL;
+}
+
+bool renderer_cull_visible(RenderService *R, const SDL_FRect *bounds) {
+    if (!R || !bounds) return false;
+    bool visible = camera_visible(&R->camera, bounds);
+    if (visible) R->stats.items_drawn++;
+    else         R->stats.items_culled++;
+    return visible;
+}
+
+void renderer_count_items(RenderService *R, int drawn, int culled) {
+    if (!R) return;
+    R->stats.items_drawn += drawn;
+    R->stats.items_culled += culled;
+}
+
+const RenderStats *renderer_stats(const RenderService *R) {
+    return R ? &R->last_stats : NULL;
+}
+
+/* ─── layer registry ─── */
+
+#define LAYER_SLOT(id) ((id) & 0xFFFF)
+#define LAYER_GEN_MAX  0x7FFF
+
+static RenderLayer *layer_get(const RenderService *R, RenderLayerId id) {
+    if (!R || id < 0 || LAYER_SLOT(id) >= R->layer_high) return NULL;
+    RenderLayer *L = &R->layers[LAYER_SLOT(id)];
+    return L->live && L->id == id ? L : NULL;
+}
+
+static bool layer_before(const RenderLayer *a, const RenderLayer *b) {
+    return a->z < b->z || (a->z == b->z && a->seq < b->seq);
+}
+
+/* First position in |order| whose layer does not draw before |L| */
+static int order_search(const RenderService *R, const RenderLayer *L) {
+    int lo = 0, hi = R->layer_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (layer_before(&R->layers[R->order[mid]], L)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static void order_insert(RenderService *R, int slot) {
+    int at = order_search(R, &R->layers[slot]);
+    memmove(&R->order[at + 1], &R->order[at],
+            sizeof *R->order * (R->layer_count - at));
+    R->order[at] = slot;
+    R->layer_count++;
+}
+
+static void order_remove(RenderService *R, int slot) {
+    int at = order_search(R, &R->layers[slot]);
+    if (at >= R->layer_count || R->order[at] != slot) return;
+    memmove(&R->order[at], &R->order[at + 1],
+            sizeof *R->order * (R->layer_count - at - 1));
     R->layer_count--;
 }
 
-void renderer_remove_layer_name(RenderService *R, const char *name) {
-    for (int i = 0; i < R->layer_count; i++) {
-        if (strcmp(R->layers[i].name, name) == 0) {
-            renderer_remove_layer_index(R, i);
-            return;  // Only remove the first matching layer
+static RenderLayer *layer_new(RenderService *R, const char *name, int z) {
+    if (!R) return NULL;
+    int slot = R->free_slot;
+    if (slot >= 0) {
+        R->free_slot = R->layers[slot].next_free;
+    } else {
+        if (R->layer_high == 0x10000) {
+            LOG_ERROR("RenderService: out of layer slots");
+            return NULL;
         }
+        if (R->layer_high == R->layer_cap) {
+            /* layer_cap is the capacity both arrays have: it only moves
+               once each of them has grown */
+            int cap = R->layer_cap ? R->layer_cap * 2 : 16;
+            RenderLayer *layers = realloc(R->layers, sizeof *layers * cap);
+            if (layers) R->layers = layers;
+            int *order = layers ? realloc(R->order, sizeof *order * cap) : NULL;
+            if (order) R->order = order;
+            if (!layers || !order) {
+                LOG_ERROR("RenderService: out of memory for %d layers", cap);
+                return NULL;
+            }
+            R->layer_cap = cap;
+        }
+        slot = R->layer_high++;
+        R->layers[slot].generation = 0;
+    }
+
+    RenderLayer *L = &R->layers[slot];
+    Uint16 generation = L->generation;
+    memset(L, 0, sizeof *L);
+    L->generation = generation;
+    L->id = (RenderLayerId)((generation << 16) | slot);
+    L->z = z;
+    L->seq = R->next_seq++;
+    L->enabled = true;
+    L->live = true;
+    L->next_free = -1;
+    if (name) strncpy(L->name, name, sizeof L->name - 1);
+    order_insert(R, slot);
+    return L;
+}
+
+RenderLayerId renderer_insert_layer(RenderService *R,
+                                    RenderFunc     fn,
+                                    void          *userdata,
+                                    const char    *name,
+                                    int            z)
+{
+    if (!fn) return RENDER_LAYER_NONE;
+    RenderLayer *L = layer_new(R, name, z);
+    if (!L) return RENDER_LAYER_NONE;
+    L->render_func = fn;
+    L->userdata    = userdata;
+    return L->id;
+}
+
+RenderLayerId renderer_add_layer(RenderService *R,
+                                 RenderFunc     fn,
+                                 void          *userdata,
+                                 const char    *name)
+{
+    return renderer_insert_layer(R, fn, userdata, name, RENDER_Z_DEFAULT);
+}
+
+RenderLayerId renderer_add_retained_layer(RenderService *R,
+                                          RenderFunc     fn,
+                                          void          *userdata,
+                                          const char    *name,
+                                          DirtyRegion   *dirty)
+{
+    RenderLayer *L = layer_get(R, renderer_add_layer(R, fn, userdata, name));
+    if (!L) return RENDER_LAYER_NONE;
+    L->dirty = dirty;
+    dirty_region_invalidate(dirty);
+    return L->id;
+}
+
+RenderLayerId renderer_add_recorded_layer(RenderService *R,
+                                          RecordFunc     fn,
+                                          void          *userdata,
+                                          const char    *name)
+{
+    if (!R || !fn) return RENDER_LAYER_NONE;
+    RenderCommandList *commands = render_cmd_list_create();
+    if (!commands) return RENDER_LAYER_NONE;
+    RenderLayer *L = layer_new(R, name, RENDER_Z_DEFAULT);
+    if (!L) {
+        render_cmd_list_destroy(commands);
+        return RENDER_LAYER_NONE;
     }
+    L->record_func = fn;
+    L->commands    = commands;
+    L->userdata    = userdata;
+    return L->id;
+}
+
+bool renderer_remove_layer(RenderService *R, RenderLayerId id) {
+    RenderLayer *L = layer_get(R, id);
+    if (!L) return false;
+    int slot = LAYER_SLOT(id);
+    order_remove(R, slot);
+    layer_release(L);
+    L->live = false;
+    L->next_free = -1;
+    if (L->generation == LAYER_GEN_MAX)
+        return true;          /* retired: a new generation would wrap to an old id */
+    L->generation++;
+    L->next_free = R->free_slot;
+    R->free_slot = slot;
+    return true;
+}
+
+void renderer_remove_layer_name(RenderService *R, const char *name) {
+    // Only remove the bottom-most matching layer
+    renderer_remove_layer(R, renderer_find_layer(R, name));
 }
 
 void renderer_remove_all_layers(RenderService *R) {
     if (!R) return;
-    R->layer_count = 0;
-    memset(R->layers, 0, sizeof(R->layers));
+    while (R->layer_count > 0)
+        renderer_remove_layer(R, R->layers[R->order[0]].id);
 }
 
-bool renderer_insert_layer(RenderService *R, RenderFunc layer, const char *name, int position) {
-    if (!R || !layer || position < 0 || position > R->layer_count || R->layer_count >= MAX_RENDER_LAYERS) {
-        return false;
+RenderLayerId renderer_find_layer(const RenderService *R, const char *name) {
+    if (!R || !name) return RENDER_LAYER_NONE;
+    for (int i = 0; i < R->layer_count; i++) {
+        const RenderLayer *L = &R->layers[R->order[i]];
+        if (strcmp(L->name, name) == 0)
+            return L->id;
     }
+    return RENDER_LAYER_NONE;
+}
+
+bool renderer_layer_exists(const RenderService *R, RenderLayerId id) {
+    return layer_get(R, id) != NULL;
+}
+
+void renderer_set_layer_enabled(RenderService *R, RenderLayerId id, bool enabled) {
+    RenderLayer *L = layer_get(R, id);
+    if (L) L->enabled = enabled;
+}
+
+bool renderer_layer_enabled(const RenderService *R, RenderLayerId id) {
+    RenderLayer *L = layer_get(R, id);
+    return L && L->enabled;
+}
+
+void renderer_set_layer_z(RenderService *R, RenderLayerId id, int z) {
+    RenderLayer *L = layer_get(R, id);
+    if (!L) return;
+    order_remove(R, LAYER_SLOT(id));
+    L->z = z;
+    L->seq = R->next_seq++;
+    order_insert(R, LAYER_SLOT(id));
+}
+
+void renderer_set_layer_invalidate(RenderService *R, RenderLayerId id,
+                                   InvalidateFunc fn) {
+    RenderLayer *L = layer_get(R, id);
+    if (L) L->invalidate_func = fn;
+}
 
-    // Shift layers up to make space
-    for (int i = R->layer_count; i > position; i--) {
-        R->layers[i] = R->layers[i - 1];
+void renderer_invalidate_all(RenderService *R) {
+    if (!R) return;
+    for (int i = 0; i < R->layer_count; i++) {
+        RenderLayer *L = &R->layers[R->order[i]];
+        dirty_region_invalidate(L->dirty);
+        if (L->invalidate_func)
+            L->invalidate_func(L->userdata);
     }
+}
 
-    // Insert the new layer
-    R->layers[position].render_func = layer;
-    strncpy(R->layers[position].name, name, sizeof(R->layers[position].name) - 1);
-    R->layers[position].name[sizeof(R->layers[position].name) - 1] = '\0';
-    R->layer_count++;
-    
-    return true;
+void renderer_handle_event(RenderService *R, const SDL_Event *e) {
+    if (!R || !e) return;
+    if (e->type == SDL_RENDER_TARGETS_RESET || e->type == SDL_RENDER_DEVICE_RESET)
+        renderer_invalidate_all(R);
 }
@@ -3,21 +3,89 @@
 
 #include <SDL2/SDL.h>
 #include <stdbool.h>
+#include "sprite_batch.h"
+#include "dirty_region.h"
+#include "render_commands.h"
+#include "camera.h"
+#include "glyph_cache.h"
+#include "post_process.h"
+#include "../jobs/worker_pool.h"
 
-#define MAX_RENDER_LAYERS 32
+#define RENDER_LAYER_NONE (-1)
+#define RENDER_Z_DEFAULT  0
+
+/* Stable layer handle: stays valid until that layer is removed, and is
+   never handed out again for a different layer (a slot is retired rather
+   than reused once its 15-bit generation runs out) */
+typedef int RenderLayerId;
 
 typedef void (*RenderFunc)(SDL_Renderer *ren, void *userdata);
+/* Records draw commands without touching SDL; may run on a worker thread */
+typedef void (*RecordFunc)(RenderCommandList *out, void *userdata);
+/* Drops whatever the layer keeps in render targets of its own */
+typedef void (*InvalidateFunc)(void *userdata);
 
 typedef struct {
     RenderFunc render_func;
-    void      *userdata;      /* NEW */
+    void      *userdata;
     char       name[32];
+
+    /* retained layers only: drawn into |cache| and redrawn where |dirty| */
+    DirtyRegion *dirty;
+    SDL_Texture *cache;
+    int          cache_w, cache_h;
+
+    /* recorded layers only: filled by |record_func| each frame */
+    RecordFunc         record_func;
+    RenderCommandList *commands;
+
+    /* layers with render targets of their own (tilemap chunks) */
+    InvalidateFunc invalidate_func;
+
+    /* registry */
+    RenderLayerId id;
+    int           z;          /* lower draws first */
+    Uint32        seq;        /* orders layers of equal z, newest on top */
+    Uint16        generation; /* bumped when the slot is freed, 0..0x7FFF */
+    bool          enabled;
+    bool          live;
+    int           next_free;
 } RenderLayer;
+/* Per-frame counters; culling helpers below feed items_drawn/items_culled */
+typedef struct RenderStats {
+    int layers;
+    int items_drawn;
+    int items_culled;
+} RenderStats;
+
 typedef struct RenderService {
     SDL_Renderer *renderer;
     SDL_Window *window;
-    RenderLayer layers[MAX_RENDER_LAYERS];
+    RenderLayer *layers;    /* slots, indexed by the low bits of an id */
+    int layer_cap, layer_high;
+    int *order;             /* live slots sorted by (z, seq) */
     int layer_count;
+    int free_slot;
+    Uint32 next_seq;
+    SpriteBatch *sprites;   /* shared quad batch, flushed after each layer */
+    WorkerPool *workers;    /* the game's one pool: recorded layers, post-process
+                               bands, asset decodes and ECS systems */
+    WorkerBatch records;    /* recorded layers in flight */
+    RenderCommandList **record_lists; /* a run of adjacent recorded layers */
+    int record_lists_cap;
+    RenderCmdOrder record_order;      /* execution sort scratch */
+    GlyphCache *glyphs;     /* text for every layer and command list */
+    Camera camera;
+    bool camera_fit_output; /* keep the viewport at the output size */
+    RenderStats stats;      /* frame being drawn */
+    RenderStats last_stats; /* previous complete frame */
+
+    PostProcess *post;        /* CPU filters applied before presenting */
+    SDL_Texture *post_target; /* frame drawn here while filters are on */
+    SDL_Texture *post_frame;  /* filtered pixels, copied to the screen */
+    Uint32 *post_pixels;
+    int post_w, post_h;
+    bool post_bound;          /* post_target is the target this frame */
 } RenderService;
 
 // Core initialization and shutdown
@@ -28,14 +96,89 @@ void renderer_shutdown(RenderService *R);
 void renderer_begin_frame(RenderService *R);
 void renderer_present(RenderService *R);
 
-// Layer management
-int renderer_add_layer(RenderService *R,
-                       RenderFunc     fn,
-                       void          *userdata,
-                       const char    *name);
-void renderer_remove_layer_index(RenderService *R, int index);
+// Draw the current layers (and post-process chain) into an offscreen frame
+// and return it as an ARGB8888 surface, nothing presented. The caller frees
+// it with SDL_FreeSurface. NULL on failure. Works headless on a renderer
+// from SDL_CreateSoftwareRenderer; compare with image_diff_golden()
+SDL_Surface *renderer_capture(RenderService *R);
+
+// Quads queued here during a layer are drawn when that layer returns
+SpriteBatch *renderer_sprites(RenderService *R);
+
+// Glyph atlas shared by all text drawing
+GlyphCache *renderer_glyphs(RenderService *R);
+
+// Post-process chain; enabling any filter makes the frame render offscreen
+// and be read back, filtered on the CPU and uploaded before presenting
+PostProcess *renderer_post(RenderService *R);
+
+// World camera shared by the layers; its viewport follows the output size
+// until camera_fit_output is cleared
+Camera *renderer_camera(RenderService *R);
+
+// Culling: true if |bounds| (world space) is in view; counted in the stats
+bool renderer_cull_visible(RenderService *R, const SDL_FRect *bounds);
+// For layers that cull sprites in bulk (spatial queries)
+void renderer_count_items(RenderService *R, int drawn, int culled);
+const RenderStats *renderer_stats(const RenderService *R);
+
+// Layer management. Layers are drawn in ascending z; a new layer goes on
+// top of the existing layers with the same z.
+RenderLayerId renderer_add_layer(RenderService *R,
+                                 RenderFunc     fn,
+                                 void          *userdata,
+                                 const char    *name);
+RenderLayerId renderer_insert_layer(RenderService *R,
+                                    RenderFunc     fn,
+                                    void          *userdata,
+                                    const char    *name,
+                                    int            z);
+bool renderer_remove_layer(RenderService *R, RenderLayerId id);
 void renderer_remove_layer_name(RenderService *R, const char *name);
 void renderer_remove_all_layers(RenderService *R);
-bool renderer_insert_layer(RenderService *R, RenderFunc layer, const char *name, int position);
+
+RenderLayerId renderer_find_layer(const RenderService *R, const char *name);
+bool renderer_layer_exists(const RenderService *R, RenderLayerId id);
+
+// Disabled layers keep their state (and retained cache) but are skipped
+void renderer_set_layer_enabled(RenderService *R, RenderLayerId id, bool enabled);
+bool renderer_layer_enabled(const RenderService *R, RenderLayerId id);
+void renderer_set_layer_z(RenderService *R, RenderLayerId id, int z);
+
+/*
+ * Retained layers are drawn into an offscreen texture and only the areas
+ * marked in |dirty| are redrawn (clipped) before the texture is composited.
+ * The owner adds rectangles to |dirty| whenever its content changes; a
+ * clean layer costs a single copy per frame. The layer function must draw
+ * with clip-respecting calls (SDL_RenderFillRect rather than
+ * SDL_RenderClear) and must not rely on what was drawn below it.
+ */
+RenderLayerId renderer_add_retained_layer(RenderService *R,
+                                          RenderFunc     fn,
+                                          void          *userdata,
+                                          const char    *name,
+                                          DirtyRegion   *dirty);
+
+/*
+ * Recorded layers fill a command list instead of drawing. At present time
+ * every recorded layer is recorded in parallel on worker threads, then the
+ * lists are executed on the main thread in layer order. Adjacent recorded
+ * layers are executed together in one pass, so their quads batch across
+ * layers; an immediate layer between them splits the pass.
+ */
+RenderLayerId renderer_add_recorded_layer(RenderService *R,
+                                          RecordFunc     fn,
+                                          void          *userdata,
+                                          const char    *name);
+
+// Called with the layer's userdata by renderer_invalidate_all, for layers
+// that cache into render targets the service does not know about
+void renderer_set_layer_invalidate(RenderService *R, RenderLayerId id,
+                                   InvalidateFunc fn);
+
+// Redraw every retained layer in full and run every invalidate hook
+// (render targets lost, device reset)
+void renderer_invalidate_all(RenderService *R);
+void renderer_handle_event(RenderService *R, const SDL_Event *e);
 
 #endif // CONQUEST_RENDER_SERVICE_H
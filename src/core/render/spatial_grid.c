@@ -0,0 +1,282 @@
+#include "spatial_grid.h"
+#include "../../utils/log.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define GRID_MIN_CELLS 64          /* hash capacity, power of two */
+
+typedef struct GridItem {
+    SDL_FRect bounds;
+    void     *item;
+    int       cx0, cy0, cx1, cy1;  /* cells it is listed in */
+    Uint32    stamp;               /* last query that reported it */
+    int       next_free;           /* -1, or free-list link when removed */
+    bool      live;
+} GridItem;
+
+typedef struct GridCell {
+    int  cx, cy;
+    int *items;                    /* item handles */
+    int  count, cap;
+    bool used;
+} GridCell;
+
+struct SpatialGrid {
+    float     cell_size;
+    GridCell *cells;               /* open addressing on (cx, cy) */
+    int       cell_cap, cell_count;
+    GridItem *items;
+    int       item_cap, item_high, live;
+    int       free_head;
+    Uint32    stamp;
+};
+
+/* ─── cells ─── */
+
+static Uint32 cell_hash(int cx, int cy) {
+    return ((Uint32)cx * 73856093u) ^ ((Uint32)cy * 19349663u);
+}
+
+static GridCell *cell_find(SpatialGrid *g, int cx, int cy, bool create);
+
+static bool cells_grow(SpatialGrid *g) {
+    int old_cap = g->cell_cap;
+    GridCell *old = g->cells;
+    int cap = old_cap ? old_cap * 2 : GRID_MIN_CELLS;
+    GridCell *cells = calloc(cap, sizeof *cells);
+    if (!cells) return false;
+
+    g->cells = cells;
+    g->cell_cap = cap;
+    g->cell_count = 0;
+    for (int i = 0; i < old_cap; i++) {
+        if (!old[i].used) continue;
+        GridCell *c = cell_find(g, old[i].cx, old[i].cy, true);
+        c->items = old[i].items;
+        c->count = old[i].count;
+        c->cap = old[i].cap;
+    }
+    free(old);
+    return true;
+}
+
+static GridCell *cell_find(SpatialGrid *g, int cx, int cy, bool create) {
+    if (create && (g->cell_count + 1) * 10 > g->cell_cap * 7 && !cells_grow(g))
+        return NULL;
+    if (!g->cell_cap) return NULL;
+
+    Uint32 mask = g->cell_cap - 1, h = cell_hash(cx, cy) & mask;
+    while (g->cells[h].used) {
+        if (g->cells[h].cx == cx && g->cells[h].cy == cy)
+            return &g->cells[h];
+        h = (h + 1) & mask;
+    }
+    if (!create) return NULL;
+    GridCell *c = &g->cells[h];
+    c->used = true;
+    c->cx = cx;
+    c->cy = cy;
+    g->cell_count++;
+    return c;
+}
+
+static void cell_add(SpatialGrid *g, int cx, int cy, int handle) {
+    GridCell *c = cell_find(g, cx, cy, true);
+    if (!c) return;
+    if (c->count == c->cap) {
+        int cap = c->cap ? c->cap * 2 : 4;
+        int *items = realloc(c->items, sizeof *items * cap);
+        if (!items) return;
+        c->items = items;
+        c->cap = cap;
+    }
+    c->items[c->count++] = handle;
+}
+
+/* Free an empty cell and close the probe gap it leaves (backward shift),
+   so moving items do not leave a trail of dead cells behind them */
+static void cell_erase(SpatialGrid *g, GridCell *c) {
+    Uint32 mask = g->cell_cap - 1, hole = (Uint32)(c - g->cells), i = hole;
+    free(c->items);
+    for (;;) {
+        i = (i + 1) & mask;
+        GridCell *next = &g->cells[i];
+        if (!next->used) break;
+        Uint32 home = cell_hash(next->cx, next->cy) & mask;
+        /* stays put if its home slot lies cyclically in (hole, i] */
+        bool stays = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+        if (stays) continue;
+        g->cells[hole] = *next;
+        hole = i;
+    }
+    g->cells[hole] = (GridCell){0};
+    g->cell_count--;
+}
+
+static void cell_del(SpatialGrid *g, int cx, int cy, int handle) {
+    GridCell *c = cell_find(g, cx, cy, false);
+    if (!c) return;
+    for (int i = 0; i < c->count; i++) {
+        if (c->items[i] == handle) {
+            c->items[i] = c->items[--c->count];
+            if (c->count == 0) cell_erase(g, c);
+            return;
+        }
+    }
+}
+
+static void item_cells(const SpatialGrid *g, const SDL_FRect *b,
+                       int *cx0, int *cy0, int *cx1, int *cy1) {
+    *cx0 = (int)floorf(b->x / g->cell_size);
+    *cy0 = (int)floorf(b->y / g->cell_size);
+    *cx1 = (int)floorf((b->x + b->w) / g->cell_size);
+    *cy1 = (int)floorf((b->y + b->h) / g->cell_size);
+}
+
+static void item_link(SpatialGrid *g, int handle) {
+    GridItem *it = &g->items[handle];
+    for (int cy = it->cy0; cy <= it->cy1; cy++)
+        for (int cx = it->cx0; cx <= it->cx1; cx++)
+            cell_add(g, cx, cy, handle);
+}
+
+static void item_unlink(SpatialGrid *g, int handle) {
+    GridItem *it = &g->items[handle];
+    for (int cy = it->cy0; cy <= it->cy1; cy++)
+        for (int cx = it->cx0; cx <= it->cx1; cx++)
+            cell_del(g, cx, cy, handle);
+}
+
+/* ─── public ─── */
+
+SpatialGrid *spatial_grid_create(float cell_size) {
+    if (cell_size <= 0.f) return NULL;
+    SpatialGrid *g = calloc(1, sizeof *g);
+    if (!g) return NULL;
+    g->cell_size = cell_size;
+    g->free_head = -1;
+    return g;
+}
+
+void spatial_grid_destroy(SpatialGrid *g) {
+    if (!g) return;
+    for (int i = 0; i < g->cell_cap; i++)
+        free(g->cells[i].items);
+    free(g->cells);
+    free(g->items);
+    free(g);
+}
+
+int spatial_grid_insert(SpatialGrid *g, const SDL_FRect *bounds, void *item) {
+    if (!g || !bounds) return -1;
+
+    int handle = g->free_head;
+    if (handle >= 0) {
+        g->free_head = g->items[handle].next_free;
+    } else {
+        if (g->item_high == g->item_cap) {
+            int cap = g->item_cap ? g->item_cap * 2 : 64;
+            GridItem *items = realloc(g->items, sizeof *items * cap);
+            if (!items) {
+                LOG_ERROR("SpatialGrid: out of memory for %d items", cap);
+                return -1;
+            }
+            g->items = items;
+            g->item_cap = cap;
+        }
+        handle = g->item_high++;
+    }
+
+    GridItem *it = &g->items[handle];
+    it->bounds = *bounds;
+    it->item = item;
+    it->stamp = 0;
+    it->next_free = -1;
+    it->live = true;
+    item_cells(g, bounds, &it->cx0, &it->cy0, &it->cx1, &it->cy1);
+    item_link(g, handle);
+    g->live++;
+    return handle;
+}
+
+void spatial_grid_move(SpatialGrid *g, int handle, const SDL_FRect *bounds) {
+    if (!g || !bounds || handle < 0 || handle >= g->item_high || !g->items[handle].live)
+        return;
+    GridItem *it = &g->items[handle];
+    int cx0, cy0, cx1, cy1;
+    item_cells(g, bounds, &cx0, &cy0, &cx1, &cy1);
+    it->bounds = *bounds;
+    if (cx0 == it->cx0 && cy0 == it->cy0 && cx1 == it->cx1 && cy1 == it->cy1)
+        return;                               /* still in the same cells */
+    item_unlink(g, handle);
+    it->cx0 = cx0; it->cy0 = cy0; it->cx1 = cx1; it->cy1 = cy1;
+    item_link(g, handle);
+}
+
+void spatial_grid_remove(SpatialGrid *g, int handle) {
+    if (!g || handle < 0 || handle >= g->item_high || !g->items[handle].live)
+        return;
+    item_unlink(g, handle);
+    GridItem *it = &g->items[handle];
+    it->live = false;
+    it->item = NULL;
+    it->next_free = g->free_head;
+    g->free_head = handle;
+    g->live--;
+}
+
+int spatial_grid_count(const SpatialGrid *g) {
+    return g ? g->live : 0;
+}
+
+static bool rects_overlap(const SDL_FRect *a, const SDL_FRect *b) {
+    return a->x < b->x + b->w && b->x < a->x + a->w &&
+           a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+static void report(SpatialGrid *g, int handle, const SDL_FRect *area,
+                   void **out, int max, int *found) {
+    GridItem *it = &g->items[handle];
+    if (it->stamp == g->stamp) return;
+    it->stamp = g->stamp;
+    if (!rects_overlap(&it->bounds, area)) return;
+    if (*found < max) out[*found] = it->item;
+    (*found)++;
+}
+
+int spatial_grid_query(SpatialGrid *g, const SDL_FRect *area, void **out, int max) {
+    if (!g || !area || !g->live) return 0;
+    if (!out) max = 0;
+
+    if (++g->stamp == 0) {                    /* wrapped: forget old stamps */
+        for (int i = 0; i < g->item_high; i++) g->items[i].stamp = 0;
+        g->stamp = 1;
+    }
+
+    int cx0, cy0, cx1, cy1, found = 0;
+    item_cells(g, area, &cx0, &cy0, &cx1, &cy1);
+    double span = ((double)cx1 - cx0 + 1) * ((double)cy1 - cy0 + 1);
+
+    if (span > g->cell_count) {
+        /* zoomed far out: walking the occupied cells is cheaper */
+        for (int i = 0; i < g->cell_cap; i++) {
+            GridCell *c = &g->cells[i];
+            if (!c->used || c->cx < cx0 || c->cx > cx1 || c->cy < cy0 || c->cy > cy1)
+                continue;
+            for (int k = 0; k < c->count; k++)
+                report(g, c->items[k], area, out, max, &found);
+        }
+        return found;
+    }
+
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            GridCell *c = cell_find(g, cx, cy, false);
+            if (!c) continue;
+            for (int k = 0; k < c->count; k++)
+                report(g, c->items[k], area, out, max, &found);
+        }
+    }
+    return found;
+}
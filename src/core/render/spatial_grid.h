@@ -0,0 +1,30 @@
+#ifndef CONQUEST_SPATIAL_GRID_H
+#define CONQUEST_SPATIAL_GRID_H
+
+#include <SDL2/SDL.h>
+
+/*
+ * Uniform-grid spatial index over world-space rectangles. Layers keep their
+ * drawables here and query with camera_view() so only what intersects the
+ * view is submitted. Cells are hashed, so the world has no fixed extent,
+ * and a cell is freed once its last item leaves it.
+ *
+ * Handles are small integers, reused after spatial_grid_remove().
+ */
+typedef struct SpatialGrid SpatialGrid;
+
+SpatialGrid *spatial_grid_create(float cell_size);
+void         spatial_grid_destroy(SpatialGrid *grid);
+
+/* Returns a handle, or -1 on failure */
+int  spatial_grid_insert(SpatialGrid *grid, const SDL_FRect *bounds, void *item);
+void spatial_grid_move(SpatialGrid *grid, int handle, const SDL_FRect *bounds);
+void spatial_grid_remove(SpatialGrid *grid, int handle);
+int  spatial_grid_count(const SpatialGrid *grid);
+
+/* Items whose bounds intersect |area|, each once, in no particular order.
+   Writes at most |max| items and returns how many matched in total. */
+int  spatial_grid_query(SpatialGrid *grid, const SDL_FRect *area,
+                        void **out, int max);
+
+#endif // CONQUEST_SPATIAL_GRID_H
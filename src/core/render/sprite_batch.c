@@ -0,0 +1,240 @@
+#include "sprite_batch.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SB_MIN_QUADS      256
+#define SB_TEXTURE_SLOTS  1024   /* distinct textures sorted apart per flush */
+#define SB_SLOT_HASH      2048   /* open-addressed, power of two             */
+
+struct SpriteBatch {
+    SDL_Vertex   *verts;        /* 4 per quad, submission order */
+    SDL_Vertex   *sorted;       /* 4 per quad, draw order       */
+    SDL_Texture **textures;     /* per quad                     */
+    Uint64       *keys;         /* layer:16 slot:16 index:32    */
+    Uint64       *scratch;
+    int          *indices;      /* 6 per quad, same pattern for every run */
+    int           count;
+    int           capacity;
+    int           in_order;     /* keys already ascending – skip the sort */
+
+    /* texture → slot for the current frame */
+    SDL_Texture  *slot_tex[SB_SLOT_HASH];
+    Uint16        slot_id[SB_SLOT_HASH];
+    int           slot_count;
+
+    /* size of the last texture seen, for UVs */
+    SDL_Texture  *size_tex;
+    float         size_w, size_h;
+
+    SpriteBatchStats stats;
+};
+
+/* ─── storage ─── */
+
+static int sb_reserve(SpriteBatch *b, int quads) {
+    if (quads <= b->capacity) return 0;
+    int cap = b->capacity ? b->capacity : SB_MIN_QUADS;
+    while (cap < quads) cap *= 2;
+
+    SDL_Vertex *verts = realloc(b->verts, sizeof *verts * 4 * cap);
+    if (verts) b->verts = verts;
+    SDL_Vertex *sorted = realloc(b->sorted, sizeof *sorted * 4 * cap);
+    if (sorted) b->sorted = sorted;
+    SDL_Texture **tex = realloc(b->textures, sizeof *tex * cap);
+    if (tex) b->textures = tex;
+    Uint64 *keys = realloc(b->keys, sizeof *keys * cap);
+    if (keys) b->keys = keys;
+    Uint64 *scratch = realloc(b->scratch, sizeof *scratch * cap);
+    if (scratch) b->scratch = scratch;
+    int *idx = realloc(b->indices, sizeof *idx * 6 * cap);
+    if (idx) b->indices = idx;
+    if (!verts || !sorted || !tex || !keys || !scratch || !idx) {
+        LOG_ERROR("SpriteBatch: out of memory growing to %d quads", cap);
+        return -1;
+    }
+
+    for (int q = b->capacity; q < cap; q++) {
+        int v = q * 4, *i = &b->indices[q * 6];
+        i[0] = v; i[1] = v + 1; i[2] = v + 2;
+        i[3] = v; i[4] = v + 2; i[5] = v + 3;
+    }
+    b->capacity = cap;
+    return 0;
+}
+
+SpriteBatch *sprite_batch_create(int initial_quads) {
+    SpriteBatch *b = calloc(1, sizeof *b);
+    if (!b) return NULL;
+    if (sb_reserve(b, initial_quads > 0 ? initial_quads : SB_MIN_QUADS) < 0) {
+        sprite_batch_destroy(b);
+        return NULL;
+    }
+    b->in_order = 1;
+    return b;
+}
+
+void sprite_batch_destroy(SpriteBatch *b) {
+    if (!b) return;
+    free(b->verts);
+    free(b->sorted);
+    free(b->textures);
+    free(b->keys);
+    free(b->scratch);
+    free(b->indices);
+    free(b);
+}
+
+void sprite_batch_clear(SpriteBatch *b) {
+    if (!b) return;
+    b->count = 0;
+    b->in_order = 1;
+    b->size_tex = NULL;
+    if (b->slot_count) {
+        memset(b->slot_tex, 0, sizeof b->slot_tex);
+        b->slot_count = 0;
+    }
+}
+
+int sprite_batch_count(const SpriteBatch *b) {
+    return b ? b->count : 0;
+}
+
+SpriteBatchStats sprite_batch_stats(const SpriteBatch *b) {
+    SpriteBatchStats none = {0};
+    return b ? b->stats : none;
+}
+
+/* ─── queueing ─── */
+
+static Uint16 sb_texture_slot(SpriteBatch *b, SDL_Texture *tex) {
+    if (!tex) return 0;
+    Uint32 h = (Uint32)(((uintptr_t)tex >> 4) * 2654435761u) & (SB_SLOT_HASH - 1);
+    while (b->slot_tex[h]) {
+        if (b->slot_tex[h] == tex) return b->slot_id[h];
+        h = (h + 1) & (SB_SLOT_HASH - 1);
+    }
+    /* past the limit textures share the last slot: still correct, just
+       split into more draw calls */
+    if (b->slot_count == SB_TEXTURE_SLOTS)
+        return SB_TEXTURE_SLOTS;
+    b->slot_tex[h] = tex;
+    b->slot_id[h] = (Uint16)++b->slot_count;
+    return b->slot_id[h];
+}
+
+static SDL_Vertex *sb_push(SpriteBatch *b, SDL_Texture *tex, int layer) {
+    if (b->count == b->capacity && sb_reserve(b, b->count + 1) < 0)
+        return NULL;
+
+    if (layer < -32768) layer = -32768;
+    if (layer > 32767) layer = 32767;
+    Uint64 order = ((Uint64)(layer + 32768) << 16) | sb_texture_slot(b, tex);
+    Uint64 key = (order << 32) | (Uint32)b->count;
+    if (b->count && key < b->keys[b->count - 1])
+        b->in_order = 0;
+
+    b->keys[b->count] = key;
+    b->textures[b->count] = tex;
+    return &b->verts[4 * b->count++];
+}
+
+static void sb_quad(SDL_Vertex *v, const SDL_FRect *dst, SDL_Color c,
+                    float u0, float v0, float u1, float v1) {
+    float x0 = dst->x, y0 = dst->y, x1 = dst->x + dst->w, y1 = dst->y + dst->h;
+    v[0] = (SDL_Vertex){ { x0, y0 }, c, { u0, v0 } };
+    v[1] = (SDL_Vertex){ { x1, y0 }, c, { u1, v0 } };
+    v[2] = (SDL_Vertex){ { x1, y1 }, c, { u1, v1 } };
+    v[3] = (SDL_Vertex){ { x0, y1 }, c, { u0, v1 } };
+}
+
+void sprite_batch_draw(SpriteBatch *b, SDL_Texture *tex, const SDL_Rect *src,
+                       const SDL_FRect *dst, SDL_Color color, int layer) {
+    if (!b || !dst) return;
+    float u0 = 0.f, v0 = 0.f, u1 = 1.f, v1 = 1.f;
+    if (tex && src) {
+        if (tex != b->size_tex) {
+            int w = 0, h = 0;
+            if (SDL_QueryTexture(tex, NULL, NULL, &w, &h) != 0 || !w || !h) {
+                LOG_ERROR("SpriteBatch: bad texture: %s", SDL_GetError());
+                return;
+            }
+            b->size_tex = tex;
+            b->size_w = (float)w;
+            b->size_h = (float)h;
+        }
+        u0 = src->x / b->size_w;
+        v0 = src->y / b->size_h;
+        u1 = (src->x + src->w) / b->size_w;
+        v1 = (src->y + src->h) / b->size_h;
+    }
+    SDL_Vertex *v = sb_push(b, tex, layer);
+    if (v) sb_quad(v, dst, color, u0, v0, u1, v1);
+}
+
+void sprite_batch_fill(SpriteBatch *b, const SDL_FRect *dst,
+                       SDL_Color color, int layer) {
+    if (!b || !dst) return;
+    SDL_Vertex *v = sb_push(b, NULL, layer);
+    if (v) sb_quad(v, dst, color, 0.f, 0.f, 0.f, 0.f);
+}
+
+/* ─── flushing ─── */
+
+/* Stable LSD radix sort on the layer/slot half of the key; the submission
+   index in the low half rides along and keeps equal keys in order. */
+static void sb_sort(SpriteBatch *b) {
+    Uint64 *src = b->keys, *dst = b->scratch;
+    for (int shift = 32; shift < 64; shift += 8) {
+        int counts[257] = {0};
+        for (int i = 0; i < b->count; i++)
+            counts[((src[i] >> shift) & 0xFF) + 1]++;
+        if (counts[((src[0] >> shift) & 0xFF) + 1] == b->count)
+            continue;                       /* every key shares this digit */
+        for (int d = 0; d < 256; d++)
+            counts[d + 1] += counts[d];
+        for (int i = 0; i < b->count; i++)
+            dst[counts[(src[i] >> shift) & 0xFF]++] = src[i];
+        Uint64 *t = src; src = dst; dst = t;
+    }
+    b->keys = src;
+    b->scratch = dst;
+}
+
+int sprite_batch_flush(SpriteBatch *b, SDL_Renderer *ren) {
+    if (!b) return 0;
+    b->stats.quads = b->count;
+    b->stats.draw_calls = 0;
+    if (!b->count || !ren) {
+        sprite_batch_clear(b);
+        return 0;
+    }
+
+    const SDL_Vertex *verts = b->verts;
+    if (!b->in_order) {
+        sb_sort(b);
+        for (int i = 0; i < b->count; i++)
+            memcpy(&b->sorted[4 * i], &b->verts[4 * (Uint32)b->keys[i]],
+                   sizeof(SDL_Vertex) * 4);
+        verts = b->sorted;
+    }
+
+    /* one call per run of equal texture; the index pattern is relative to
+       the run's first vertex so it can be reused from the start */
+    int start = 0;
+    while (start < b->count) {
+        SDL_Texture *tex = b->textures[(Uint32)b->keys[start]];
+        int end = start + 1;
+        while (end < b->count && b->textures[(Uint32)b->keys[end]] == tex)
+            end++;
+        if (SDL_RenderGeometry(ren, tex, verts + 4 * start, 4 * (end - start),
+                               b->indices, 6 * (end - start)) != 0)
+            LOG_ERROR("SDL_RenderGeometry: %s", SDL_GetError());
+        b->stats.draw_calls++;
+        start = end;
+    }
+
+    int calls = b->stats.draw_calls;
+    sprite_batch_clear(b);
+    return calls;
+}
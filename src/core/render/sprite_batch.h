@@ -0,0 +1,46 @@
+#ifndef CONQUEST_SPRITE_BATCH_H
+#define CONQUEST_SPRITE_BATCH_H
+
+#include <SDL2/SDL.h>
+
+/*
+ * Quad batcher on top of SDL_RenderGeometry.
+ *
+ * Quads are queued with a layer number, then sprite_batch_flush() sorts them
+ * by (layer, texture) and submits each run of equal texture with a single
+ * SDL_RenderGeometry call.  Lower layers draw first; quads in the same layer
+ * and texture keep their submission order, but quads of different textures
+ * within one layer may be reordered – use separate layers where overlap
+ * between textures matters.
+ *
+ * A NULL texture draws an untextured, solid colour quad.
+ */
+typedef struct SpriteBatch SpriteBatch;
+
+typedef struct SpriteBatchStats {
+    int quads;        /* quads submitted by the last flush          */
+    int draw_calls;   /* SDL_RenderGeometry calls by the last flush */
+} SpriteBatchStats;
+
+SpriteBatch *sprite_batch_create(int initial_quads);
+void         sprite_batch_destroy(SpriteBatch *batch);
+
+/* Drop everything queued since the last flush */
+void sprite_batch_clear(SpriteBatch *batch);
+
+/* |src| NULL means the whole texture. |layer| is clamped to -32768..32767 */
+void sprite_batch_draw(SpriteBatch *batch, SDL_Texture *texture,
+                       const SDL_Rect *src, const SDL_FRect *dst,
+                       SDL_Color color, int layer);
+
+void sprite_batch_fill(SpriteBatch *batch, const SDL_FRect *dst,
+                       SDL_Color color, int layer);
+
+int  sprite_batch_count(const SpriteBatch *batch);
+
+/* Sort, submit and clear. Returns the number of draw calls issued */
+int  sprite_batch_flush(SpriteBatch *batch, SDL_Renderer *renderer);
+
+SpriteBatchStats sprite_batch_stats(const SpriteBatch *batch);
+
+#endif // CONQUEST_SPRITE_BATCH_H
@@ -0,0 +1,220 @@
+#include "tilemap.h"
+#include "../../utils/log.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ─── map data ─── */
+
+Tilemap *tilemap_create(int width, int height, int tile_size, AtlasRegion tileset) {
+    if (width <= 0 || height <= 0 || tile_size <= 0 || !tileset.texture) {
+        LOG_ERROR("Tilemap: invalid map %dx%d (tile %d)", width, height, tile_size);
+        return NULL;
+    }
+
+    Tilemap *map = calloc(1, sizeof *map);
+    if (!map) return NULL;
+    map->width = width;
+    map->height = height;
+    map->tile_size = tile_size;
+    map->tileset = tileset;
+    map->tileset_cols = tileset.rect.w / tile_size;
+    map->chunks_x = (width + TILEMAP_CHUNK_TILES - 1) / TILEMAP_CHUNK_TILES;
+    map->chunks_y = (height + TILEMAP_CHUNK_TILES - 1) / TILEMAP_CHUNK_TILES;
+    map->budget = TILEMAP_DEFAULT_BUDGET;
+    map->tiles = calloc((size_t)width * height, sizeof *map->tiles);
+    map->chunks = calloc((size_t)map->chunks_x * map->chunks_y, sizeof *map->chunks);
+    map->batch = sprite_batch_create(TILEMAP_CHUNK_TILES * TILEMAP_CHUNK_TILES);
+    if (!map->tiles || !map->chunks || !map->batch || map->tileset_cols <= 0) {
+        LOG_ERROR("Tilemap: could not create %dx%d map", width, height);
+        tilemap_destroy(map);
+        return NULL;
+    }
+    return map;
+}
+
+void tilemap_destroy(Tilemap *map) {
+    if (!map) return;
+    if (map->chunks) {
+        for (int i = 0; i < map->chunks_x * map->chunks_y; i++)
+            if (map->chunks[i].cache)
+                SDL_DestroyTexture(map->chunks[i].cache);
+        free(map->chunks);
+    }
+    sprite_batch_destroy(map->batch);
+    free(map->tiles);
+    free(map);
+}
+
+TileId tilemap_get(const Tilemap *map, int x, int y) {
+    if (!map || x < 0 || y < 0 || x >= map->width || y >= map->height)
+        return 0;
+    return map->tiles[(size_t)y * map->width + x];
+}
+
+void tilemap_set(Tilemap *map, int x, int y, TileId id) {
+    if (!map || x < 0 || y < 0 || x >= map->width || y >= map->height)
+        return;
+    TileId *t = &map->tiles[(size_t)y * map->width + x];
+    if (*t == id) return;
+    *t = id;
+    int cx = x / TILEMAP_CHUNK_TILES, cy = y / TILEMAP_CHUNK_TILES;
+    map->chunks[cy * map->chunks_x + cx].dirty = true;
+}
+
+void tilemap_invalidate(Tilemap *map) {
+    if (!map) return;
+    for (int i = 0; i < map->chunks_x * map->chunks_y; i++)
+        map->chunks[i].dirty = true;
+}
+
+void tilemap_set_cache_budget(Tilemap *map, int chunks) {
+    if (map && chunks >= 0)
+        map->budget = chunks;
+}
+
+/* ─── chunks ─── */
+
+static void chunk_tile_range(const Tilemap *map, int cx, int cy,
+                             int *x0, int *y0, int *x1, int *y1) {
+    *x0 = cx * TILEMAP_CHUNK_TILES;
+    *y0 = cy * TILEMAP_CHUNK_TILES;
+    *x1 = SDL_min(*x0 + TILEMAP_CHUNK_TILES, map->width);
+    *y1 = SDL_min(*y0 + TILEMAP_CHUNK_TILES, map->height);
+}
+
+/* Queue the chunk's tiles with the chunk's top-left tile at (ox, oy) */
+static void chunk_batch_tiles(Tilemap *map, int cx, int cy,
+                              float ox, float oy, float size) {
+    const SDL_Color white = {255, 255, 255, 255};
+    int x0, y0, x1, y1;
+    chunk_tile_range(map, cx, cy, &x0, &y0, &x1, &y1);
+    for (int y = y0; y < y1; y++) {
+        const TileId *row = &map->tiles[(size_t)y * map->width];
+        for (int x = x0; x < x1; x++) {
+            if (!row[x]) continue;
+            int idx = row[x] - 1;
+            SDL_Rect src = {
+                map->tileset.rect.x + (idx % map->tileset_cols) * map->tile_size,
+                map->tileset.rect.y + (idx / map->tileset_cols) * map->tile_size,
+                map->tile_size, map->tile_size
+            };
+            SDL_FRect dst = {ox + (x - x0) * size, oy + (y - y0) * size, size, size};
+            sprite_batch_draw(map->batch, map->tileset.texture, &src, &dst, white, 0);
+        }
+    }
+}
+
+/* Free the texture of the chunk seen longest ago that isn't on screen now */
+static bool chunk_evict(Tilemap *map) {
+    TileChunk *oldest = NULL;
+    for (int i = 0; i < map->chunks_x * map->chunks_y; i++) {
+        TileChunk *c = &map->chunks[i];
+        if (c->cache && c->last_frame != map->frame &&
+            (!oldest || c->last_frame < oldest->last_frame))
+            oldest = c;
+    }
+    if (!oldest) return false;
+    SDL_DestroyTexture(oldest->cache);
+    oldest->cache = NULL;
+    map->resident--;
+    return true;
+}
+
+static bool chunk_build(Tilemap *map, SDL_Renderer *ren, int cx, int cy) {
+    TileChunk *c = &map->chunks[cy * map->chunks_x + cx];
+    if (!c->cache) {
+        if (map->resident >= map->budget && !chunk_evict(map))
+            return false;
+        int x0, y0, x1, y1;
+        chunk_tile_range(map, cx, cy, &x0, &y0, &x1, &y1);
+        c->cache = SDL_CreateTexture(ren, SDL_PIXELFORMAT_RGBA8888,
+                                     SDL_TEXTUREACCESS_TARGET,
+                                     (x1 - x0) * map->tile_size,
+                                     (y1 - y0) * map->tile_size);
+        if (!c->cache) {
+            LOG_WARN("Tilemap: chunk texture failed: %s", SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureBlendMode(c->cache, SDL_BLENDMODE_BLEND);
+        map->resident++;
+    }
+
+    SDL_Texture *prev = SDL_GetRenderTarget(ren);
+    SDL_SetRenderTarget(ren, c->cache);
+    SDL_SetRenderDrawColor(ren, 0, 0, 0, 0);
+    SDL_RenderClear(ren);
+    chunk_batch_tiles(map, cx, cy, 0.f, 0.f, (float)map->tile_size);
+    sprite_batch_flush(map->batch, ren);
+    SDL_SetRenderTarget(ren, prev);
+
+    c->dirty = false;
+    map->stats.chunks_built++;
+    return true;
+}
+
+/* ─── drawing ─── */
+
+void tilemap_render(Tilemap *map, SDL_Renderer *ren, const Camera *cam) {
+    if (!map || !ren || !cam || cam->zoom <= 0.f) return;
+
+    SDL_FRect view = camera_view(cam);
+    SDL_Rect out = cam->viewport;
+    float cam_x = view.x, cam_y = view.y, zoom = cam->zoom;
+
+    map->frame++;
+    memset(&map->stats, 0, sizeof map->stats);
+
+    float chunk_px = (float)(TILEMAP_CHUNK_TILES * map->tile_size);
+    int cx0 = SDL_max(0, (int)floorf(cam_x / chunk_px));
+    int cy0 = SDL_max(0, (int)floorf(cam_y / chunk_px));
+    int cx1 = SDL_min(map->chunks_x - 1, (int)floorf((cam_x + view.w) / chunk_px));
+    int cy1 = SDL_min(map->chunks_y - 1, (int)floorf((cam_y + view.h) / chunk_px));
+
+    /* stamp every visible chunk before any build can evict one */
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            map->chunks[cy * map->chunks_x + cx].last_frame = map->frame;
+            map->stats.chunks_visible++;
+        }
+    }
+
+    /* build before drawing: a build flushes the batch into the chunk's target */
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            TileChunk *c = &map->chunks[cy * map->chunks_x + cx];
+            if ((!c->cache || c->dirty) &&
+                map->stats.chunks_built < TILEMAP_BUILDS_PER_FRAME)
+                chunk_build(map, ren, cx, cy);
+        }
+    }
+
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            TileChunk *c = &map->chunks[cy * map->chunks_x + cx];
+
+            /* snap both edges to whole pixels so neighbours never leave a seam */
+            int x0, y0, x1, y1;
+            chunk_tile_range(map, cx, cy, &x0, &y0, &x1, &y1);
+            float sx = floorf(out.x + (x0 * map->tile_size - cam_x) * zoom);
+            float sy = floorf(out.y + (y0 * map->tile_size - cam_y) * zoom);
+
+            if (!c->cache || c->dirty) {
+                /* drawn straight from the tileset until it gets its turn */
+                chunk_batch_tiles(map, cx, cy, sx, sy, map->tile_size * zoom);
+                map->stats.chunks_direct++;
+                continue;
+            }
+            SDL_FRect dst = {
+                sx, sy,
+                floorf(out.x + (x1 * map->tile_size - cam_x) * zoom) - sx,
+                floorf(out.y + (y1 * map->tile_size - cam_y) * zoom) - sy
+            };
+            SDL_RenderCopyF(ren, c->cache, NULL, &dst);
+            map->stats.chunks_cached++;
+        }
+    }
+    sprite_batch_flush(map->batch, ren);
+
+    map->stats.chunks_culled = map->chunks_x * map->chunks_y - map->stats.chunks_visible;
+}
@@ -0,0 +1,78 @@
+#ifndef CONQUEST_TILEMAP_H
+#define CONQUEST_TILEMAP_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "sprite_batch.h"
+#include "camera.h"
+#include "../resources/texture_atlas.h"
+
+/*
+ * Chunked tilemap renderer.
+ *
+ * The map is split into TILEMAP_CHUNK_TILES² chunks. A visible chunk is
+ * drawn once into its own render-target texture and composited with a
+ * single copy afterwards; changing a tile only marks its chunk for a
+ * rebuild. Chunk textures are created on demand and the least recently
+ * seen ones are recycled once the cache budget is used, so memory follows
+ * what is on screen, not the map size. Only a few chunks are (re)built per
+ * frame – the rest are drawn tile by tile through a sprite batch until
+ * their turn comes, so scrolling never hitches.
+ *
+ * Tile ids index the tileset left to right, top to bottom, starting at 1;
+ * id 0 is an empty tile.
+ */
+#define TILEMAP_CHUNK_TILES      32
+#define TILEMAP_BUILDS_PER_FRAME 4
+#define TILEMAP_DEFAULT_BUDGET   48   /* resident chunk textures */
+
+typedef Uint16 TileId;
+
+typedef struct TilemapStats {
+    int chunks_visible;
+    int chunks_cached;    /* composited from their texture       */
+    int chunks_built;     /* (re)rendered into their texture     */
+    int chunks_direct;    /* drawn tile by tile this frame       */
+    int chunks_culled;
+} TilemapStats;
+
+typedef struct TileChunk {
+    SDL_Texture *cache;
+    Uint32       last_frame;   /* frame the chunk was last visible */
+    bool         dirty;
+} TileChunk;
+
+typedef struct Tilemap {
+    int          width, height;      /* tiles  */
+    int          tile_size;          /* pixels */
+    TileId      *tiles;
+    AtlasRegion  tileset;
+    int          tileset_cols;
+
+    int          chunks_x, chunks_y;
+    TileChunk   *chunks;
+    int          resident, budget;
+    Uint32       frame;
+
+    SpriteBatch *batch;
+    TilemapStats stats;
+} Tilemap;
+
+/* |tileset| may be an atlas region; it is borrowed, not owned */
+Tilemap *tilemap_create(int width, int height, int tile_size, AtlasRegion tileset);
+void     tilemap_destroy(Tilemap *map);
+
+TileId   tilemap_get(const Tilemap *map, int x, int y);
+void     tilemap_set(Tilemap *map, int x, int y, TileId id);
+
+/* Rebuild every chunk, e.g. after the render targets were lost */
+void     tilemap_invalidate(Tilemap *map);
+
+/* Resident chunk textures kept at most (default TILEMAP_DEFAULT_BUDGET) */
+void     tilemap_set_cache_budget(Tilemap *map, int chunks);
+
+/* Draw the part of the map (world pixels, tile (0,0) at the origin) seen
+   by |cam| into its viewport */
+void     tilemap_render(Tilemap *map, SDL_Renderer *ren, const Camera *cam);
+
+#endif // CONQUEST_TILEMAP_H
@@ -0,0 +1,476 @@
+#include "hot_reload.h"
+#include "resource_paths.h"
+#include "texture_atlas.h"
+#include "../render/glyph_cache.h"
+#include "../../utils/log.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#define HOT_RELOAD_WAIT_MS 250        /* watcher wake-up / poll interval     */
+#define HOT_RELOAD_SETTLE_MS 100      /* let editors finish writing a file   */
+#define HOT_RELOAD_MAX_PER_FRAME 4    /* swaps applied per hot_reload_poll() */
+#define HOT_RELOAD_MAP_CAPACITY 256
+
+typedef enum { RELOAD_TEXTURE, RELOAD_CHUNK, RELOAD_FONT } ReloadKind;
+
+/* A decoded asset waiting for the main thread */
+typedef struct ReloadItem {
+    ReloadKind   kind;
+    char        *sub_path;
+    SDL_Surface *surface;          /* RELOAD_TEXTURE */
+    Mix_Chunk   *chunk;            /* RELOAD_CHUNK   */
+    void        *data;             /* RELOAD_FONT: raw file bytes */
+    size_t       size;
+    struct ReloadItem *next;
+} ReloadItem;
+
+typedef struct WatchedFile {
+    char  *sub_path;
+    char  *full_path;
+    time_t mtime;
+} WatchedFile;
+
+typedef struct WatchedDir {
+    int   wd;
+    char *prefix;                  /* sub path of the directory, "" or "x/" */
+} WatchedDir;
+
+/* Objects still referenced by callers after a swap; freed on stop */
+typedef struct Retired {
+    void  **items;
+    int     count, cap;
+} Retired;
+
+struct HotReload {
+    ResourceManager *resources;
+    SDL_Thread      *thread;
+    SDL_atomic_t     running;
+
+    WatchedFile     *files;
+    int              file_count, file_cap;
+    HashMap         *by_sub;       /* sub path → WatchedFile*           */
+    WatchedDir      *dirs;
+    int              dir_count, dir_cap;
+    int              inotify_fd;
+
+    SDL_mutex       *lock;         /* guards the ready queue            */
+    ReloadItem      *ready_head, *ready_tail;
+
+    Retired          old_textures, old_fonts;
+};
+
+/* ─── helpers ──────────────────────────────────────────────────────────── */
+static void retire(Retired *r, void *item) {
+    if (r->count == r->cap) {
+        int newcap = r->cap ? r->cap * 2 : 8;
+        void **tmp = realloc(r->items, newcap * sizeof *tmp);
+        if (!tmp) return;
+        r->items = tmp;
+        r->cap = newcap;
+    }
+    r->items[r->count++] = item;
+}
+
+static int starts_with(const char *s, const char *prefix) {
+    return strncmp(s, prefix, strlen(prefix)) == 0;
+}
+
+static time_t file_mtime(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? st.st_mtime : 0;
+}
+
+static void collect_file(const char *sub_path, const char *full_path, void *ud) {
+    HotReload *hr = ud;
+    if (hr->file_count == hr->file_cap) {
+        int newcap = hr->file_cap ? hr->file_cap * 2 : 64;
+        WatchedFile *tmp = realloc(hr->files, newcap * sizeof *tmp);
+        if (!tmp) return;
+        hr->files = tmp;
+        hr->file_cap = newcap;
+    }
+    hr->files[hr->file_count++] = (WatchedFile){
+        .sub_path = strdup(sub_path),
+        .full_path = strdup(full_path),
+        .mtime = 0,
+    };
+}
+
+static void queue_ready(HotReload *hr, ReloadItem *item) {
+    SDL_LockMutex(hr->lock);
+    if (hr->ready_tail) hr->ready_tail->next = item;
+    else hr->ready_head = item;
+    hr->ready_tail = item;
+    SDL_UnlockMutex(hr->lock);
+}
+
+static void free_item(ReloadItem *item) {
+    if (item->surface) SDL_FreeSurface(item->surface);
+    if (item->chunk) Mix_FreeChunk(item->chunk);
+    SDL_free(item->data);                  /* from SDL_LoadFile */
+    free(item->sub_path);
+    free(item);
+}
+
+/* ─── watcher thread: decode ───────────────────────────────────────────── */
+static void decode_changed(HotReload *hr, const char *sub_path) {
+    WatchedFile *wf = hashmap_get(hr->by_sub, sub_path);
+    if (!wf) return;                       /* temp/swap files, new files */
+
+    ReloadItem *item = calloc(1, sizeof *item);
+    item->sub_path = strdup(sub_path);
+
+    if (starts_with(sub_path, "images/")) {
+        item->kind = RELOAD_TEXTURE;
+        item->surface = IMG_Load(wf->full_path);
+    } else if (starts_with(sub_path, "audio/sfx/")) {
+        item->kind = RELOAD_CHUNK;
+        item->chunk = Mix_LoadWAV(wf->full_path);
+    } else if (starts_with(sub_path, "fonts/")) {
+        item->kind = RELOAD_FONT;
+        item->data = SDL_LoadFile(wf->full_path, &item->size);
+    } else {
+        LOG_DEBUG("Hot reload: no handler for %s", sub_path);
+        free_item(item);
+        return;
+    }
+
+    if (!item->surface && !item->chunk && !item->data) {
+        LOG_WARN("Hot reload: failed to decode %s: %s", sub_path, SDL_GetError());
+        free_item(item);
+        return;
+    }
+    LOG_INFO("Hot reload: decoded %s", sub_path);
+    queue_ready(hr, item);
+}
+
+/* ─── watcher thread: change detection ─────────────────────────────────── */
+typedef struct ChangeSet {
+    char *subs[64];
+    int   count;
+} ChangeSet;
+
+static void change_add(ChangeSet *cs, const char *sub_path) {
+    for (int i = 0; i < cs->count; i++)
+        if (strcmp(cs->subs[i], sub_path) == 0) return;
+    if (cs->count < (int)SDL_arraysize(cs->subs))
+        cs->subs[cs->count++] = strdup(sub_path);
+}
+
+#ifdef __linux__
+static int watch_dirs(HotReload *hr) {
+    hr->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (hr->inotify_fd < 0) return -1;
+
+    for (int i = 0; i < hr->file_count; i++) {
+        const WatchedFile *wf = &hr->files[i];
+        const char *slash = strrchr(wf->full_path, '/');
+        if (!slash) continue;
+
+        char dir[1024], prefix[1024];
+        snprintf(dir, sizeof dir, "%.*s", (int)(slash - wf->full_path), wf->full_path);
+        const char *sub_slash = strrchr(wf->sub_path, '/');
+        snprintf(prefix, sizeof prefix, "%.*s",
+                 sub_slash ? (int)(sub_slash - wf->sub_path + 1) : 0, wf->sub_path);
+
+        /* inotify hands back the same wd for a directory watched twice */
+        int wd = inotify_add_watch(hr->inotify_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd < 0) continue;
+        int known = 0;
+        for (int d = 0; d < hr->dir_count && !known; d++)
+            known = hr->dirs[d].wd == wd;
+        if (known) continue;
+
+        if (hr->dir_count == hr->dir_cap) {
+            int newcap = hr->dir_cap ? hr->dir_cap * 2 : 16;
+            WatchedDir *tmp = realloc(hr->dirs, newcap * sizeof *tmp);
+            if (!tmp) continue;
+            hr->dirs = tmp;
+            hr->dir_cap = newcap;
+        }
+        hr->dirs[hr->dir_count++] = (WatchedDir){ .wd = wd, .prefix = strdup(prefix) };
+    }
+    LOG_INFO("Hot reload: inotify watching %d directories", hr->dir_count);
+    return 0;
+}
+
+static void read_events(HotReload *hr, ChangeSet *cs) {
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t len;
+    while ((len = read(hr->inotify_fd, buf, sizeof buf)) > 0) {
+        for (char *p = buf; p < buf + len;) {
+            const struct inotify_event *ev = (const struct inotify_event *)p;
+            p += sizeof *ev + ev->len;
+            if (!ev->len) continue;
+            for (int d = 0; d < hr->dir_count; d++) {
+                if (hr->dirs[d].wd != ev->wd) continue;
+                char sub[1024];
+                snprintf(sub, sizeof sub, "%s%s", hr->dirs[d].prefix, ev->name);
+                change_add(cs, sub);
+                break;
+            }
+        }
+    }
+}
+
+static void wait_for_changes(HotReload *hr, ChangeSet *cs) {
+    struct pollfd pfd = { .fd = hr->inotify_fd, .events = POLLIN };
+    if (poll(&pfd, 1, HOT_RELOAD_WAIT_MS) <= 0) return;
+    read_events(hr, cs);
+    if (!cs->count) return;
+    SDL_Delay(HOT_RELOAD_SETTLE_MS);
+    read_events(hr, cs);                   /* coalesce follow-up writes */
+}
+#else
+static int watch_dirs(HotReload *hr) {
+    hr->inotify_fd = -1;
+    LOG_INFO("Hot reload: polling %d files", hr->file_count);
+    return 0;
+}
+
+static void wait_for_changes(HotReload *hr, ChangeSet *cs) {
+    SDL_Delay(HOT_RELOAD_WAIT_MS);
+    for (int i = 0; i < hr->file_count; i++) {
+        WatchedFile *wf = &hr->files[i];
+        time_t now = file_mtime(wf->full_path);
+        if (now && now != wf->mtime) {
+            wf->mtime = now;
+            change_add(cs, wf->sub_path);
+        }
+    }
+    if (cs->count) SDL_Delay(HOT_RELOAD_SETTLE_MS);
+}
+#endif
+
+static int watcher_main(void *userdata) {
+    HotReload *hr = userdata;
+    while (SDL_AtomicGet(&hr->running)) {
+        ChangeSet cs = { .count = 0 };
+        wait_for_changes(hr, &cs);
+        for (int i = 0; i < cs.count; i++) {
+            decode_changed(hr, cs.subs[i]);
+            free(cs.subs[i]);
+        }
+    }
+    return 0;
+}
+
+/* ─── main thread: swap into the cache ─────────────────────────────────── */
+static void swap_texture(HotReload *hr, ReloadItem *item, SDL_Renderer *renderer) {
+    ResourceManager *rm = hr->resources;
+    const char *name = item->sub_path + strlen("images/");
+    const char *full = get_resource_path(item->sub_path);
+    SDL_Surface *s = item->surface;
+
+    const AtlasRegion *region = atlas_find(rm->atlas, name);
+    if (region) {
+        if (region->rect.w == s->w && region->rect.h == s->h) {
+            Uint32 fmt;
+            SDL_QueryTexture(region->texture, &fmt, NULL, NULL, NULL);
+            SDL_Surface *conv = SDL_ConvertSurfaceFormat(s, fmt, 0);
+            if (conv) {
+                SDL_UpdateTexture(region->texture, &region->rect, conv->pixels, conv->pitch);
+                SDL_FreeSurface(conv);
+            }
+        } else {
+            LOG_WARN("Hot reload: %s changed size, atlas region kept (restart to repack)", name);
+        }
+    }
+
+    SDL_Texture *old = hashmap_get(rm->cache->textures, full);
+    if (old) {
+        int w, h;
+        Uint32 fmt;
+        SDL_QueryTexture(old, &fmt, NULL, &w, &h);
+        if (w == s->w && h == s->h) {
+            SDL_Surface *conv = SDL_ConvertSurfaceFormat(s, fmt, 0);
+            if (conv) {
+                SDL_UpdateTexture(old, NULL, conv->pixels, conv->pitch);
+                SDL_FreeSurface(conv);
+            }
+        } else {
+            SDL_Texture *fresh = SDL_CreateTextureFromSurface(renderer, s);
+            if (fresh) {
+                hashmap_put(rm->cache->textures, full, fresh);
+                retire(&hr->old_textures, old);
+            }
+        }
+    }
+
+    /* cursor-style surface users keep their own copies; refresh the cache */
+    SDL_Surface *old_surface = hashmap_get(rm->cache->surfaces, full);
+    if (old_surface) {
+        hashmap_put(rm->cache->surfaces, full, s);
+        item->surface = NULL;
+        SDL_FreeSurface(old_surface);
+    }
+}
+
+static void swap_chunk(HotReload *hr, ReloadItem *item) {
+    Mix_Chunk *old = hashmap_get(hr->resources->cache->sounds,
+                                 get_resource_path(item->sub_path));
+    if (!old) return;
+
+    /* stop voices still reading the old samples, then trade buffers */
+    int channels = Mix_AllocateChannels(-1);
+    for (int ch = 0; ch < channels; ch++)
+        if (Mix_Playing(ch) && Mix_GetChunk(ch) == old)
+            Mix_HaltChannel(ch);
+
+    Mix_Chunk *fresh = item->chunk;
+    fresh->volume = old->volume;
+    Mix_Chunk tmp = *old;
+    *old = *fresh;
+    *fresh = tmp;                  /* freed with the item below */
+}
+
+/* The memory a font reads from must outlive it, and the cache may close a
+   font long after hot reload stops: each reopened size gets its own copy
+   of the file, freed by its RWops when the font is closed (freesrc) */
+static int owned_mem_close(SDL_RWops *rw) {
+    SDL_free(rw->hidden.mem.base);
+    SDL_FreeRW(rw);
+    return 0;
+}
+
+static SDL_RWops *rw_from_copy(const void *data, size_t size) {
+    void *copy = SDL_malloc(size ? size : 1);
+    if (!copy) return NULL;
+    memcpy(copy, data, size);
+    SDL_RWops *rw = SDL_RWFromConstMem(copy, (int)size);
+    if (!rw) {
+        SDL_free(copy);
+        return NULL;
+    }
+    rw->close = owned_mem_close;
+    return rw;
+}
+
+static void swap_font(HotReload *hr, ReloadItem *item) {
+    HashMap *fonts = hr->resources->cache->fonts;
+    const char *full = get_resource_path(item->sub_path);
+    size_t full_len = strlen(full);
+
+    /* font keys are "<path>_<size>" – reopen every cached size */
+    for (int i = 0; i < fonts->capacity; i++) {
+        for (HashMapEntry *e = &fonts->entries[i]; e && e->key; e = e->next) {
+            if (strncmp(e->key, full, full_len) != 0 || e->key[full_len] != '_')
+                continue;
+            int size = atoi(e->key + full_len + 1);
+            SDL_RWops *rw = rw_from_copy(item->data, item->size);
+            TTF_Font *fresh = rw ? TTF_OpenFontRW(rw, 1, size) : NULL;
+            if (!fresh) {
+                LOG_WARN("Hot reload: reopening %s at %d failed: %s",
+                         item->sub_path, size, TTF_GetError());
+                continue;
+            }
+            retire(&hr->old_fonts, e->value);
+            e->value = fresh;
+        }
+    }
+}
+
+/* ─── public API ───────────────────────────────────────────────────────── */
+HotReload *hot_reload_start(ResourceManager *resources) {
+    if (!resources) return NULL;
+
+    HotReload *hr = calloc(1, sizeof *hr);
+    hr->resources = resources;
+    hr->lock = SDL_CreateMutex();
+    hr->by_sub = hashmap_create(HOT_RELOAD_MAP_CAPACITY);
+
+    resource_paths_foreach(NULL, collect_file, hr);
+    for (int i = 0; i < hr->file_count; i++) {
+        hr->files[i].mtime = file_mtime(hr->files[i].full_path);
+        hashmap_put(hr->by_sub, hr->files[i].sub_path, &hr->files[i]);
+    }
+
+    if (watch_dirs(hr) != 0) {
+        LOG_ERROR("Hot reload: could not set up file watching");
+        hot_reload_stop(hr);
+        return NULL;
+    }
+
+    SDL_AtomicSet(&hr->running, 1);
+    hr->thread = SDL_CreateThread(watcher_main, "hot_reload", hr);
+    if (!hr->thread) {
+        LOG_ERROR("Hot reload: SDL_CreateThread: %s", SDL_GetError());
+        SDL_AtomicSet(&hr->running, 0);
+        hot_reload_stop(hr);
+        return NULL;
+    }
+    LOG_INFO("Hot reload enabled for resources/");
+    return hr;
+}
+
+void hot_reload_poll(HotReload *hr, SDL_Renderer *renderer) {
+    if (!hr) return;
+
+    for (int n = 0; n < HOT_RELOAD_MAX_PER_FRAME; n++) {
+        SDL_LockMutex(hr->lock);
+        ReloadItem *item = hr->ready_head;
+        if (item) {
+            hr->ready_head = item->next;
+            if (!hr->ready_head) hr->ready_tail = NULL;
+        }
+        SDL_UnlockMutex(hr->lock);
+        if (!item) return;
+
+        switch (item->kind) {
+        case RELOAD_TEXTURE: swap_texture(hr, item, renderer); break;
+        case RELOAD_CHUNK:   swap_chunk(hr, item);             break;
+        case RELOAD_FONT:    swap_font(hr, item);              break;
+        }
+        LOG_INFO("Hot reload: swapped %s", item->sub_path);
+        free_item(item);
+    }
+}
+
+void hot_reload_stop(HotReload *hr) {
+    if (!hr) return;
+
+    SDL_AtomicSet(&hr->running, 0);
+    if (hr->thread) SDL_WaitThread(hr->thread, NULL);
+
+#ifdef __linux__
+    if (hr->inotify_fd >= 0) close(hr->inotify_fd);
+#endif
+
+    while (hr->ready_head) {
+        ReloadItem *next = hr->ready_head->next;
+        free_item(hr->ready_head);
+        hr->ready_head = next;
+    }
+
+    for (int i = 0; i < hr->old_textures.count; i++)
+        SDL_DestroyTexture(hr->old_textures.items[i]);
+    for (int i = 0; i < hr->old_fonts.count; i++) {
+        glyph_cache_forget_font(hr->resources->glyphs, hr->old_fonts.items[i]);
+        TTF_CloseFont(hr->old_fonts.items[i]);
+    }
+    free(hr->old_textures.items);
+    free(hr->old_fonts.items);
+
+    for (int i = 0; i < hr->file_count; i++) {
+        free(hr->files[i].sub_path);
+        free(hr->files[i].full_path);
+    }
+    free(hr->files);
+    for (int i = 0; i < hr->dir_count; i++)
+        free(hr->dirs[i].prefix);
+    free(hr->dirs);
+    hashmap_destroy(hr->by_sub);
+    SDL_DestroyMutex(hr->lock);
+    free(hr);
+}
@@ -0,0 +1,32 @@
+#ifndef CONQUEST_HOT_RELOAD_H
+#define CONQUEST_HOT_RELOAD_H
+
+#include "resource_manager.h"
+#include <SDL2/SDL.h>
+
+/*
+ * Developer hot reload for files under resources/.
+ *
+ * A watcher thread (inotify on Linux, mtime polling elsewhere) notices
+ * changed files and decodes them off the main thread.  hot_reload_poll()
+ * then swaps the result into the ResourceManager's cache on the main thread:
+ *
+ *   - textures / atlas regions of unchanged size are re-uploaded in place,
+ *     so every holder of the SDL_Texture* sees the new pixels next frame;
+ *   - sound effect chunks have their sample buffers swapped in place;
+ *   - fonts (opaque TTF_Font) and resized textures get a fresh object in
+ *     the cache; the old one is retired, not freed, so existing holders
+ *     stay valid and pick the change up on their next load_*() call.
+ */
+typedef struct HotReload HotReload;
+
+/* Start watching. Returns NULL if the watcher thread cannot be started */
+HotReload *hot_reload_start(ResourceManager *resources);
+
+/* Stop the watcher and free retired objects. Call before the renderer dies */
+void hot_reload_stop(HotReload *hr);
+
+/* Apply finished reloads (main thread, once per frame). Bounded per call */
+void hot_reload_poll(HotReload *hr, SDL_Renderer *renderer);
+
+#endif // CONQUEST_HOT_RELOAD_H
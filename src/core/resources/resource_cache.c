@@ -20,6 +20,7 @@ HashMap* hashmap_create(int capacity) {
 ResourceCache* resource_cache_create() {
     ResourceCache* cache = (ResourceCache*)malloc(sizeof(ResourceCache));
     cache->textures = hashmap_create(RESOURCE_CACHE_DEFAULT_CAPACITY);
+    cache->surfaces = hashmap_create(RESOURCE_CACHE_DEFAULT_CAPACITY);
     cache->fonts = hashmap_create(RESOURCE_CACHE_DEFAULT_CAPACITY);
     cache->sounds = hashmap_create(RESOURCE_CACHE_DEFAULT_CAPACITY);
     return cache;
@@ -185,6 +186,18 @@ void resource_cache_destroy(ResourceCache* cache) {
         }
     }
     
+    // Free all surfaces
+    for (int i = 0; i < cache->surfaces->capacity; i++) {
+        HashMapEntry* entry = &cache->surfaces->entries[i];
+        if (entry->key) {
+            for (HashMapEntry* current = entry; current; current = current->next) {
+                if (current->value) {
+                    SDL_FreeSurface((SDL_Surface*)current->value);
+                }
+            }
+        }
+    }
+    
     // Free all fonts
     for (int i = 0; i < cache->fonts->capacity; i++) {
         HashMapEntry* entry = &cache->fonts->entries[i];
@@ -213,6 +226,7 @@ void resource_cache_destroy(ResourceCache* cache) {
     
     // Destroy the hashmaps
     hashmap_destroy(cache->textures);
+    hashmap_destroy(cache->surfaces);
     hashmap_destroy(cache->fonts);
     hashmap_destroy(cache->sounds);
     
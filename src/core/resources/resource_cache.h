@@ -18,6 +18,7 @@ typedef struct HashMap {
 // ResourceCache
 typedef struct ResourceCache {
     HashMap* textures;
+    HashMap* surfaces;
     HashMap* fonts;
     HashMap* sounds;
 } ResourceCache;
@@ -0,0 +1,361 @@
+#include "resource_groups.h"
+#include "resource_paths.h"
+#include "../jobs/worker_pool.h"
+#include "../render/glyph_cache.h"
+#include "../../utils/log.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RESOURCE_GROUPS_CAPACITY 32
+#define RESOURCE_PRELOAD_PER_PUMP 8      /* main-thread finalisations/frame */
+
+typedef enum { ASSET_TEXTURE, ASSET_FONT, ASSET_SFX, ASSET_MUSIC } AssetKind;
+
+enum { ENTRY_QUEUED, ENTRY_DECODED, ENTRY_READY, ENTRY_FAILED };
+
+typedef struct GroupEntry {
+    AssetKind    kind;
+    char        *name;         /* sub path inside its category          */
+    const char  *path;         /* interned full path                    */
+    char        *key;          /* key in the ResourceCache map          */
+    int          size;         /* font point size                       */
+    SDL_atomic_t state;
+    SDL_Surface *surface;      /* decoded by a loader thread            */
+    Mix_Chunk   *chunk;
+    int          owned;        /* holds a group reference on |key|      */
+    struct AssetGroup *group;
+} GroupEntry;
+
+typedef struct AssetGroup {
+    char        *name;
+    GroupEntry  *entries;
+    int          count, cap;
+    WorkerBatch  decodes;      /* loader jobs not yet finished          */
+} AssetGroup;
+
+/* ─── helpers ──────────────────────────────────────────────────────────── */
+static HashMap *cache_map(ResourceManager *m, AssetKind kind) {
+    switch (kind) {
+    case ASSET_TEXTURE: return m->cache->textures;
+    case ASSET_FONT:    return m->cache->fonts;
+    default:            return m->cache->sounds;
+    }
+}
+
+static void free_asset(ResourceManager *m, AssetKind kind, void *asset) {
+    if (!asset) return;
+    switch (kind) {
+    case ASSET_TEXTURE: SDL_DestroyTexture(asset); break;
+    case ASSET_FONT:    /* a later font may reuse the address */
+                        glyph_cache_forget_font(m->glyphs, asset);
+                        TTF_CloseFont(asset);      break;
+    case ASSET_SFX:     Mix_FreeChunk(asset);      break;
+    case ASSET_MUSIC:   Mix_FreeMusic(asset);      break;
+    }
+}
+
+static intptr_t refs_get(ResourceManager *m, const char *key) {
+    return (intptr_t)hashmap_get(m->group_refs, key);
+}
+
+static void refs_set(ResourceManager *m, const char *key, intptr_t n) {
+    if (n > 0) hashmap_put(m->group_refs, key, (void *)n);
+    else hashmap_remove(m->group_refs, key);
+}
+
+/* Share an asset that is already cached. Assets cached outside any group,
+ * or pinned by an ad-hoc load_*() call since, are permanent and never
+ * become owned */
+static int entry_share_cached(ResourceManager *m, GroupEntry *e) {
+    if (!hashmap_get(cache_map(m, e->kind), e->key)) return 0;
+    intptr_t refs = refs_get(m, e->key);
+    if (refs > 0) {
+        refs_set(m, e->key, refs + 1);
+        e->owned = 1;
+    }
+    return 1;
+}
+
+/* Put a freshly loaded asset in the cache, or share a copy that won the race */
+static void entry_adopt(ResourceManager *m, GroupEntry *e, void *fresh) {
+    if (!fresh) {
+        SDL_AtomicSet(&e->state, ENTRY_FAILED);
+        return;
+    }
+    if (entry_share_cached(m, e)) {
+        free_asset(m, e->kind, fresh);
+    } else {
+        hashmap_put(cache_map(m, e->kind), e->key, fresh);
+        refs_set(m, e->key, 1);
+        e->owned = 1;
+    }
+    SDL_AtomicSet(&e->state, ENTRY_READY);
+}
+
+static AssetGroup *find_group(ResourceManager *m, const char *name) {
+    if (!m || !m->groups || !name) return NULL;
+    return hashmap_get(m->groups, name);
+}
+
+/* ─── loader thread ────────────────────────────────────────────────────── */
+static void decode_job(void *userdata) {
+    GroupEntry *e = userdata;
+    if (e->kind == ASSET_TEXTURE)
+        e->surface = IMG_Load(e->path);
+    else
+        e->chunk = Mix_LoadWAV(e->path);
+
+    if (!e->surface && !e->chunk)
+        LOG_WARN("Preload: failed to decode %s: %s", e->path, SDL_GetError());
+    SDL_AtomicSet(&e->state, (e->surface || e->chunk) ? ENTRY_DECODED : ENTRY_FAILED);
+}
+
+/* ─── manifest parsing ─────────────────────────────────────────────────── */
+static int parse_kind(const char *word, AssetKind *out) {
+    if (strcmp(word, "texture") == 0) *out = ASSET_TEXTURE;
+    else if (strcmp(word, "font") == 0) *out = ASSET_FONT;
+    else if (strcmp(word, "sfx") == 0) *out = ASSET_SFX;
+    else if (strcmp(word, "music") == 0) *out = ASSET_MUSIC;
+    else return 0;
+    return 1;
+}
+
+static void group_add_entry(AssetGroup *g, AssetKind kind, const char *name, int size) {
+    if (g->count == g->cap) {
+        int newcap = g->cap ? g->cap * 2 : 16;
+        GroupEntry *tmp = realloc(g->entries, newcap * sizeof *tmp);
+        if (!tmp) return;
+        g->entries = tmp;
+        g->cap = newcap;
+    }
+    GroupEntry *e = &g->entries[g->count++];
+    memset(e, 0, sizeof *e);
+    e->kind = kind;
+    e->name = strdup(name);
+    e->size = size;
+    e->group = g;
+
+    switch (kind) {
+    case ASSET_TEXTURE: e->path = get_image_path(name); break;
+    case ASSET_FONT:    e->path = get_font_path(name);  break;
+    case ASSET_SFX:     e->path = get_sfx_path(name);   break;
+    case ASSET_MUSIC:   e->path = get_music_path(name); break;
+    }
+
+    /* must match the keys used by load_*() in resource_manager.c */
+    char key[512];
+    if (kind == ASSET_FONT) snprintf(key, sizeof key, "%s_%d", e->path, size);
+    else snprintf(key, sizeof key, "%s", e->path);
+    e->key = strdup(key);
+}
+
+static AssetGroup *load_manifest(const char *group) {
+    char sub[256];
+    snprintf(sub, sizeof sub, "manifests/%s.manifest", group);
+    if (!resource_paths_exists(sub)) return NULL;
+
+    FILE *file = fopen(get_resource_path(sub), "r");
+    if (!file) return NULL;
+
+    AssetGroup *g = calloc(1, sizeof *g);
+    g->name = strdup(group);
+
+    char line[512];
+    int line_no = 0;
+    while (fgets(line, sizeof line, file)) {
+        line_no++;
+        char kind_word[32], name[256];
+        int size = 0;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') continue;
+        if (sscanf(line, "%31s %255s %d", kind_word, name, &size) < 2) continue;
+
+        AssetKind kind;
+        if (!parse_kind(kind_word, &kind)) {
+            LOG_WARN("%s:%d unknown asset kind '%s'", sub, line_no, kind_word);
+            continue;
+        }
+        if (kind == ASSET_FONT && size <= 0) {
+            LOG_WARN("%s:%d font %s needs a point size", sub, line_no, name);
+            continue;
+        }
+        group_add_entry(g, kind, name, size);
+    }
+    fclose(file);
+    return g;
+}
+
+/* ─── main-thread finalisation ─────────────────────────────────────────── */
+static int finalize_entry(ResourceManager *m, GroupEntry *e, SDL_Renderer *renderer) {
+    int state = SDL_AtomicGet(&e->state);
+
+    if (state == ENTRY_QUEUED && (e->kind == ASSET_FONT || e->kind == ASSET_MUSIC)) {
+        /* TTF and music streams are opened here, they only parse headers */
+        if (entry_share_cached(m, e)) {
+            SDL_AtomicSet(&e->state, ENTRY_READY);
+        } else if (e->kind == ASSET_FONT) {
+            TTF_Font *font = TTF_OpenFont(e->path, e->size);
+            if (!font) LOG_WARN("Preload: font %s: %s", e->path, TTF_GetError());
+            entry_adopt(m, e, font);
+        } else {
+            Mix_Music *music = Mix_LoadMUS(e->path);
+            if (!music) LOG_WARN("Preload: music %s: %s", e->path, Mix_GetError());
+            entry_adopt(m, e, music);
+        }
+        return 1;
+    }
+    if (state != ENTRY_DECODED) return 0;
+
+    if (e->kind == ASSET_TEXTURE) {
+        if (atlas_find(m->atlas, e->name) || entry_share_cached(m, e)) {
+            SDL_AtomicSet(&e->state, ENTRY_READY);  /* atlas is permanent */
+        } else {
+            entry_adopt(m, e, SDL_CreateTextureFromSurface(renderer, e->surface));
+        }
+        SDL_FreeSurface(e->surface);
+        e->surface = NULL;
+    } else {
+        entry_adopt(m, e, e->chunk);
+        e->chunk = NULL;
+    }
+    return 1;
+}
+
+static int pump_group(ResourceManager *m, AssetGroup *g, SDL_Renderer *renderer, int budget) {
+    for (int i = 0; i < g->count && budget > 0; i++)
+        budget -= finalize_entry(m, &g->entries[i], renderer);
+    return budget;
+}
+
+/* ─── public API ───────────────────────────────────────────────────────── */
+int resource_preload_group(ResourceManager *manager, const char *group) {
+    if (!manager || !group) return -1;
+    if (!manager->groups) {
+        manager->groups = hashmap_create(RESOURCE_GROUPS_CAPACITY);
+        manager->group_refs = hashmap_create(RESOURCE_GROUPS_CAPACITY * 16);
+    }
+    if (find_group(manager, group)) return 0;
+
+    AssetGroup *g = load_manifest(group);
+    if (!g) {
+        LOG_DEBUG("No preload manifest for group '%s'", group);
+        return -1;
+    }
+    hashmap_put(manager->groups, group, g);
+
+    int queued = 0;
+    for (int i = 0; i < g->count; i++) {
+        GroupEntry *e = &g->entries[i];
+        int in_atlas = e->kind == ASSET_TEXTURE && atlas_find(manager->atlas, e->name);
+        if (in_atlas || entry_share_cached(manager, e)) {
+            SDL_AtomicSet(&e->state, ENTRY_READY);
+        } else if (e->kind == ASSET_TEXTURE || e->kind == ASSET_SFX) {
+            if (worker_pool_submit_batch(manager->loader, &g->decodes, decode_job, e) != 0)
+                decode_job(e);   /* no threads: decode inline */
+            queued++;
+        }
+    }
+    LOG_INFO("Preloading group '%s': %d assets, %d decoding in background",
+             group, g->count, queued);
+    return 0;
+}
+
+void resource_preload_pump(ResourceManager *manager, SDL_Renderer *renderer) {
+    if (!manager || !manager->groups) return;
+
+    int budget = RESOURCE_PRELOAD_PER_PUMP;
+    HashMap *groups = manager->groups;
+    for (int i = 0; i < groups->capacity && budget > 0; i++)
+        for (HashMapEntry *he = &groups->entries[i]; he && he->key && budget > 0; he = he->next)
+            budget = pump_group(manager, he->value, renderer, budget);
+}
+
+void resource_preload_finish(ResourceManager *manager, const char *group,
+                             SDL_Renderer *renderer) {
+    AssetGroup *g = find_group(manager, group);
+    if (!g) return;
+
+    /* once every decode is in, one unbudgeted pass finishes the rest */
+    Uint32 start = SDL_GetTicks();
+    worker_pool_wait_batch(manager->loader, &g->decodes);
+    pump_group(manager, g, renderer, g->count);
+    LOG_DEBUG("Group '%s' finished after waiting %u ms", group,
+              (unsigned)(SDL_GetTicks() - start));
+}
+
+float resource_group_progress(ResourceManager *manager, const char *group) {
+    AssetGroup *g = find_group(manager, group);
+    if (!g || g->count == 0) return 1.0f;
+
+    int done = 0;
+    for (int i = 0; i < g->count; i++) {
+        int state = SDL_AtomicGet(&g->entries[i].state);
+        done += state == ENTRY_READY || state == ENTRY_FAILED;
+    }
+    return (float)done / (float)g->count;
+}
+
+int resource_group_ready(ResourceManager *manager, const char *group) {
+    return resource_group_progress(manager, group) >= 1.0f;
+}
+
+void resource_release_group(ResourceManager *manager, const char *group) {
+    AssetGroup *g = find_group(manager, group);
+    if (!g) return;
+
+    /* loader threads may still be writing into the entries */
+    worker_pool_wait_batch(manager->loader, &g->decodes);
+
+    int freed = 0;
+    for (int i = 0; i < g->count; i++) {
+        GroupEntry *e = &g->entries[i];
+        intptr_t refs = e->owned ? refs_get(manager, e->key) : 0;
+        if (refs > 0) {                    /* 0: pinned by a load_*() caller */
+            refs_set(manager, e->key, --refs);
+            if (refs == 0) {
+                HashMap *map = cache_map(manager, e->kind);
+                free_asset(manager, e->kind, hashmap_get(map, e->key));
+                hashmap_remove(map, e->key);
+                freed++;
+            }
+        }
+        if (e->surface) SDL_FreeSurface(e->surface);
+        if (e->chunk) Mix_FreeChunk(e->chunk);
+        free(e->name);
+        free(e->key);
+    }
+    LOG_INFO("Released group '%s' (%d assets freed)", group, freed);
+
+    hashmap_remove(manager->groups, group);
+    free(g->entries);
+    free(g->name);
+    free(g);
+}
+
+void resource_groups_pin(ResourceManager *manager, const char *key) {
+    if (manager && manager->group_refs) hashmap_remove(manager->group_refs, key);
+}
+
+void resource_groups_shutdown(ResourceManager *manager) {
+    if (!manager || !manager->groups) return;
+
+    HashMap *groups = manager->groups;
+    for (int i = 0; i < groups->capacity; i++) {
+        /* release rewrites the bucket, so restart it until empty */
+        while (groups->entries[i].key) {
+            char name[256];
+            snprintf(name, sizeof name, "%s", groups->entries[i].key);
+            resource_release_group(manager, name);
+        }
+    }
+    hashmap_destroy(manager->group_refs);
+    hashmap_destroy(manager->groups);
+    manager->loader = NULL;
+    manager->group_refs = NULL;
+    manager->groups = NULL;
+}
@@ -0,0 +1,55 @@
+#ifndef CONQUEST_RESOURCE_GROUPS_H
+#define CONQUEST_RESOURCE_GROUPS_H
+
+#include "resource_manager.h"
+#include <SDL2/SDL.h>
+
+/*
+ * Preload manifests and level-scoped asset groups.
+ *
+ * A group is described by resources/manifests/<group>.manifest, one asset
+ * per line:
+ *
+ *     # kind     sub path                  [font size]
+ *     texture    ui/cursor_normal_32.png
+ *     font       OpenSans-Regular.ttf      28
+ *     sfx        menu_select.wav
+ *     music      Music_2.mp3
+ *
+ * resource_preload_group() decodes images and sounds on the loader threads;
+ * resource_preload_pump() finishes them on the main thread (texture upload,
+ * font open) a few at a time so a background preload never stalls a frame.
+ * Assets are reference counted between groups, and resource_release_group()
+ * frees the ones no other group still holds.  Assets that were already in
+ * the cache before any group asked for them are never released, and neither
+ * are assets an ad-hoc load_*() call has been handed since (they are pinned).
+ *
+ * Decoding runs on the RenderService worker pool, borrowed through
+ * manager->loader; without one everything is decoded inline.
+ */
+
+/* Start (or join) a preload. Returns 0 on success, -1 if no manifest */
+int   resource_preload_group(ResourceManager *manager, const char *group);
+
+/* Finish decoded assets on the main thread. Call once per frame */
+void  resource_preload_pump(ResourceManager *manager, SDL_Renderer *renderer);
+
+/* Block until |group| is fully loaded (used when a state is entered early) */
+void  resource_preload_finish(ResourceManager *manager, const char *group,
+                              SDL_Renderer *renderer);
+
+/* 0..1 fraction of the group's assets that are ready; 1 for unknown groups */
+float resource_group_progress(ResourceManager *manager, const char *group);
+int   resource_group_ready(ResourceManager *manager, const char *group);
+
+/* Drop the group and every asset only it was holding */
+void  resource_release_group(ResourceManager *manager, const char *group);
+
+/* Make the cached asset under |key| permanent: load_*() callers keep the
+   pointer, so no group may free it any more */
+void  resource_groups_pin(ResourceManager *manager, const char *key);
+
+/* Release all groups (resource_manager_destroy); the loader pool is not ours */
+void  resource_groups_shutdown(ResourceManager *manager);
+
+#endif // CONQUEST_RESOURCE_GROUPS_H
@@ -1,6 +1,7 @@
 #include "resource_manager.h"
 #include "resource_cache.h"
 #include "resource_paths.h"
+#include "resource_groups.h"
 #include <stdio.h>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
@@ -10,10 +11,17 @@
 ResourceManager* resource_manager_create() {
     ResourceManager* manager = (ResourceManager*)malloc(sizeof(ResourceManager));
     manager->cache = resource_cache_create();
+    manager->atlas = NULL;
+    manager->groups = NULL;
+    manager->group_refs = NULL;
+    manager->loader = NULL;
+    manager->glyphs = NULL;
     return manager;
 }
 
 void resource_manager_destroy(ResourceManager* manager) {
+    resource_groups_shutdown(manager);
+    atlas_destroy(manager->atlas);
     resource_cache_destroy(manager->cache);
     free(manager);
 }
@@ -31,6 +39,7 @@ SDL_Texture* load_texture(ResourceManager* manager, const char* sub_path, SDL_Re
     // Check if texture is already in cache
     SDL_Texture* texture = hashmap_get(manager->cache->textures, path);
     if (texture != NULL) {
+        resource_groups_pin(manager, path);   // may have come from a group
         return texture;
     }
     
@@ -71,6 +80,7 @@ TTF_Font* load_font(ResourceManager* manager, const char* file_name, int size) {
     // Check if font is already in cache
     TTF_Font* font = hashmap_get(manager->cache->fonts, key);
     if (font != NULL) {
+        resource_groups_pin(manager, key);   // may have come from a group
         return font;
     }
     
@@ -95,9 +105,14 @@ Mix_Chunk* load_chunk(ResourceManager* manager, const char* sub_path) {
         return NULL;
     }
     
+    return load_chunk_file(manager, path);
+}
+
+Mix_Chunk* load_chunk_file(ResourceManager* manager, const char* path) {
     // Check if chunk is already in cache
     Mix_Chunk* chunk = hashmap_get(manager->cache->sounds, path);
     if (chunk != NULL) {
+        resource_groups_pin(manager, path);   // may have come from a group
         return chunk;
     }
     
@@ -125,6 +140,7 @@ Mix_Music* load_music(ResourceManager* manager, const char* sub_path) {
     // Check if music is already in cache
     Mix_Music* music = hashmap_get(manager->cache->sounds, path);
     if (music != NULL) {
+        resource_groups_pin(manager, path);   // may have come from a group
         return music;
     }
     
@@ -150,7 +166,7 @@ SDL_Surface* load_surface(ResourceManager* manager, const char* sub_path) {
     }
     
     // Check if surface is already in cache
-    SDL_Surface* surface = hashmap_get(manager->cache->textures, path);
+    SDL_Surface* surface = hashmap_get(manager->cache->surfaces, path);
     if (surface != NULL) {
         return surface;
     }
@@ -163,7 +179,40 @@ SDL_Surface* load_surface(ResourceManager* manager, const char* sub_path) {
     }
     
     // Store in cache
-    hashmap_put(manager->cache->textures, path, surface);
+    hashmap_put(manager->cache->surfaces, path, surface);
     
     return surface;
 }
+
+int resource_manager_build_atlas(ResourceManager* manager, SDL_Renderer* renderer) {
+    if (!manager || !renderer) return -1;
+    if (manager->atlas) return 0;
+
+    // Prefer an atlas baked offline by tools/bake_atlas.c
+    if (resource_paths_exists(ATLAS_BAKED_TABLE)) {
+        manager->atlas = atlas_load(get_resource_path(ATLAS_BAKED_TABLE), renderer);
+        if (manager->atlas) return 0;
+        SDL_Log("Baked atlas unusable, packing at runtime");
+    }
+
+    manager->atlas = atlas_create(ATLAS_DEFAULT_PAGE_SIZE, ATLAS_DEFAULT_PAGE_SIZE);
+    if (!manager->atlas) return -1;
+    atlas_add_images(manager->atlas, "", ATLAS_MAX_IMAGE);
+    return atlas_build(manager->atlas, renderer);
+}
+
+AtlasRegion load_texture_region(ResourceManager* manager, const char* sub_path, SDL_Renderer* renderer) {
+    const AtlasRegion* region = atlas_find(manager->atlas, sub_path);
+    if (region) {
+        return *region;
+    }
+
+    // Not packed (too large, or atlas not built): use a standalone texture
+    AtlasRegion whole = {0};
+    whole.page = -1;
+    whole.texture = load_texture(manager, sub_path, renderer);
+    if (whole.texture) {
+        SDL_QueryTexture(whole.texture, NULL, NULL, &whole.rect.w, &whole.rect.h);
+    }
+    return whole;
+}
@@ -1,6 +1,7 @@
 #ifndef RESOURCE_MANAGER_H
 #define RESOURCE_MANAGER_H
 #include "resource_cache.h"
+#include "texture_atlas.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
@@ -8,10 +9,17 @@
 
 // Forward declarations
 typedef struct ResourceCache ResourceCache;
+typedef struct WorkerPool WorkerPool;
+typedef struct GlyphCache GlyphCache;
 
 // Resource manager structure
 typedef struct ResourceManager {
     ResourceCache* cache;
+    TextureAtlas* atlas;   // packed UI/sprite images, NULL until built
+    HashMap* groups;       // preload groups by name (resource_groups.c)
+    HashMap* group_refs;   // cache key → number of groups holding it
+    WorkerPool* loader;    // background decode threads, borrowed from the render service
+    GlyphCache* glyphs;    // told about fonts before they close, borrowed likewise
 } ResourceManager;
 
 ResourceManager* resource_manager_create();
@@ -19,7 +27,15 @@ void resource_manager_destroy(ResourceManager* manager);
 SDL_Texture* load_texture(ResourceManager* manager, const char* sub_path, SDL_Renderer* renderer);
 TTF_Font* load_font(ResourceManager* manager, const char* file_name, int size);
 Mix_Chunk* load_chunk(ResourceManager* manager, const char* sub_path);
+Mix_Chunk* load_chunk_file(ResourceManager* manager, const char* path); // full path, e.g. from get_sfx_path
 Mix_Music* load_music(ResourceManager* manager, const char* sub_path);
 SDL_Surface* load_surface(ResourceManager* manager, const char* sub_path);
 
+// Pack images/ into atlas pages (or load the baked resources/atlas/images.atlas)
+int resource_manager_build_atlas(ResourceManager* manager, SDL_Renderer* renderer);
+
+// Atlas region for an image; falls back to a standalone cached texture
+// covering the whole image. texture is NULL on failure.
+AtlasRegion load_texture_region(ResourceManager* manager, const char* sub_path, SDL_Renderer* renderer);
+
 #endif
\ No newline at end of file
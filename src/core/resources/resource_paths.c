@@ -1,39 +1,225 @@
 #include "resource_paths.h"
+#include "resource_cache.h"
+#include "../../utils/log.h"
 #include <SDL2/SDL.h>
+#include <dirent.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define RESOURCE_PATHS_INDEX_CAPACITY 1024
+#define RESOURCE_PATHS_MAX_ROOTS 16
+#define RESOURCE_PATHS_MAX_LEN 1024
+
+/* ─── module state ─────────────────────────────────────────────────────── */
+static struct {
+    int        initialised;
+    char      *base;                               /* SDL_GetBasePath, once  */
+    char      *roots[RESOURCE_PATHS_MAX_ROOTS];    /* "<root>resources/"     */
+    int        root_count;
+    HashMap   *interned;   /* full path  → owned char*, lives until shutdown */
+    HashMap   *index;      /* "fonts/x"  → interned full path                */
+    HashMap   *misses;     /* lookups that matched no file on disk           */
+    SDL_mutex *lock;
+} g_paths;
+
+/* ─── helpers ──────────────────────────────────────────────────────────── */
+static const char *intern(const char *full) {
+    char *s = hashmap_get(g_paths.interned, full);
+    if (s) return s;
+    s = strdup(full);
+    hashmap_put(g_paths.interned, full, s);
+    return s;
+}
+
+static void free_interned(HashMap *map) {
+    for (int i = 0; i < map->capacity; i++) {
+        HashMapEntry *entry = &map->entries[i];
+        if (!entry->key) continue;
+        free(entry->value);
+        for (HashMapEntry *cur = entry->next; cur; cur = cur->next)
+            free(cur->value);
+    }
+}
+
+/* Walk |dir| recursively, registering every file as |rel|/name */
+static void index_dir(const char *dir, const char *rel) {
+    DIR *d = opendir(dir);
+    if (!d) return;
+
+    struct dirent *ent;
+    while ((ent = readdir(d)) != NULL) {
+        if (ent->d_name[0] == '.') continue;
+
+        char full[RESOURCE_PATHS_MAX_LEN], sub[RESOURCE_PATHS_MAX_LEN];
+        snprintf(full, sizeof full, "%s%s", dir, ent->d_name);
+        snprintf(sub, sizeof sub, "%s%s", rel, ent->d_name);
+
+        struct stat st;
+        if (stat(full, &st) != 0) continue;
+
+        if (S_ISDIR(st.st_mode)) {
+            strncat(full, "/", sizeof full - strlen(full) - 1);
+            strncat(sub, "/", sizeof sub - strlen(sub) - 1);
+            index_dir(full, sub);
+        } else {
+            /* later roots overwrite earlier ones → overlays win */
+            hashmap_put(g_paths.index, sub, (void *)intern(full));
+        }
+    }
+    closedir(d);
+}
+
+static void build_index_locked(void) {
+    if (g_paths.index) hashmap_destroy(g_paths.index);
+    if (g_paths.misses) hashmap_destroy(g_paths.misses);
+    g_paths.index = hashmap_create(RESOURCE_PATHS_INDEX_CAPACITY);
+    g_paths.misses = hashmap_create(RESOURCE_PATHS_INDEX_CAPACITY);
+    for (int i = 0; i < g_paths.root_count; i++)
+        index_dir(g_paths.roots[i], "");
+    LOG_DEBUG("Resource path index: %d files across %d root(s)",
+              g_paths.index->size, g_paths.root_count);
+}
+
+static char *make_root(const char *root) {
+    char buf[RESOURCE_PATHS_MAX_LEN];
+    int absolute = root[0] == '/' || root[0] == '\\' ||
+                   (root[0] && root[1] == ':');
+    size_t n = strlen(root);
+    const char *sep = (n && root[n - 1] != '/' && root[n - 1] != '\\') ? "/" : "";
+    snprintf(buf, sizeof buf, "%s%s%sresources/",
+             absolute ? "" : g_paths.base, root, sep);
+    return strdup(buf);
+}
+
+/* ─── public API ───────────────────────────────────────────────────────── */
+int resource_paths_init(void) {
+    if (g_paths.initialised) return 0;
 
-const char *get_font_path(const char *file) {
     char *base = SDL_GetBasePath();
-    static char buf[1024];
-    snprintf(buf, sizeof buf, "%sresources/fonts/%s", base ? base : "",
-             file);
+    g_paths.base = strdup(base ? base : "");
     SDL_free(base);
-    return buf;
+
+    g_paths.lock = SDL_CreateMutex();
+    g_paths.interned = hashmap_create(RESOURCE_PATHS_INDEX_CAPACITY);
+    g_paths.roots[0] = make_root("");
+    g_paths.root_count = 1;
+    g_paths.initialised = 1;
+
+    build_index_locked();
+    return 0;
+}
+
+void resource_paths_shutdown(void) {
+    if (!g_paths.initialised) return;
+
+    hashmap_destroy(g_paths.index);
+    hashmap_destroy(g_paths.misses);
+    free_interned(g_paths.interned);
+    hashmap_destroy(g_paths.interned);
+    for (int i = 0; i < g_paths.root_count; i++)
+        free(g_paths.roots[i]);
+    free(g_paths.base);
+    SDL_DestroyMutex(g_paths.lock);
+    memset(&g_paths, 0, sizeof g_paths);
+}
+
+int resource_paths_add_root(const char *root) {
+    if (!root) return -1;
+    resource_paths_init();
+    if (g_paths.root_count >= RESOURCE_PATHS_MAX_ROOTS) {
+        LOG_WARN("Too many resource roots – ignoring %s", root);
+        return -1;
+    }
+
+    SDL_LockMutex(g_paths.lock);
+    char *r = make_root(root);
+    g_paths.roots[g_paths.root_count++] = r;
+    index_dir(r, "");   /* overlay on top of the existing index */
+    SDL_UnlockMutex(g_paths.lock);
+
+    LOG_INFO("Added resource root %s", r);
+    return 0;
+}
+
+void resource_paths_rebuild_index(void) {
+    resource_paths_init();
+    SDL_LockMutex(g_paths.lock);
+    build_index_locked();
+    SDL_UnlockMutex(g_paths.lock);
+}
+
+const char *resource_paths_base(void) {
+    resource_paths_init();
+    return g_paths.base;
+}
+
+const char *get_resource_path(const char *sub_path) {
+    if (!sub_path) return NULL;
+    resource_paths_init();
+
+    SDL_LockMutex(g_paths.lock);
+    const char *path = hashmap_get(g_paths.index, sub_path);
+    if (!path) path = hashmap_get(g_paths.misses, sub_path);
+    if (!path) {
+        /* Not on disk (yet): hand out the base-root location so the loader
+           reports a sensible error, and remember it for next time */
+        char full[RESOURCE_PATHS_MAX_LEN];
+        snprintf(full, sizeof full, "%s%s", g_paths.roots[0], sub_path);
+        path = intern(full);
+        hashmap_put(g_paths.misses, sub_path, (void *)path);
+    }
+    SDL_UnlockMutex(g_paths.lock);
+    return path;
+}
+
+int resource_paths_exists(const char *sub_path) {
+    if (!sub_path) return 0;
+    resource_paths_init();
+    SDL_LockMutex(g_paths.lock);
+    int found = hashmap_get(g_paths.index, sub_path) != NULL;
+    SDL_UnlockMutex(g_paths.lock);
+    return found;
+}
+
+void resource_paths_foreach(const char *prefix, ResourcePathVisitor fn,
+                            void *userdata) {
+    if (!fn) return;
+    resource_paths_init();
+    size_t plen = prefix ? strlen(prefix) : 0;
+
+    SDL_LockMutex(g_paths.lock);
+    HashMap *map = g_paths.index;
+    for (int i = 0; i < map->capacity; i++) {
+        HashMapEntry *entry = &map->entries[i];
+        if (!entry->key) continue;
+        for (HashMapEntry *cur = entry; cur; cur = cur->next)
+            if (!plen || strncmp(cur->key, prefix, plen) == 0)
+                fn(cur->key, cur->value, userdata);
+    }
+    SDL_UnlockMutex(g_paths.lock);
+}
+
+static const char *get_category_path(const char *category, const char *file) {
+    if (!file) return NULL;
+    char sub[RESOURCE_PATHS_MAX_LEN];
+    snprintf(sub, sizeof sub, "%s%s", category, file);
+    return get_resource_path(sub);
+}
+
+const char *get_font_path(const char *file) {
+    return get_category_path("fonts/", file);
 }
 
 const char *get_music_path(const char *file) {
-    char *base = SDL_GetBasePath();
-    static char buf[1024];
-    snprintf(buf, sizeof buf, "%sresources/audio/music/%s", base ? base : "",
-             file);
-    SDL_free(base);
-    return buf;
+    return get_category_path("audio/music/", file);
 }
 
 const char *get_image_path(const char *file) {
-    char *base = SDL_GetBasePath();
-    static char buf[1024];
-    snprintf(buf, sizeof buf, "%sresources/images/%s", base ? base : "",
-             file);
-    SDL_free(base);
-    return buf;
+    return get_category_path("images/", file);
 }
 
 const char *get_sfx_path(const char *file) {
-    char *base = SDL_GetBasePath();
-    static char buf[1024];
-    snprintf(buf, sizeof buf, "%sresources/audio/sfx/%s", base ? base : "",
-             file);
-    SDL_free(base);
-    return buf;
-} 
\ No newline at end of file
+    return get_category_path("audio/sfx/", file);
+}
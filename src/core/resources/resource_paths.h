@@ -1,6 +1,48 @@
 #ifndef RESOURCE_PATHS_H
 #define RESOURCE_PATHS_H
 
+/*
+ * Resource path service.
+ *
+ * The executable's base directory is resolved once and every file under each
+ * search root's "resources/" folder is indexed up front.  Lookups are a single
+ * hash probe and return interned strings that stay valid until
+ * resource_paths_shutdown(), so callers may keep them around freely.
+ *
+ * Search roots are layered: the base directory is always the bottom layer and
+ * every root added with resource_paths_add_root() overlays the ones before it
+ * (e.g. mods/my_mod/ overriding a single texture).
+ */
+
+/* Resolve the base directory and build the lookup index. Safe to call twice */
+int resource_paths_init(void);
+
+/* Free the index and every interned path string */
+void resource_paths_shutdown(void);
+
+/* Add an overlay root (absolute, or relative to the base directory).
+ * Files under <root>/resources/ shadow earlier roots. Returns 0 on success */
+int resource_paths_add_root(const char *root);
+
+/* Re-scan all search roots (call after files were added on disk) */
+void resource_paths_rebuild_index(void);
+
+/* Cached executable base directory (always ends with a separator) */
+const char *resource_paths_base(void);
+
+/* Get the path to any resource, relative to "resources/" (e.g. "fonts/a.ttf") */
+const char *get_resource_path(const char *sub_path);
+
+/* 1 if |sub_path| names a file found under any search root */
+int resource_paths_exists(const char *sub_path);
+
+/* Visit every indexed file whose sub path starts with |prefix| (NULL = all).
+ * The visitor runs with the index locked and must not call back into here */
+typedef void (*ResourcePathVisitor)(const char *sub_path, const char *full_path,
+                                    void *userdata);
+void resource_paths_foreach(const char *prefix, ResourcePathVisitor fn,
+                            void *userdata);
+
 /* Get the path to a font resource */
 const char *get_font_path(const char *file);
 
@@ -13,4 +55,4 @@ const char *get_image_path(const char *file);
 /* Get the path to a sound effect resource */
 const char *get_sfx_path(const char *file);
 
-#endif /* RESOURCE_PATHS_H */ 
\ No newline at end of file
+#endif /* RESOURCE_PATHS_H */
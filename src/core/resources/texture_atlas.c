@@ -0,0 +1,393 @@
+#include "texture_atlas.h"
+#include "resource_paths.h"
+#include "../../utils/log.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ATLAS_LOOKUP_CAPACITY 256
+
+/* ─── skyline packer ───────────────────────────────────────────────────── */
+void skyline_init(SkylinePacker *p, int width, int height) {
+    p->width = width;
+    p->height = height;
+    p->nodes[0] = (SkylineNode){0, 0, width};
+    p->node_count = 1;
+}
+
+/* Lowest y at which a w×h rect starting at node |i| clears the skyline */
+static int skyline_fit(const SkylinePacker *p, int i, int w, int h, int *out_y) {
+    int x = p->nodes[i].x;
+    if (x + w > p->width) return 0;
+
+    int y = p->nodes[i].y, remaining = w;
+    while (remaining > 0) {
+        if (i >= p->node_count) return 0;
+        if (p->nodes[i].y > y) y = p->nodes[i].y;
+        if (y + h > p->height) return 0;
+        remaining -= p->nodes[i].w;
+        i++;
+    }
+    *out_y = y;
+    return 1;
+}
+
+static void skyline_remove(SkylinePacker *p, int i) {
+    memmove(&p->nodes[i], &p->nodes[i + 1],
+            (p->node_count - i - 1) * sizeof *p->nodes);
+    p->node_count--;
+}
+
+int skyline_pack(SkylinePacker *p, int w, int h, int *out_x, int *out_y) {
+    if (w <= 0 || h <= 0 || p->node_count >= ATLAS_MAX_SKYLINE) return 0;
+
+    int best = -1, best_top = INT_MAX, best_w = INT_MAX, best_y = 0;
+    for (int i = 0; i < p->node_count; i++) {
+        int y;
+        if (!skyline_fit(p, i, w, h, &y)) continue;
+        if (y + h < best_top || (y + h == best_top && p->nodes[i].w < best_w)) {
+            best = i;
+            best_top = y + h;
+            best_w = p->nodes[i].w;
+            best_y = y;
+        }
+    }
+    if (best < 0) return 0;
+
+    /* raise the skyline over the new rect */
+    int x = p->nodes[best].x;
+    memmove(&p->nodes[best + 1], &p->nodes[best],
+            (p->node_count - best) * sizeof *p->nodes);
+    p->nodes[best] = (SkylineNode){x, best_y + h, w};
+    p->node_count++;
+
+    /* trim the nodes it now covers */
+    for (int i = best + 1; i < p->node_count; i++) {
+        SkylineNode *prev = &p->nodes[i - 1];
+        int overlap = prev->x + prev->w - p->nodes[i].x;
+        if (overlap <= 0) break;
+        p->nodes[i].x += overlap;
+        p->nodes[i].w -= overlap;
+        if (p->nodes[i].w > 0) break;
+        skyline_remove(p, i--);
+    }
+
+    /* merge neighbours at the same height */
+    for (int i = 0; i < p->node_count - 1; i++) {
+        if (p->nodes[i].y == p->nodes[i + 1].y) {
+            p->nodes[i].w += p->nodes[i + 1].w;
+            skyline_remove(p, i + 1);
+            i--;
+        }
+    }
+
+    *out_x = x;
+    *out_y = best_y;
+    return 1;
+}
+
+/* ─── helpers ──────────────────────────────────────────────────────────── */
+static AtlasPage *atlas_new_page(TextureAtlas *atlas) {
+    AtlasPage *pages = realloc(atlas->pages,
+                               (atlas->page_count + 1) * sizeof *pages);
+    if (!pages) return NULL;
+    atlas->pages = pages;
+
+    AtlasPage *page = &atlas->pages[atlas->page_count];
+    memset(page, 0, sizeof *page);
+    page->surface = SDL_CreateRGBSurfaceWithFormat(0, atlas->page_w, atlas->page_h,
+                                                   32, SDL_PIXELFORMAT_RGBA32);
+    if (!page->surface) {
+        LOG_ERROR("Atlas page allocation failed: %s", SDL_GetError());
+        return NULL;
+    }
+    skyline_init(&page->packer, atlas->page_w, atlas->page_h);
+    atlas->page_count++;
+    return page;
+}
+
+static int pending_cmp(const void *a, const void *b) {
+    const AtlasPending *pa = a, *pb = b;
+    if (pa->surface->h != pb->surface->h) return pb->surface->h - pa->surface->h;
+    return pb->surface->w - pa->surface->w;
+}
+
+static void atlas_index_regions(TextureAtlas *atlas) {
+    if (atlas->lookup) hashmap_destroy(atlas->lookup);
+    atlas->lookup = hashmap_create(ATLAS_LOOKUP_CAPACITY);
+    for (int i = 0; i < atlas->region_count; i++)
+        hashmap_put(atlas->lookup, atlas->region_names[i], &atlas->regions[i]);
+}
+
+static int atlas_upload(TextureAtlas *atlas, SDL_Renderer *renderer) {
+    for (int i = 0; i < atlas->page_count; i++) {
+        AtlasPage *page = &atlas->pages[i];
+        page->texture = SDL_CreateTextureFromSurface(renderer, page->surface);
+        if (!page->texture) {
+            LOG_ERROR("Atlas page %d upload failed: %s", i, SDL_GetError());
+            return -1;
+        }
+        SDL_SetTextureBlendMode(page->texture, SDL_BLENDMODE_BLEND);
+        SDL_FreeSurface(page->surface);
+        page->surface = NULL;
+    }
+    for (int i = 0; i < atlas->region_count; i++)
+        atlas->regions[i].texture = atlas->pages[atlas->regions[i].page].texture;
+    return 0;
+}
+
+/* ─── public API ───────────────────────────────────────────────────────── */
+TextureAtlas *atlas_create(int page_w, int page_h) {
+    TextureAtlas *atlas = calloc(1, sizeof *atlas);
+    if (!atlas) return NULL;
+    atlas->page_w = page_w > 0 ? page_w : ATLAS_DEFAULT_PAGE_SIZE;
+    atlas->page_h = page_h > 0 ? page_h : ATLAS_DEFAULT_PAGE_SIZE;
+    return atlas;
+}
+
+void atlas_destroy(TextureAtlas *atlas) {
+    if (!atlas) return;
+    for (int i = 0; i < atlas->pending_count; i++) {
+        free(atlas->pending[i].name);
+        SDL_FreeSurface(atlas->pending[i].surface);
+    }
+    free(atlas->pending);
+    for (int i = 0; i < atlas->page_count; i++) {
+        if (atlas->pages[i].surface) SDL_FreeSurface(atlas->pages[i].surface);
+        if (atlas->pages[i].texture) SDL_DestroyTexture(atlas->pages[i].texture);
+    }
+    free(atlas->pages);
+    for (int i = 0; i < atlas->region_count; i++)
+        free(atlas->region_names[i]);
+    free(atlas->region_names);
+    free(atlas->regions);
+    if (atlas->lookup) hashmap_destroy(atlas->lookup);
+    free(atlas);
+}
+
+int atlas_add_surface(TextureAtlas *atlas, const char *name, SDL_Surface *surface) {
+    if (!atlas || !name || !surface) return -1;
+    if (atlas->region_count) {
+        LOG_WARN("Atlas already built – %s left out", name);
+        SDL_FreeSurface(surface);
+        return -1;
+    }
+    if (atlas->pending_count == atlas->pending_cap) {
+        int newcap = atlas->pending_cap ? atlas->pending_cap * 2 : 16;
+        AtlasPending *tmp = realloc(atlas->pending, newcap * sizeof *tmp);
+        if (!tmp) { SDL_FreeSurface(surface); return -1; }
+        atlas->pending = tmp;
+        atlas->pending_cap = newcap;
+    }
+    atlas->pending[atlas->pending_count++] =
+        (AtlasPending){ .name = strdup(name), .surface = surface };
+    return 0;
+}
+
+typedef struct {
+    char **subs;
+    int    count, cap;
+} PathList;
+
+static void collect_image(const char *sub_path, const char *full_path, void *ud) {
+    (void)full_path;
+    PathList *list = ud;
+    const char *ext = strrchr(sub_path, '.');
+    if (!ext || (SDL_strcasecmp(ext, ".png") && SDL_strcasecmp(ext, ".jpg") &&
+                 SDL_strcasecmp(ext, ".bmp")))
+        return;
+    if (list->count == list->cap) {
+        int newcap = list->cap ? list->cap * 2 : 32;
+        char **tmp = realloc(list->subs, newcap * sizeof *tmp);
+        if (!tmp) return;
+        list->subs = tmp;
+        list->cap = newcap;
+    }
+    list->subs[list->count++] = strdup(sub_path);
+}
+
+int atlas_add_images(TextureAtlas *atlas, const char *prefix, int max_dim) {
+    if (!atlas) return 0;
+    char filter[512];
+    snprintf(filter, sizeof filter, "images/%s", prefix ? prefix : "");
+
+    /* collect first: the visitor runs under the path index lock */
+    PathList list = {0};
+    resource_paths_foreach(filter, collect_image, &list);
+
+    int added = 0;
+    for (int i = 0; i < list.count; i++) {
+        const char *name = list.subs[i] + strlen("images/");
+        SDL_Surface *s = IMG_Load(get_resource_path(list.subs[i]));
+        if (!s) {
+            LOG_WARN("Atlas skipped %s: %s", name, IMG_GetError());
+        } else if (max_dim > 0 && (s->w > max_dim || s->h > max_dim)) {
+            SDL_FreeSurface(s);
+        } else if (atlas_add_surface(atlas, name, s) == 0) {
+            added++;
+        }
+        free(list.subs[i]);
+    }
+    free(list.subs);
+    return added;
+}
+
+int atlas_build(TextureAtlas *atlas, SDL_Renderer *renderer) {
+    if (!atlas || atlas->region_count) return -1;
+
+    qsort(atlas->pending, atlas->pending_count, sizeof *atlas->pending, pending_cmp);
+    free(atlas->regions);                 /* left by an earlier empty build */
+    free(atlas->region_names);
+    atlas->regions = calloc(atlas->pending_count ? atlas->pending_count : 1,
+                            sizeof *atlas->regions);
+    atlas->region_names = calloc(atlas->pending_count ? atlas->pending_count : 1,
+                                 sizeof *atlas->region_names);
+
+    for (int i = 0; i < atlas->pending_count; i++) {
+        AtlasPending *p = &atlas->pending[i];
+        int w = p->surface->w + 2 * ATLAS_PADDING;
+        int h = p->surface->h + 2 * ATLAS_PADDING;
+        int x = 0, y = 0, page = -1;
+
+        for (int j = 0; j < atlas->page_count && page < 0; j++)
+            if (skyline_pack(&atlas->pages[j].packer, w, h, &x, &y)) page = j;
+        if (page < 0 && w <= atlas->page_w && h <= atlas->page_h) {
+            AtlasPage *fresh = atlas_new_page(atlas);
+            if (fresh && skyline_pack(&fresh->packer, w, h, &x, &y))
+                page = atlas->page_count - 1;
+        }
+
+        if (page < 0) {
+            LOG_WARN("Atlas could not fit %s (%dx%d)", p->name,
+                     p->surface->w, p->surface->h);
+            free(p->name);
+        } else {
+            SDL_Rect dst = {x + ATLAS_PADDING, y + ATLAS_PADDING,
+                            p->surface->w, p->surface->h};
+            SDL_SetSurfaceBlendMode(p->surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(p->surface, NULL, atlas->pages[page].surface, &dst);
+
+            atlas->regions[atlas->region_count] =
+                (AtlasRegion){ .texture = NULL, .rect = dst, .page = page };
+            atlas->region_names[atlas->region_count++] = p->name;
+        }
+        SDL_FreeSurface(p->surface);
+    }
+    free(atlas->pending);
+    atlas->pending = NULL;
+    atlas->pending_count = atlas->pending_cap = 0;
+
+    atlas_index_regions(atlas);
+    LOG_INFO("Atlas packed %d region(s) into %d page(s)",
+             atlas->region_count, atlas->page_count);
+
+    return renderer ? atlas_upload(atlas, renderer) : 0;
+}
+
+const AtlasRegion *atlas_find(const TextureAtlas *atlas, const char *name) {
+    if (!atlas || !atlas->lookup || !name) return NULL;
+    return hashmap_get(atlas->lookup, name);
+}
+
+int atlas_save(const TextureAtlas *atlas, const char *dir, const char *stem) {
+    if (!atlas || !dir || !stem) return -1;
+
+    char path[1024];
+    snprintf(path, sizeof path, "%s/%s.atlas", dir, stem);
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        LOG_ERROR("Could not write atlas table %s", path);
+        return -1;
+    }
+
+    fprintf(file, "# Conquest texture atlas\n");
+    fprintf(file, "size %d %d\n", atlas->page_w, atlas->page_h);
+    for (int i = 0; i < atlas->page_count; i++) {
+        char page_file[256], page_path[1024];
+        snprintf(page_file, sizeof page_file, "%s_%d.png", stem, i);
+        snprintf(page_path, sizeof page_path, "%s/%s", dir, page_file);
+        if (!atlas->pages[i].surface || IMG_SavePNG(atlas->pages[i].surface, page_path) != 0) {
+            LOG_ERROR("Could not write atlas page %s", page_path);
+            fclose(file);
+            return -1;
+        }
+        fprintf(file, "page %d %s\n", i, page_file);
+    }
+    for (int i = 0; i < atlas->region_count; i++) {
+        const AtlasRegion *r = &atlas->regions[i];
+        fprintf(file, "region %d %d %d %d %d %s\n", r->page,
+                r->rect.x, r->rect.y, r->rect.w, r->rect.h, atlas->region_names[i]);
+    }
+
+    fclose(file);
+    return 0;
+}
+
+TextureAtlas *atlas_load(const char *table_path, SDL_Renderer *renderer) {
+    if (!table_path || !renderer) return NULL;
+
+    FILE *file = fopen(table_path, "r");
+    if (!file) return NULL;
+
+    /* page files live next to the table */
+    char dir[1024];
+    snprintf(dir, sizeof dir, "%s", table_path);
+    char *slash = strrchr(dir, '/');
+    if (slash) slash[1] = '\0'; else dir[0] = '\0';
+
+    TextureAtlas *atlas = atlas_create(0, 0);
+    char line[1024];
+    int region_cap = 0, ok = 1;
+
+    while (ok && fgets(line, sizeof line, file)) {
+        line[strcspn(line, "\r\n")] = '\0';   /* tables may have CRLF endings */
+        if (line[0] == '#' || line[0] == '\0') continue;
+
+        int page, x, y, w, h, n = 0;
+        char name[512];
+        if (sscanf(line, "size %d %d", &w, &h) == 2) {
+            atlas->page_w = w;
+            atlas->page_h = h;
+        } else if (sscanf(line, "page %d %511s", &page, name) == 2) {
+            char page_path[1536];
+            snprintf(page_path, sizeof page_path, "%s%s", dir, name);
+            AtlasPage *pages = realloc(atlas->pages, (atlas->page_count + 1) * sizeof *pages);
+            if (!pages) { ok = 0; break; }
+            atlas->pages = pages;
+            AtlasPage *pg = &atlas->pages[atlas->page_count++];
+            memset(pg, 0, sizeof *pg);
+            pg->surface = IMG_Load(page_path);
+            if (!pg->surface) {
+                LOG_ERROR("Failed to load atlas page %s: %s", page_path, IMG_GetError());
+                ok = 0;
+            }
+        } else if (sscanf(line, "region %d %d %d %d %d %n", &page, &x, &y, &w, &h, &n) == 5 && n > 0) {
+            if (page < 0 || page >= atlas->page_count) { ok = 0; break; }
+            if (atlas->region_count == region_cap) {
+                int newcap = region_cap ? region_cap * 2 : 64;
+                AtlasRegion *regions = realloc(atlas->regions, newcap * sizeof *regions);
+                if (regions) atlas->regions = regions;
+                char **names = realloc(atlas->region_names, newcap * sizeof *names);
+                if (names) atlas->region_names = names;
+                if (!regions || !names) { ok = 0; break; }
+                region_cap = newcap;
+            }
+            atlas->regions[atlas->region_count] =
+                (AtlasRegion){ .texture = NULL, .rect = {x, y, w, h}, .page = page };
+            atlas->region_names[atlas->region_count++] = strdup(line + n);
+        }
+    }
+    fclose(file);
+
+    if (!ok || atlas_upload(atlas, renderer) != 0) {
+        atlas_destroy(atlas);
+        return NULL;
+    }
+    atlas_index_regions(atlas);
+    LOG_INFO("Loaded atlas %s: %d region(s), %d page(s)",
+             table_path, atlas->region_count, atlas->page_count);
+    return atlas;
+}
@@ -0,0 +1,91 @@
+#ifndef CONQUEST_TEXTURE_ATLAS_H
+#define CONQUEST_TEXTURE_ATLAS_H
+
+#include "resource_cache.h"
+#include <SDL2/SDL.h>
+
+#define ATLAS_DEFAULT_PAGE_SIZE 2048
+#define ATLAS_PADDING 1             /* transparent gutter around each region */
+#define ATLAS_MAX_SKYLINE 512
+
+/* The game's atlas: baked by tools/bake_atlas.c as atlas/images_<n>.png plus
+   this table under resources/, or packed at startup when there is none */
+#define ATLAS_BAKED_TABLE "atlas/images.atlas"
+#define ATLAS_BAKED_STEM  "images"
+/* Larger images (backgrounds) stay standalone textures */
+#define ATLAS_MAX_IMAGE   512
+
+/* ─── Skyline rectangle packer (bottom-left heuristic) ─────────────────── */
+typedef struct SkylineNode {
+    int x, y, w;
+} SkylineNode;
+
+typedef struct SkylinePacker {
+    int         width, height;
+    SkylineNode nodes[ATLAS_MAX_SKYLINE];
+    int         node_count;
+} SkylinePacker;
+
+void skyline_init(SkylinePacker *p, int width, int height);
+/* Reserve a w×h slot. Returns 1 and writes the top-left corner, 0 if full */
+int  skyline_pack(SkylinePacker *p, int w, int h, int *out_x, int *out_y);
+
+/* ─── Texture atlas ────────────────────────────────────────────────────── */
+
+/* A sub-rectangle of one atlas page. |texture| is owned by the atlas */
+typedef struct AtlasRegion {
+    SDL_Texture *texture;
+    SDL_Rect     rect;
+    int          page;
+} AtlasRegion;
+
+typedef struct AtlasPage {
+    SDL_Surface  *surface;   /* CPU copy; kept only for offline builds */
+    SDL_Texture  *texture;
+    SkylinePacker packer;
+} AtlasPage;
+
+typedef struct AtlasPending {
+    char        *name;
+    SDL_Surface *surface;
+} AtlasPending;
+
+typedef struct TextureAtlas {
+    int           page_w, page_h;
+    AtlasPage    *pages;
+    int           page_count;
+    AtlasRegion  *regions;
+    char        **region_names;
+    int           region_count;
+    HashMap      *lookup;        /* name → AtlasRegion*                  */
+    AtlasPending *pending;       /* queued by atlas_add_*, packed on build */
+    int           pending_count, pending_cap;
+} TextureAtlas;
+
+/* life-cycle */
+TextureAtlas *atlas_create(int page_w, int page_h);
+void          atlas_destroy(TextureAtlas *atlas);
+
+/* Queue an image for packing. The atlas takes ownership of |surface| */
+int  atlas_add_surface(TextureAtlas *atlas, const char *name, SDL_Surface *surface);
+
+/* Queue every indexed image under resources/images/<prefix>. Images larger
+ * than |max_dim| in either direction (e.g. full-screen backgrounds) are left
+ * out so they stay standalone textures. Returns the number queued */
+int  atlas_add_images(TextureAtlas *atlas, const char *prefix, int max_dim);
+
+/* Pack everything queued into pages. With a renderer the pages are uploaded
+ * and the CPU copies dropped; with NULL (offline bake) the surfaces are kept
+ * so atlas_save() can write them out */
+int  atlas_build(TextureAtlas *atlas, SDL_Renderer *renderer);
+
+/* Region lookup by name (sub path under images/, e.g. "ui/cursor.png") */
+const AtlasRegion *atlas_find(const TextureAtlas *atlas, const char *name);
+
+/* Offline: write <dir>/<stem>_<n>.png pages plus a <dir>/<stem>.atlas table */
+int  atlas_save(const TextureAtlas *atlas, const char *dir, const char *stem);
+
+/* Load a table written by atlas_save() and upload its pages */
+TextureAtlas *atlas_load(const char *table_path, SDL_Renderer *renderer);
+
+#endif // CONQUEST_TEXTURE_ATLAS_H
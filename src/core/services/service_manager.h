@@ -11,7 +11,10 @@ typedef enum {
     EVENT_BUS_SERVICE,
     RESOURCE_MANAGER_SERVICE,
     CLOCK_SERVICE,
-    RENDER_SERVICE
+    RENDER_SERVICE,
+    HOT_RELOAD_SERVICE,
+    SIMULATION_SERVICE,
+    INSPECTOR_SERVICE
 } ServiceType;
 
 /* Opaque handle */
@@ -1,5 +1,6 @@
 #include "default_settings.h"
 #include "settings_manager.h"
+#include "../resources/resource_paths.h"
 #include <SDL2/SDL.h>
 #include <stdio.h>
 
@@ -11,6 +12,7 @@ void initialize_default_settings(SettingsManager *settings) {
     sm_register_category(settings, "audio", "Audio Settings");
     sm_register_category(settings, "controls", "Control Settings");
     sm_register_category(settings, "gameplay", "Gameplay Settings");
+    sm_register_category(settings, "developer", "Developer Settings");
     
     // Register video settings
     sm_register_bool_setting(settings, "video", "fullscreen", 
@@ -24,6 +26,10 @@ void initialize_default_settings(SettingsManager *settings) {
                            "Resolution Height", "Screen height in pixels", 
                            720, 600, 2160, 1, DISPLAY_TYPE_SLIDER);
     
+    sm_register_float_setting(settings, "video", "vignette",
+                             "Vignette", "Darken the screen corners (0 turns it off)",
+                             0.3f, 0.0f, 1.0f, 0.1f, DISPLAY_TYPE_SLIDER);
+    
     // Register audio settings
     sm_register_float_setting(settings, "audio", "master_volume", 
                              "Master Volume", "Main volume control", 
@@ -43,11 +49,13 @@ void initialize_default_settings(SettingsManager *settings) {
                             "Difficulty", "Game difficulty setting", 
                             1, difficulty_options, 4);
     
+    // Register developer settings
+    sm_register_bool_setting(settings, "developer", "hot_reload",
+                            "Hot Reload", "Reload changed files under resources/ while running", false);
+    
     // Load settings from file (if it exists)
-    char* base_path = SDL_GetBasePath();
     char settings_path[512];
-    snprintf(settings_path, sizeof(settings_path), "%ssettings.ini", base_path ? base_path : "");
-    SDL_free(base_path);
+    snprintf(settings_path, sizeof(settings_path), "%ssettings.ini", resource_paths_base());
     
     sm_load_settings(settings, settings_path);
 } 
\ No newline at end of file
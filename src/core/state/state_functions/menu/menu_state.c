@@ -9,11 +9,19 @@ static void menu_render_layer(SDL_Renderer *ren, void *ud)
 }
 
 
+/* registered on first entry, then only toggled */
+static RenderLayerId menu_layer = RENDER_LAYER_NONE;
+
 void menu_state_enter(void *user_data) {
     StateManager *sm = (StateManager *)user_data;
     RenderService *R = svc_get(sm->services, RENDER_SERVICE);
-    renderer_remove_all_layers(R);
-    renderer_add_layer(R, menu_render_layer, sm->menu, "menu");
+    if (!renderer_layer_exists(R, menu_layer))
+        menu_layer = renderer_add_retained_layer(R, menu_render_layer, sm->menu,
+                                                 "menu", &sm->menu->dirty);
+    renderer_set_layer_enabled(R, menu_layer, true);
+
+    /* the menu only leads into play – start streaming it in now */
+    sm_preload(sm, GS_PLAY);
 }
 
 void menu_state_update(void *user_data) {
@@ -21,5 +29,7 @@ void menu_state_update(void *user_data) {
 }
 
 void menu_state_exit(void *user_data) {
-    return;
+    StateManager *sm = (StateManager *)user_data;
+    RenderService *R = svc_get(sm->services, RENDER_SERVICE);
+    renderer_set_layer_enabled(R, menu_layer, false);
 }
\ No newline at end of file
@@ -2,6 +2,39 @@
 #include "../../state_manager.h"
 #include "../../../services/service_manager.h"
 #include "../../../render/render_service.h"
+#include "../../../render/spatial_grid.h"
+#include "../../../render/tilemap.h"
+#include "../../../clock/clock_service.h"
+#include "../../../../utils/log.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define PLAY_TILESET     "tiles/terrain.png"
+#define PLAY_TILE_SIZE   16
+#define PLAY_MAP_TILES   1024
+#define PLAY_PROP_COUNT  48000    /* same density the 256² map had with 3000 */
+#define PLAY_PAN_SPEED   600.0f   /* world pixels per second */
+
+/* terrain.png, ids counted from 1 */
+enum { TILE_GRASS = 1, TILE_GRASS_DARK, TILE_DIRT, TILE_SAND, TILE_WATER,
+       TILE_DEEP_WATER, TILE_STONE, TILE_SNOW, TILE_TREE, TILE_ROCK,
+       TILE_BUSH, TILE_FLOWERS };
+
+typedef struct Prop {
+    SDL_FRect bounds;     /* world pixels */
+    TileId    tile;
+} Prop;
+
+/* The terrain and the props standing on it, built on first entry */
+typedef struct PlayField {
+    RenderService *renderer;
+    Tilemap       *map;
+    SpatialGrid   *props;
+    Prop           prop_list[PLAY_PROP_COUNT];
+    int            prop_count;
+    int            props_shown;                /* by the last recording */
+    void          *visible[PLAY_PROP_COUNT];   /* query scratch */
+} PlayField;
 
 static void play_state_background(SDL_Renderer *ren, void *ud)
 {
@@ -10,17 +43,186 @@ static void play_state_background(SDL_Renderer *ren, void *ud)
     SDL_RenderClear(ren);
 }
 
+/* registered on first entry, then only toggled */
+static RenderLayerId background_layer = RENDER_LAYER_NONE;
+static RenderLayerId field_layer = RENDER_LAYER_NONE;
+static RenderLayerId props_layer = RENDER_LAYER_NONE;
+static PlayField *field;
+
+/* ─── play field ─── */
+
+/* Smooth value noise in 0..1, enough for coastlines and hills */
+static float terrain_noise(int x, int y)
+{
+    float h = 0.5f
+            + 0.25f * sinf(x * 0.041f + 1.3f) * cosf(y * 0.037f)
+            + 0.15f * sinf((x + y) * 0.093f)
+            + 0.10f * cosf(x * 0.17f - y * 0.13f);
+    return SDL_clamp(h, 0.0f, 1.0f);
+}
+
+static TileId terrain_tile(float h, int x, int y)
+{
+    if (h < 0.22f) return TILE_DEEP_WATER;
+    if (h < 0.34f) return TILE_WATER;
+    if (h < 0.39f) return TILE_SAND;
+    if (h < 0.62f) return ((x * 7 + y * 13) % 11) ? TILE_GRASS : TILE_DIRT;
+    if (h < 0.74f) return TILE_GRASS_DARK;
+    if (h < 0.86f) return TILE_STONE;
+    return TILE_SNOW;
+}
+
+static void field_generate(PlayField *f)
+{
+    for (int y = 0; y < PLAY_MAP_TILES; y++)
+        for (int x = 0; x < PLAY_MAP_TILES; x++)
+            tilemap_set(f->map, x, y, terrain_tile(terrain_noise(x, y), x, y));
+
+    /* props only stand on grass, so the grid gets dense and empty regions */
+    srand(0xC0FFEE);
+    for (int tries = 0; f->prop_count < PLAY_PROP_COUNT && tries < PLAY_PROP_COUNT * 8; tries++) {
+        int x = rand() % PLAY_MAP_TILES, y = rand() % PLAY_MAP_TILES;
+        TileId under = tilemap_get(f->map, x, y);
+        if (under != TILE_GRASS && under != TILE_GRASS_DARK) continue;
+
+        Prop *p = &f->prop_list[f->prop_count];
+        p->tile = under == TILE_GRASS_DARK ? TILE_TREE : (TileId)(TILE_ROCK + rand() % 3);
+        p->bounds = (SDL_FRect){(float)(x * PLAY_TILE_SIZE), (float)(y * PLAY_TILE_SIZE),
+                                PLAY_TILE_SIZE, PLAY_TILE_SIZE};
+        if (spatial_grid_insert(f->props, &p->bounds, p) < 0) break;
+        f->prop_count++;
+    }
+}
+
+static void play_field_render(SDL_Renderer *ren, void *ud)
+{
+    PlayField *f = ud;
+    RenderService *R = f->renderer;
+    const Camera *cam = renderer_camera(R);
+
+    tilemap_render(f->map, ren, cam);
+    /* items are sprites, so the props count and the chunks do not (they are
+       in f->map->stats); the props layer was recorded before any layer drew */
+    renderer_count_items(R, f->props_shown, f->prop_count - f->props_shown);
+}
+
+/* Chunk textures are render targets: lost with the device (D3D on Windows) */
+static void play_field_invalidate(void *ud)
+{
+    PlayField *f = ud;
+    tilemap_invalidate(f->map);
+}
+
+/* Props over the terrain, recorded as commands (possibly on a worker) */
+static void play_props_record(RenderCommandList *out, void *ud)
+{
+    PlayField *f = ud;
+    const Camera *cam = renderer_camera(f->renderer);
+
+    SDL_FRect view = camera_view(cam);
+    int shown = spatial_grid_query(f->props, &view, f->visible, PLAY_PROP_COUNT);
+    if (shown > PLAY_PROP_COUNT) shown = PLAY_PROP_COUNT;
+    const AtlasRegion *set = &f->map->tileset;
+    SDL_Color white = {255, 255, 255, 255};
+    for (int i = 0; i < shown; i++) {
+        const Prop *p = f->visible[i];
+        int idx = p->tile - 1;
+        SDL_Rect src = {
+            set->rect.x + (idx % f->map->tileset_cols) * PLAY_TILE_SIZE,
+            set->rect.y + (idx / f->map->tileset_cols) * PLAY_TILE_SIZE,
+            PLAY_TILE_SIZE, PLAY_TILE_SIZE
+        };
+        SDL_FRect dst = camera_to_screen(cam, &p->bounds);
+        render_cmd_sprite(out, set->texture, &src, &dst, white);
+    }
+    f->props_shown = shown;
+}
+
+static PlayField *field_create(StateManager *sm, RenderService *R)
+{
+    ResourceManager *rm = svc_get(sm->services, RESOURCE_MANAGER_SERVICE);
+    AtlasRegion tileset = load_texture_region(rm, PLAY_TILESET, R->renderer);
+    if (!tileset.texture) {
+        LOG_WARN("Play: no tileset %s, drawing the background only", PLAY_TILESET);
+        return NULL;
+    }
+
+    PlayField *f = calloc(1, sizeof *f);
+    if (!f) return NULL;
+    f->renderer = R;
+    f->map = tilemap_create(PLAY_MAP_TILES, PLAY_MAP_TILES, PLAY_TILE_SIZE, tileset);
+    f->props = spatial_grid_create(TILEMAP_CHUNK_TILES * PLAY_TILE_SIZE);
+    if (!f->map || !f->props) {
+        tilemap_destroy(f->map);
+        spatial_grid_destroy(f->props);
+        free(f);
+        return NULL;
+    }
+    field_generate(f);
+
+    Camera *cam = renderer_camera(R);
+    cam->x = cam->y = PLAY_MAP_TILES * PLAY_TILE_SIZE / 2.0f;
+    return f;
+}
+
+/* ─── state ─── */
+
 void play_state_enter(void *user_data) {
     StateManager *sm = (StateManager *)user_data;
     RenderService *R = svc_get(sm->services, RENDER_SERVICE);
-    renderer_remove_all_layers(R);
-    renderer_add_layer(R, play_state_background, NULL, "play_background");
+    if (!renderer_layer_exists(R, background_layer))
+        background_layer = renderer_add_layer(R, play_state_background, NULL,
+                                              "play_background");
+    renderer_set_layer_enabled(R, background_layer, true);
+
+    if (!field && (field = field_create(sm, R))) {
+        field_layer = renderer_add_layer(R, play_field_render, field, "play_field");
+        renderer_set_layer_invalidate(R, field_layer, play_field_invalidate);
+        props_layer = renderer_add_recorded_layer(R, play_props_record, field,
+                                                  "play_props");
+    }
+    if (field) {
+        renderer_set_layer_enabled(R, field_layer, true);
+        renderer_set_layer_enabled(R, props_layer, true);
+    }
 }
 
 void play_state_update(void *user_data) {
     return;
 }
 
+void play_state_handle_input(void *user_data, const InputManager *im) {
+    StateManager *sm = (StateManager *)user_data;
+    RenderService *R = svc_get(sm->services, RENDER_SERVICE);
+    ClockService *clock = svc_get(sm->services, CLOCK_SERVICE);
+    if (!field || !clock) return;
+
+    Camera *cam = renderer_camera(R);
+    float step = PLAY_PAN_SPEED * clock->delta_time / cam->zoom;
+    cam->x += step * (input_held(im, ACTION_MOVE_RIGHT) - input_held(im, ACTION_MOVE_LEFT));
+    cam->y += step * (input_held(im, ACTION_MOVE_DOWN) - input_held(im, ACTION_MOVE_UP));
+}
+
 void play_state_exit(void *user_data) {
-    return;
-}
\ No newline at end of file
+    StateManager *sm = (StateManager *)user_data;
+    RenderService *R = svc_get(sm->services, RENDER_SERVICE);
+    renderer_set_layer_enabled(R, background_layer, false);
+    if (field) {
+        renderer_set_layer_enabled(R, field_layer, false);
+        renderer_set_layer_enabled(R, props_layer, false);
+    }
+}
+
+void play_state_destroy(void *user_data) {
+    StateManager *sm = (StateManager *)user_data;
+    RenderService *R = sm->services ? svc_get(sm->services, RENDER_SERVICE) : NULL;
+    if (!field) return;
+    if (renderer_layer_exists(R, field_layer))
+        renderer_remove_layer(R, field_layer);
+    if (renderer_layer_exists(R, props_layer))
+        renderer_remove_layer(R, props_layer);
+    tilemap_destroy(field->map);
+    spatial_grid_destroy(field->props);
+    free(field);
+    field = NULL;
+}
@@ -1,3 +1,9 @@
+#include "../../../input/input_manager.h"
+
 void play_state_enter(void *user_data);
 void play_state_update(void *user_data);
-void play_state_exit(void *user_data);
\ No newline at end of file
+void play_state_exit(void *user_data);
+// Pan the camera over the play field with the move actions
+void play_state_handle_input(void *user_data, const InputManager *im);
+// Free the play field; call while the render service is still alive
+void play_state_destroy(void *user_data);
@@ -29,6 +29,14 @@ static StateVTable QUIT_VTABLE = {
   NULL
 };
 
+// Preload manifest (resources/manifests/<name>.manifest) per state
+static const char *STATE_ASSET_GROUPS[] = {
+  [GS_MENU]  = "menu",
+  [GS_PLAY]  = "play",
+  [GS_QUIT]  = NULL,
+  [GS_PAUSE] = NULL
+};
+
 
 // Function to create a StateVTable
 static StateVTable *create_state_vtable(void* enter, void* update, void* exit) {
@@ -43,7 +51,8 @@ static StateVTable *create_state_vtable(void* enter, void* update, void* exit) {
 void register_game_state(GameStates *states, StateVTable *vtable, enum GameState type, int index) {
     states->states[index] = (GameStateObject) {
         .vtable = vtable,
-        .type = type
+        .type = type,
+        .asset_group = STATE_ASSET_GROUPS[type]
     };
 }
 
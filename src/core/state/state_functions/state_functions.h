@@ -17,6 +17,7 @@ enum GameState { GS_MENU = 0, GS_PLAY = 1, GS_QUIT = 2, GS_PAUSE = 3 };
 typedef struct GameStateObject {
   StateVTable *vtable;
   enum GameState type;
+  const char *asset_group; /* preload manifest name, NULL if none */
 } GameStateObject;
 
 // Object holds array of GameStateObjects
@@ -7,6 +7,7 @@
 #include "../settings/settings_manager.h"
 #include "../resources/resource_paths.h"
 #include "../resources/resource_manager.h"
+#include "../resources/resource_groups.h"
 #include "../../utils/log.h"
 #include "../event/event_bus.h"
 #include "../event/event_signals.h"
@@ -71,7 +72,7 @@ static void sm_handle_menu_signals(const Event *e)
 /* ---------------------------------------------------------------------- */
 /*  Construction / destruction (unchanged)                                */
 /* ---------------------------------------------------------------------- */
-StateManager *sm_create(SDL_Renderer *ren, int w, int h,
+StateManager *sm_create(SDL_Renderer *ren, GlyphCache *glyphs, int w, int h,
                         ResourceManager *resources)
 {
     StateManager *sm = calloc(1, sizeof *sm);
@@ -79,7 +80,7 @@ StateManager *sm_create(SDL_Renderer *ren, int w, int h,
     // TODO: GS_PLAY is temp to make the game run
     // TODO: Get state object instead of type here
     sm->current_state = get_state_object(sm->states, GS_PLAY);
-    sm->menu   = menu_create(ren, w, h, NULL, resources);
+    sm->menu   = menu_create(ren, glyphs, w, h, NULL, resources);
     
     g_sm_instance = sm;
     return sm;
@@ -88,6 +89,11 @@ StateManager *sm_create(SDL_Renderer *ren, int w, int h,
 void sm_set_audio_manager(StateManager *sm, AudioManager *am)
 { if (sm && sm->menu) sm->menu->audio_manager = am; }
 
+static bool same_group(const char *a, const char *b)
+{
+    return a && b && strcmp(a, b) == 0;
+}
+
 /* ---------------------------------------------------------------------- */
 /*  Public state transition                                               */
 /* ---------------------------------------------------------------------- */
@@ -99,14 +105,48 @@ void sm_enter(StateManager *sm, enum GameState new_state)
         return; 
     }
     
+    GameStateObject *previous = sm->current_state;
+    StateVTable *previous_vtable = get_state_vtable(sm->states, previous->type);
+    if (previous_vtable && previous_vtable->exit)
+        previous_vtable->exit(sm);
     sm->current_state = get_state_object(sm->states, new_state);
 
     StateVTable *vtable = get_state_vtable(sm->states, new_state);
     if (!vtable) { LOG_ERROR("State_manager: Can't switch to state with no vtable"); return; }
 
+    /* Load the new state's group before it draws. If sm_preload() started
+       it earlier this only waits for what is left; otherwise the whole
+       group is loaded here, synchronously. */
+    ResourceManager *rm = svc_get(sm->services, RESOURCE_MANAGER_SERVICE);
+    RenderService   *R  = svc_get(sm->services, RENDER_SERVICE);
+    const char *next_group = sm->current_state->asset_group;
+    if (rm && R && next_group) {
+        resource_preload_group(rm, next_group);
+        resource_preload_finish(rm, next_group, R->renderer);
+    }
+
+    /* The group we leave stays resident: the state just left is the likeliest
+       next one (menu <-> play), so it is only released once a third group
+       is entered and takes its place. */
+    const char *left_group = previous->asset_group;
+    if (left_group && !same_group(left_group, next_group)) {
+        const char *evict = sm->resident_group;
+        if (rm && evict && !same_group(evict, next_group) && !same_group(evict, left_group))
+            resource_release_group(rm, evict);
+        sm->resident_group = left_group;
+    }
+
     vtable->enter(sm);
 }
 
+void sm_preload(StateManager *sm, enum GameState state)
+{
+    if (!sm) return;
+    ResourceManager *rm = svc_get(sm->services, RESOURCE_MANAGER_SERVICE);
+    const char *group = get_state_object(sm->states, state)->asset_group;
+    if (rm && group) resource_preload_group(rm, group);
+}
+
 /* ---------------------------------------------------------------------- */
 /*  Per-frame helpers (unchanged)                                         */
 /* ---------------------------------------------------------------------- */
@@ -115,14 +155,18 @@ void sm_handle_input(StateManager *sm, const InputManager *im)
     if (sm->current_state->type == GS_MENU)
         menu_handle_input(sm->menu, im);
 
-    if (sm->current_state->type == GS_PLAY && input_pressed(im, ACTION_CANCEL))
-        sm_enter(sm, GS_MENU);
+    if (sm->current_state->type == GS_PLAY) {
+        play_state_handle_input(sm, im);
+        if (input_pressed(im, ACTION_CANCEL))
+            sm_enter(sm, GS_MENU);
+    }
 }
 
 void sm_destroy(StateManager *sm)
 {
     if (!sm) return;
     if (g_sm_instance == sm) g_sm_instance = NULL;
+    play_state_destroy(sm);
     menu_destroy(sm->menu);
     free(sm);
 }
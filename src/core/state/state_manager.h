@@ -18,9 +18,10 @@ typedef struct StateManager {
   ServiceManager *services;
   GameStates *states;
   GameStateObject *current_state;
+  const char *resident_group; /* asset group of the state left last, kept loaded */
 } StateManager;
 
-StateManager *sm_create(SDL_Renderer *ren, int w, int h, ResourceManager *resource_manager);
+StateManager *sm_create(SDL_Renderer *ren, GlyphCache *glyphs, int w, int h, ResourceManager *resource_manager);
 void sm_destroy(StateManager *sm);
 
 struct InputManager;                       /* forward-declare */
@@ -42,4 +43,7 @@ void sm_set_services(StateManager *sm, ServiceManager *services);
 // State transition function
 void sm_enter(StateManager *sm, enum GameState new_state);
 
+// Start loading a state's asset group in the background ahead of sm_enter
+void sm_preload(StateManager *sm, enum GameState state);
+
 #endif // CONQUEST_STATE_MANAGER_H
\ No newline at end of file
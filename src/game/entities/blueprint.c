@@ -0,0 +1,292 @@
+#include "blueprint.h"
+#include "../../utils/log.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void blueprint_library_init(BlueprintLibrary *lib, EcsWorld *world) {
+    memset(lib, 0, sizeof *lib);
+    lib->world = world;
+}
+
+void blueprint_library_free(BlueprintLibrary *lib) {
+    if (!lib) return;
+    for (int i = 0; i < lib->count; i++)
+        free(lib->items[i].data);
+    free(lib->items);
+    memset(lib, 0, sizeof *lib);
+}
+
+bool blueprint_field(BlueprintLibrary *lib, ComponentId component, const char *name,
+                     size_t offset, FieldType type) {
+    if (lib->field_count == BLUEPRINT_MAX_FIELDS) {
+        LOG_ERROR("Blueprints: more than %d fields", BLUEPRINT_MAX_FIELDS);
+        return false;
+    }
+    BlueprintField *f = &lib->fields[lib->field_count++];
+    f->component = component;
+    snprintf(f->name, sizeof f->name, "%s", name);
+    f->offset = (Uint32)offset;
+    f->type = type;
+    return true;
+}
+
+static const BlueprintField *field_find(const BlueprintLibrary *lib, ComponentId component,
+                                        const char *name) {
+    for (int i = 0; i < lib->field_count; i++)
+        if (lib->fields[i].component == component && strcmp(lib->fields[i].name, name) == 0)
+            return &lib->fields[i];
+    return NULL;
+}
+
+static Uint32 field_size(FieldType type) {
+    switch (type) {
+    case FIELD_INT:   return sizeof(int);
+    case FIELD_FLOAT: return sizeof(float);
+    case FIELD_BOOL:  return sizeof(bool);
+    case FIELD_U8:    return sizeof(Uint8);
+    case FIELD_U16:   return sizeof(Uint16);
+    case FIELD_U32:   return sizeof(Uint32);
+    }
+    return 0;
+}
+
+int blueprint_find(const BlueprintLibrary *lib, const char *name) {
+    for (int i = 0; i < lib->count; i++)
+        if (strcmp(lib->items[i].name, name) == 0)
+            return i;
+    return -1;
+}
+
+const Blueprint *blueprint_get(const BlueprintLibrary *lib, int id) {
+    return lib && id >= 0 && id < lib->count ? &lib->items[id] : NULL;
+}
+
+/* ─── compiling ─── */
+
+/* Slot of |id| in the template, appended (zeroed, aligned) when missing */
+static int template_component(const BlueprintLibrary *lib, Blueprint *bp, ComponentId id) {
+    for (int i = 0; i < bp->component_count; i++)
+        if (bp->components[i] == id) return i;
+    if (bp->component_count == BLUEPRINT_MAX_COMPONENTS) return -1;
+
+    const EcsComponentInfo *info = ecs_component_info(lib->world, id);
+    Uint32 align = info->align ? info->align : 1;
+    Uint32 offset = (bp->data_size + align - 1) / align * align;
+    Uint8 *data = realloc(bp->data, offset + info->size ? offset + info->size : 1);
+    if (!data) return -1;
+    memset(data + bp->data_size, 0, offset + info->size - bp->data_size);
+    bp->data = data;
+    bp->data_size = offset + info->size;
+
+    int slot = bp->component_count++;
+    bp->components[slot] = id;
+    bp->offsets[slot] = offset;
+    return slot;
+}
+
+static bool value_parse(const char *text, FieldType type, void *out) {
+    char *end = NULL;
+    switch (type) {
+    case FIELD_INT: {
+        int v = (int)strtol(text, &end, 0);
+        memcpy(out, &v, sizeof v);
+        break;
+    }
+    case FIELD_FLOAT: {
+        float v = strtof(text, &end);
+        memcpy(out, &v, sizeof v);
+        break;
+    }
+    case FIELD_BOOL: {
+        bool v = strcmp(text, "true") == 0 || strcmp(text, "1") == 0;
+        if (!v && strcmp(text, "false") != 0 && strcmp(text, "0") != 0) return false;
+        memcpy(out, &v, sizeof v);
+        return true;
+    }
+    case FIELD_U8: {
+        Uint8 v;
+        if (text[0] == '\'' && text[1] && text[2] == '\'' && !text[3]) {
+            v = (Uint8)text[1];
+            end = (char *)text + 3;
+        } else {
+            v = (Uint8)strtoul(text, &end, 0);
+        }
+        memcpy(out, &v, sizeof v);
+        break;
+    }
+    case FIELD_U16: {
+        Uint16 v = (Uint16)strtoul(text, &end, 0);
+        memcpy(out, &v, sizeof v);
+        break;
+    }
+    case FIELD_U32: {
+        Uint32 v;
+        if (text[0] == '#') {             /* #rrggbb or #rrggbbaa */
+            v = (Uint32)strtoul(text + 1, &end, 16);
+            if (end - text == 7) v = v << 8 | 0xFF;
+            else if (end - text != 9) return false;
+        } else {
+            v = (Uint32)strtoul(text, &end, 0);
+        }
+        memcpy(out, &v, sizeof v);
+        break;
+    }
+    }
+    return end && end != text && *end == '\0';
+}
+
+static char *trim(char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    char *e = s + strlen(s);
+    while (e > s && isspace((unsigned char)e[-1])) *--e = '\0';
+    return s;
+}
+
+/* Start a blueprint from a "[name]" or "[name : parent]" header */
+static Blueprint *blueprint_begin(BlueprintLibrary *lib, char *header,
+                                  const char *path, int line) {
+    char *colon = strchr(header, ':');
+    char *parent = colon ? trim(colon + 1) : NULL;
+    if (colon) *colon = '\0';
+    char *name = trim(header);
+    if (!*name) {
+        LOG_WARN("%s:%d: blueprint without a name", path, line);
+        return NULL;
+    }
+
+    Blueprint bp = {0};
+    snprintf(bp.name, sizeof bp.name, "%s", name);
+    bp.parent = -1;
+    if (parent) {
+        bp.parent = blueprint_find(lib, parent);
+        if (bp.parent < 0) {
+            LOG_WARN("%s:%d: '%s' inherits unknown blueprint '%s'", path, line, name, parent);
+            return NULL;
+        }
+        const Blueprint *base = &lib->items[bp.parent];
+        memcpy(bp.components, base->components, sizeof bp.components);
+        memcpy(bp.offsets, base->offsets, sizeof bp.offsets);
+        bp.component_count = base->component_count;
+        bp.data_size = base->data_size;
+        bp.data = malloc(base->data_size ? base->data_size : 1);
+        if (!bp.data) return NULL;
+        memcpy(bp.data, base->data, base->data_size);
+    }
+
+    int slot = blueprint_find(lib, name);
+    if (slot >= 0) {
+        free(lib->items[slot].data);
+    } else {
+        if (lib->count == lib->capacity) {
+            int cap = lib->capacity ? lib->capacity * 2 : 16;
+            Blueprint *items = realloc(lib->items, sizeof *items * cap);
+            if (!items) {
+                free(bp.data);
+                return NULL;
+            }
+            lib->items = items;
+            lib->capacity = cap;
+        }
+        slot = lib->count++;
+    }
+    lib->items[slot] = bp;
+    return &lib->items[slot];
+}
+
+/* Point the value table into the (now final) packed block */
+static void blueprint_finish(Blueprint *bp) {
+    if (!bp) return;
+    for (int i = 0; i < bp->component_count; i++)
+        bp->values[i] = bp->data + bp->offsets[i];
+}
+
+/* "Component" or "Component.field = value" */
+static void blueprint_line(BlueprintLibrary *lib, Blueprint *bp, char *text,
+                           const char *path, int line) {
+    char *eq = strchr(text, '=');
+    char *value = eq ? trim(eq + 1) : NULL;
+    if (eq) *eq = '\0';
+    char *key = trim(text);
+    char *dot = strchr(key, '.');
+    if (dot) *dot = '\0';
+
+    int id = ecs_component_find(lib->world, key);
+    if (id < 0) {
+        LOG_WARN("%s:%d: unknown component '%s'", path, line, key);
+        return;
+    }
+    int slot = template_component(lib, bp, (ComponentId)id);
+    if (slot < 0) {
+        LOG_WARN("%s:%d: '%s' has too many components", path, line, bp->name);
+        return;
+    }
+    if (!dot) return;
+
+    const BlueprintField *f = field_find(lib, (ComponentId)id, dot + 1);
+    if (!f || !value) {
+        LOG_WARN("%s:%d: bad field '%s.%s'", path, line, key, dot + 1);
+        return;
+    }
+    if (f->offset + field_size(f->type) > ecs_component_info(lib->world, (ComponentId)id)->size) {
+        LOG_WARN("%s:%d: field '%s.%s' lies outside the component", path, line, key, f->name);
+        return;
+    }
+    if (!value_parse(value, f->type, bp->data + bp->offsets[slot] + f->offset))
+        LOG_WARN("%s:%d: bad value '%s' for '%s.%s'", path, line, value, key, f->name);
+}
+
+int blueprint_load_file(BlueprintLibrary *lib, const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        LOG_WARN("Blueprints: cannot open %s", path);
+        return -1;
+    }
+
+    char buf[512];
+    int line = 0, loaded = 0, current = -1;
+    while (fgets(buf, sizeof buf, file)) {
+        line++;
+        char *text = trim(buf);
+        if (!*text || text[0] == '#') continue;
+
+        if (text[0] == '[') {
+            char *close = strchr(text, ']');
+            if (!close) {
+                LOG_WARN("%s:%d: unterminated blueprint header", path, line);
+                continue;
+            }
+            *close = '\0';
+            if (current >= 0) blueprint_finish(&lib->items[current]);
+            Blueprint *bp = blueprint_begin(lib, text + 1, path, line);
+            current = bp ? (int)(bp - lib->items) : -1;
+            loaded += bp != NULL;
+            continue;
+        }
+        if (current < 0) {
+            LOG_WARN("%s:%d: setting outside a blueprint", path, line);
+            continue;
+        }
+        blueprint_line(lib, &lib->items[current], text, path, line);
+    }
+    if (current >= 0) blueprint_finish(&lib->items[current]);
+    fclose(file);
+
+    LOG_INFO("Blueprints: %d loaded from %s", loaded, path);
+    return loaded;
+}
+
+/* ─── spawning ─── */
+
+Entity blueprint_spawn(BlueprintLibrary *lib, int id) {
+    Entity e;
+    return blueprint_spawn_many(lib, id, 1, &e) == 1 ? e : ENTITY_NULL;
+}
+
+int blueprint_spawn_many(BlueprintLibrary *lib, int id, int count, Entity *out) {
+    const Blueprint *bp = blueprint_get(lib, id);
+    if (!bp) return 0;
+    return ecs_create_from(lib->world, bp->components, bp->values,
+                           bp->component_count, count, out);
+}
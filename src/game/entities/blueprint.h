@@ -0,0 +1,83 @@
+#ifndef CONQUEST_BLUEPRINT_H
+#define CONQUEST_BLUEPRINT_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ecs.h"
+
+/*
+ * Entity blueprints.
+ *
+ * Blueprints are read from text files (see resources/data/blueprints.txt): a
+ * "[name]" or "[name : parent]" header, then one "Component.field = value"
+ * (or bare "Component") line per setting. Loading compiles each into a
+ * binary template – the component list plus one packed block holding every
+ * component's bytes – so spawning is ecs_create_from copying those blocks
+ * into the archetype's chunk columns, with no per-field work.
+ *
+ * A child starts as a copy of its parent's template (the parent must come
+ * first) and overrides or adds to it. Fields are looked up by name through
+ * the descriptions registered with blueprint_field.
+ */
+#define BLUEPRINT_MAX_COMPONENTS 32
+#define BLUEPRINT_MAX_FIELDS     256
+
+typedef enum {
+    FIELD_INT,                    /* int */
+    FIELD_FLOAT,                  /* float */
+    FIELD_BOOL,                   /* bool */
+    FIELD_U8,                     /* Uint8, also takes 'c' character literals */
+    FIELD_U16,                    /* Uint16 */
+    FIELD_U32                     /* Uint32, also takes #rrggbbaa colours */
+} FieldType;
+
+typedef struct BlueprintField {
+    ComponentId component;
+    char        name[32];
+    Uint32      offset;
+    FieldType   type;
+} BlueprintField;
+
+typedef struct Blueprint {
+    char         name[32];
+    int          parent;          /* index, -1 for none */
+    ComponentId  components[BLUEPRINT_MAX_COMPONENTS];
+    const void  *values[BLUEPRINT_MAX_COMPONENTS];   /* into data */
+    Uint32       offsets[BLUEPRINT_MAX_COMPONENTS];
+    int          component_count;
+    Uint8       *data;            /* packed component values */
+    Uint32       data_size;
+} Blueprint;
+
+typedef struct BlueprintLibrary {
+    EcsWorld      *world;
+    BlueprintField fields[BLUEPRINT_MAX_FIELDS];
+    int            field_count;
+    Blueprint     *items;
+    int            count, capacity;
+} BlueprintLibrary;
+
+void blueprint_library_init(BlueprintLibrary *lib, EcsWorld *world);
+void blueprint_library_free(BlueprintLibrary *lib);
+
+/* Describe a field of a registered component for the text format */
+bool blueprint_field(BlueprintLibrary *lib, ComponentId component, const char *name,
+                     size_t offset, FieldType type);
+#define BLUEPRINT_FIELD(lib, id, T, member, type) \
+    blueprint_field((lib), (id), #member, offsetof(T, member), (type))
+
+/* Compile every blueprint in |path|; a name seen before is replaced.
+   Returns how many were loaded, -1 if the file could not be read */
+int  blueprint_load_file(BlueprintLibrary *lib, const char *path);
+
+/* Index of |name|, -1 if unknown */
+int  blueprint_find(const BlueprintLibrary *lib, const char *name);
+const Blueprint *blueprint_get(const BlueprintLibrary *lib, int id);
+
+Entity blueprint_spawn(BlueprintLibrary *lib, int id);
+/* |count| entities at once; ids go to |out| when not NULL. Returns how
+   many were made */
+int    blueprint_spawn_many(BlueprintLibrary *lib, int id, int count, Entity *out);
+
+#endif // CONQUEST_BLUEPRINT_H
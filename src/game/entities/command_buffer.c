@@ -0,0 +1,138 @@
+#include "command_buffer.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define COMMANDS_MIN_CAPACITY 4096
+
+typedef enum {
+    CMD_CREATE,
+    CMD_DESTROY,
+    CMD_ADD,
+    CMD_SET,
+    CMD_REMOVE
+} CommandOp;
+
+typedef struct Command {
+    Uint8       op;
+    ComponentId component;
+    Uint32      size;             /* payload bytes after the record */
+    Entity      entity;
+} Command;
+
+#define CMD_ALIGN(n) (((n) + 7) & ~(size_t)7)
+
+void ecs_commands_init(EcsCommands *cmd) {
+    memset(cmd, 0, sizeof *cmd);
+}
+
+void ecs_commands_free(EcsCommands *cmd) {
+    if (!cmd) return;
+    free(cmd->data);
+    free(cmd->resolved);
+    memset(cmd, 0, sizeof *cmd);
+}
+
+void ecs_commands_clear(EcsCommands *cmd) {
+    cmd->size = 0;
+    cmd->count = 0;
+    cmd->pending = 0;
+}
+
+static Command *command_push(EcsCommands *cmd, CommandOp op, Entity e,
+                             ComponentId id, Uint32 payload) {
+    size_t need = CMD_ALIGN(sizeof(Command) + payload);
+    if (cmd->size + need > cmd->capacity) {
+        size_t cap = cmd->capacity ? cmd->capacity : COMMANDS_MIN_CAPACITY;
+        while (cap < cmd->size + need) cap *= 2;
+        Uint8 *data = realloc(cmd->data, cap);
+        if (!data) {
+            LOG_ERROR("EcsCommands: out of memory growing to %zu bytes", cap);
+            return NULL;
+        }
+        cmd->data = data;
+        cmd->capacity = cap;
+    }
+    Command *c = (Command *)(cmd->data + cmd->size);
+    c->op = (Uint8)op;
+    c->component = id;
+    c->size = payload;
+    c->entity = e;
+    cmd->size += need;
+    cmd->count++;
+    return c;
+}
+
+Entity ecs_cmd_create(EcsCommands *cmd) {
+    if ((Uint32)cmd->pending >= ENTITY_MAX) return ENTITY_NULL;
+    if (!command_push(cmd, CMD_CREATE, ENTITY_NULL, 0, 0)) return ENTITY_NULL;
+    Uint32 index = (Uint32)++cmd->pending;
+    return (ENTITY_GEN_PENDING << ENTITY_INDEX_BITS) | index;
+}
+
+void ecs_cmd_destroy(EcsCommands *cmd, Entity e) {
+    command_push(cmd, CMD_DESTROY, e, 0, 0);
+}
+
+void ecs_cmd_add(EcsCommands *cmd, Entity e, ComponentId id) {
+    command_push(cmd, CMD_ADD, e, id, 0);
+}
+
+void ecs_cmd_set(EcsCommands *cmd, Entity e, ComponentId id,
+                 const void *value, Uint32 size) {
+    Command *c = command_push(cmd, CMD_SET, e, id, size);
+    if (c) memcpy(c + 1, value, size);
+}
+
+void ecs_cmd_remove(EcsCommands *cmd, Entity e, ComponentId id) {
+    command_push(cmd, CMD_REMOVE, e, id, 0);
+}
+
+/* ─── playback ─── */
+
+static Entity command_entity(const EcsCommands *cmd, Entity e) {
+    if (!ecs_entity_is_pending(e)) return e;
+    Uint32 n = entity_index(e);
+    return n >= 1 && n <= (Uint32)cmd->pending ? cmd->resolved[n - 1] : ENTITY_NULL;
+}
+
+void ecs_commands_play(EcsCommands *cmd, EcsWorld *w) {
+    if (!cmd || !w) return;
+    if (cmd->pending > cmd->resolved_cap) {
+        Entity *resolved = realloc(cmd->resolved, sizeof *resolved * cmd->pending);
+        if (!resolved) {
+            LOG_ERROR("EcsCommands: out of memory, %d commands dropped", cmd->count);
+            ecs_commands_clear(cmd);
+            return;
+        }
+        cmd->resolved = resolved;
+        cmd->resolved_cap = cmd->pending;
+    }
+
+    int created = 0;
+    for (size_t at = 0; at < cmd->size;) {
+        const Command *c = (const Command *)(cmd->data + at);
+        at += CMD_ALIGN(sizeof *c + c->size);
+        if (c->op == CMD_CREATE) {
+            cmd->resolved[created++] = ecs_create(w);
+            continue;
+        }
+        Entity e = command_entity(cmd, c->entity);
+        if (!ecs_alive(w, e)) continue;
+        switch ((CommandOp)c->op) {
+        case CMD_DESTROY: ecs_destroy(w, e); break;
+        case CMD_ADD:     ecs_add(w, e, c->component); break;
+        case CMD_SET: {
+            const EcsComponentInfo *info = ecs_component_info(w, c->component);
+            if (info && info->size == c->size)
+                ecs_set(w, e, c->component, c + 1);
+            else
+                LOG_WARN("EcsCommands: size mismatch setting component %u", c->component);
+            break;
+        }
+        case CMD_REMOVE:  ecs_remove(w, e, c->component); break;
+        default: break;
+        }
+    }
+    ecs_commands_clear(cmd);
+}
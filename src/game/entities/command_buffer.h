@@ -0,0 +1,55 @@
+#ifndef CONQUEST_COMMAND_BUFFER_H
+#define CONQUEST_COMMAND_BUFFER_H
+
+#include <SDL2/SDL.h>
+#include <stddef.h>
+#include "ecs.h"
+
+/*
+ * Deferred structural changes.
+ *
+ * Systems must not create, destroy, add or remove while queries run, so
+ * they record those operations into an EcsCommands buffer instead: a
+ * linear arena of small records that is replayed on the world later, in
+ * recording order, and then reset with its memory kept for the next frame.
+ *
+ * Entities created through a buffer get a pending handle (generation
+ * ENTITY_GEN_PENDING) that the same buffer's later commands may use; the
+ * real entity exists once the buffer is played. Commands aimed at entities
+ * that died in the meantime are dropped.
+ *
+ * A buffer belongs to one writer at a time – the scheduler gives every job
+ * its own and plays them in system, then chunk order, so the result does
+ * not depend on how many threads ran the systems.
+ */
+typedef struct EcsCommands {
+    Uint8  *data;                 /* records, each 8-byte aligned */
+    size_t  size, capacity;
+    int     count;
+    int     pending;              /* entities created so far */
+    Entity *resolved;             /* pending → real, during playback */
+    int     resolved_cap;
+} EcsCommands;
+
+#define ecs_entity_is_pending(e) (entity_generation(e) == ENTITY_GEN_PENDING)
+
+void   ecs_commands_init(EcsCommands *cmd);
+void   ecs_commands_free(EcsCommands *cmd);
+/* Drop every recorded command, keeping the arena */
+void   ecs_commands_clear(EcsCommands *cmd);
+
+/* Pending handle, ENTITY_NULL when out of memory */
+Entity ecs_cmd_create(EcsCommands *cmd);
+void   ecs_cmd_destroy(EcsCommands *cmd, Entity e);
+void   ecs_cmd_add(EcsCommands *cmd, Entity e, ComponentId id);
+/* |size| bytes of |value| are copied now */
+void   ecs_cmd_set(EcsCommands *cmd, Entity e, ComponentId id,
+                   const void *value, Uint32 size);
+void   ecs_cmd_remove(EcsCommands *cmd, Entity e, ComponentId id);
+#define ECS_CMD_SET(cmd, e, id, T, ...) \
+    ecs_cmd_set((cmd), (e), (id), &(T)__VA_ARGS__, sizeof(T))
+
+/* Apply every command to |world| in recording order, then clear */
+void   ecs_commands_play(EcsCommands *cmd, EcsWorld *world);
+
+#endif // CONQUEST_COMMAND_BUFFER_H
@@ -0,0 +1,894 @@
+#include "ecs.h"
+#include "../../utils/log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ECS_MIN_ARCHETYPES 16
+
+/* ─── signatures ─── */
+
+void ecs_signature_add(EcsSignature *sig, ComponentId id) {
+    if (id < ECS_MAX_COMPONENTS) sig->bits[id / 64] |= (Uint64)1 << (id % 64);
+}
+
+void ecs_signature_remove(EcsSignature *sig, ComponentId id) {
+    if (id < ECS_MAX_COMPONENTS) sig->bits[id / 64] &= ~((Uint64)1 << (id % 64));
+}
+
+bool ecs_signature_has(const EcsSignature *sig, ComponentId id) {
+    return id < ECS_MAX_COMPONENTS && (sig->bits[id / 64] >> (id % 64) & 1);
+}
+
+bool ecs_signature_contains(const EcsSignature *sig, const EcsSignature *sub) {
+    for (int i = 0; i < ECS_MAX_COMPONENTS / 64; i++)
+        if ((sig->bits[i] & sub->bits[i]) != sub->bits[i]) return false;
+    return true;
+}
+
+bool ecs_signature_intersects(const EcsSignature *a, const EcsSignature *b) {
+    for (int i = 0; i < ECS_MAX_COMPONENTS / 64; i++)
+        if (a->bits[i] & b->bits[i]) return true;
+    return false;
+}
+
+static bool signature_equal(const EcsSignature *a, const EcsSignature *b) {
+    return memcmp(a, b, sizeof *a) == 0;
+}
+
+/* ─── archetypes ─── */
+
+static Uint32 align_up(Uint32 v, Uint32 align) {
+    return (v + align - 1) & ~(align - 1);
+}
+
+/* Bytes a chunk of |cap| rows needs; fills in the column offsets */
+static Uint32 layout_bytes(const EcsWorld *w, EcsArchetype *a, int cap) {
+    Uint32 off = sizeof(Entity) * cap;
+    for (int i = 0; i < a->component_count; i++) {
+        const EcsComponentInfo *info = &w->components[a->components[i]];
+        off = align_up(off, info->align);
+        a->offsets[i] = off;
+        off += info->size * cap;
+    }
+    return off;
+}
+
+static void archetype_layout(const EcsWorld *w, EcsArchetype *a) {
+    a->row_bytes = sizeof(Entity);
+    for (int i = 0; i < a->component_count; i++)
+        a->row_bytes += w->components[a->components[i]].size;
+
+    a->chunk_bytes = ECS_CHUNK_BYTES;
+    int cap = ECS_CHUNK_BYTES / a->row_bytes;
+    while (cap > 1 && layout_bytes(w, a, cap) > ECS_CHUNK_BYTES)
+        cap--;
+    if (cap < 1) cap = 1;
+    Uint32 bytes = layout_bytes(w, a, cap);
+    if (bytes > a->chunk_bytes)
+        a->chunk_bytes = bytes;                  /* one oversized row */
+    a->capacity = cap;
+}
+
+static EcsArchetype *archetype_create(EcsWorld *w, const EcsSignature *sig) {
+    if (w->archetype_count == w->archetype_cap) {
+        int cap = w->archetype_cap ? w->archetype_cap * 2 : ECS_MIN_ARCHETYPES;
+        EcsArchetype **list = realloc(w->archetypes, sizeof *list * cap);
+        if (!list) return NULL;
+        w->archetypes = list;
+        w->archetype_cap = cap;
+    }
+
+    EcsArchetype *a = calloc(1, sizeof *a);
+    if (!a) return NULL;
+    a->signature = *sig;
+    for (int c = 0; c < ECS_MAX_COMPONENTS; c++) {
+        a->column[c] = -1;
+        a->component_count += ecs_signature_has(sig, (ComponentId)c);
+    }
+    if (a->component_count) {
+        a->components = malloc(sizeof *a->components * a->component_count);
+        a->offsets = malloc(sizeof *a->offsets * a->component_count);
+        if (!a->components || !a->offsets) {
+            free(a->components);
+            free(a->offsets);
+            free(a);
+            return NULL;
+        }
+    }
+    for (int c = 0, i = 0; c < ECS_MAX_COMPONENTS; c++) {
+        if (!ecs_signature_has(sig, (ComponentId)c)) continue;
+        a->column[c] = (Sint16)i;
+        a->components[i++] = (ComponentId)c;
+    }
+    archetype_layout(w, a);
+
+    a->id = w->archetype_count;
+    w->archetypes[w->archetype_count++] = a;
+    return a;
+}
+
+static void archetype_destroy(EcsArchetype *a) {
+    for (int i = 0; i < a->chunk_cap; i++) {
+        free(a->chunks[i].data);
+        free(a->chunks[i].versions);
+    }
+    free(a->chunks);
+    free(a->components);
+    free(a->offsets);
+    free(a);
+}
+
+static EcsArchetype *archetype_find(EcsWorld *w, const EcsSignature *sig) {
+    for (int i = 0; i < w->archetype_count; i++)
+        if (signature_equal(&w->archetypes[i]->signature, sig))
+            return w->archetypes[i];
+    return archetype_create(w, sig);
+}
+
+/* |from| with |id| added or removed, through the cached edge */
+static EcsArchetype *archetype_step(EcsWorld *w, EcsArchetype *from, ComponentId id,
+                                    bool add) {
+    EcsArchetype **edge = add ? &from->edge_add[id] : &from->edge_remove[id];
+    if (*edge) return *edge;
+    EcsSignature sig = from->signature;
+    if (add) ecs_signature_add(&sig, id);
+    else     ecs_signature_remove(&sig, id);
+    EcsArchetype *to = archetype_find(w, &sig);
+    *edge = to;
+    if (to) {
+        if (add) to->edge_remove[id] = from;
+        else     to->edge_add[id] = from;
+    }
+    return to;
+}
+
+void *ecs_chunk_column(const EcsArchetype *arch, const EcsChunk *chunk, ComponentId id) {
+    if (!arch || !chunk || id >= ECS_MAX_COMPONENTS) return NULL;
+    int col = arch->column[id];
+    return col < 0 ? NULL : chunk->data + arch->offsets[col];
+}
+
+static Entity *chunk_entities(const EcsChunk *chunk) {
+    return (Entity *)chunk->data;
+}
+
+/* ─── rows ─── */
+
+bool ecs_archetype_reserve(EcsArchetype *a, int chunks) {
+    if (chunks > a->chunk_cap) {
+        int cap = a->chunk_cap ? a->chunk_cap : 4;
+        while (cap < chunks) cap *= 2;
+        EcsChunk *list = realloc(a->chunks, sizeof *list * cap);
+        if (!list) return false;
+        memset(list + a->chunk_cap, 0, sizeof *list * (cap - a->chunk_cap));
+        a->chunks = list;
+        a->chunk_cap = cap;
+    }
+    for (int i = 0; i < chunks; i++) {
+        EcsChunk *c = &a->chunks[i];
+        if (c->data) continue;                  /* chunks freed by shrinking stay */
+        c->data = malloc(a->chunk_bytes);
+        c->versions = calloc(a->component_count + 1, sizeof *c->versions);
+        if (!c->data || !c->versions) {
+            free(c->data);
+            free(c->versions);
+            c->data = NULL;
+            c->versions = NULL;
+            LOG_ERROR("ECS: out of memory for a chunk of archetype %d", a->id);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Chunk with room for another row, adding one when the last is full */
+static EcsChunk *chunk_with_room(EcsArchetype *a) {
+    if (a->chunk_count && a->chunks[a->chunk_count - 1].count < a->capacity)
+        return &a->chunks[a->chunk_count - 1];
+    if (!ecs_archetype_reserve(a, a->chunk_count + 1)) return NULL;
+    EcsChunk *c = &a->chunks[a->chunk_count++];
+    c->count = 0;
+    return c;
+}
+
+/* Rows arrived or left: every column of |c| counts as changed, as does the
+   extra slot after them that stands for the entity column */
+static void chunk_stamp(const EcsWorld *w, const EcsArchetype *a, EcsChunk *c) {
+    for (int i = 0; i <= a->component_count; i++)
+        c->versions[i] = w->version;
+}
+
+/* Initialise |rows| rows from |values| (per column, NULL: zero). A value
+   is copied once, then the filled part doubles until the run is covered */
+static void rows_fill(const EcsWorld *w, EcsArchetype *a, EcsChunk *c, int row, int rows,
+                      const void *const *values) {
+    for (int i = 0; i < a->component_count; i++) {
+        size_t size = w->components[a->components[i]].size;
+        Uint8 *out = c->data + a->offsets[i] + size * row;
+        if (!values || !values[i] || !size) {
+            memset(out, 0, size * rows);
+            continue;
+        }
+        memcpy(out, values[i], size);
+        for (size_t done = size, total = size * rows; done < total; done *= 2)
+            memcpy(out + done, out, SDL_min(done, total - done));
+    }
+}
+
+/* Fill the hole at (chunk, row) with the archetype's last row */
+static void row_remove(EcsWorld *w, EcsArchetype *a, int chunk, int row) {
+    EcsChunk *last = &a->chunks[a->chunk_count - 1];
+    EcsChunk *c = &a->chunks[chunk];
+    int last_row = last->count - 1;
+
+    if (c != last || row != last_row) {
+        Entity moved = chunk_entities(last)[last_row];
+        chunk_entities(c)[row] = moved;
+        for (int i = 0; i < a->component_count; i++) {
+            Uint32 size = w->components[a->components[i]].size;
+            memcpy(c->data + a->offsets[i] + (size_t)size * row,
+                   last->data + a->offsets[i] + (size_t)size * last_row, size);
+        }
+        EntityRecord *r = &w->entities.records[entity_index(moved)];
+        r->chunk = (Uint32)chunk;
+        r->row = (Uint32)row;
+        chunk_stamp(w, a, c);
+    }
+    chunk_stamp(w, a, last);              /* lost its last row either way */
+    last->count--;
+    a->entity_count--;
+    if (last->count == 0)
+        a->chunk_count--;
+}
+
+/* Move a live entity to |to|, keeping the components both have */
+static bool entity_move(EcsWorld *w, EntityRecord *r, Entity e, EcsArchetype *to) {
+    EcsArchetype *from = r->archetype;
+    EcsChunk *dst = chunk_with_room(to);
+    if (!dst) return false;
+    int drow = dst->count++;
+    to->entity_count++;
+    chunk_entities(dst)[drow] = e;
+    chunk_stamp(w, to, dst);
+
+    EcsChunk *src = &from->chunks[r->chunk];
+    for (int i = 0; i < to->component_count; i++) {
+        ComponentId id = to->components[i];
+        Uint32 size = w->components[id].size;
+        Uint8 *out = dst->data + to->offsets[i] + (size_t)size * drow;
+        int col = from->column[id];
+        if (col >= 0)
+            memcpy(out, src->data + from->offsets[col] + (size_t)size * r->row, size);
+        else
+            memset(out, 0, size);
+    }
+
+    row_remove(w, from, (int)r->chunk, (int)r->row);
+    r->archetype = to;
+    r->chunk = (Uint32)(dst - to->chunks);
+    r->row = (Uint32)drow;
+    return true;
+}
+
+/* ─── world ─── */
+
+EcsWorld *ecs_world_create(void) {
+    EcsWorld *w = calloc(1, sizeof *w);
+    if (!w) return NULL;
+    entity_table_init(&w->entities);
+    w->version = 1;
+    EcsSignature none = {{0}};
+    w->root = archetype_create(w, &none);
+    if (!w->root) {
+        ecs_world_destroy(w);
+        return NULL;
+    }
+    return w;
+}
+
+void ecs_world_destroy(EcsWorld *w) {
+    if (!w) return;
+    for (int i = 0; i < w->archetype_count; i++)
+        archetype_destroy(w->archetypes[i]);
+    free(w->archetypes);
+    for (int i = 0; i < ECS_MAX_RESOURCES; i++)
+        ecs_resource_bind(w, (ResourceId)i, NULL);
+    for (int i = 0; i < ECS_MAX_COMPONENTS; i++) {
+        ecs_track(w, (ComponentId)i, false);
+        if (!w->sparse[i]) continue;
+        sparse_set_free(w->sparse[i]);
+        free(w->sparse[i]);
+    }
+    entity_table_free(&w->entities);
+    free(w);
+}
+
+int ecs_register_component(EcsWorld *w, const char *name, Uint32 size, Uint32 align,
+                           EcsStorage storage) {
+    if (!w || !name) return -1;
+    if (ecs_component_find(w, name) >= 0) {
+        LOG_ERROR("ECS: component '%s' registered twice", name);
+        return -1;
+    }
+    if (w->component_count == ECS_MAX_COMPONENTS) {
+        LOG_ERROR("ECS: more than %d components ('%s')", ECS_MAX_COMPONENTS, name);
+        return -1;
+    }
+    if (align == 0) align = 1;
+    if (align > ECS_MAX_ALIGN || (align & (align - 1))) {
+        LOG_ERROR("ECS: component '%s' needs alignment %u (max %d)", name, align,
+                  ECS_MAX_ALIGN);
+        return -1;
+    }
+    int id = w->component_count;
+    if (storage == ECS_STORAGE_SPARSE) {
+        w->sparse[id] = malloc(sizeof *w->sparse[id]);
+        if (!w->sparse[id]) return -1;
+        sparse_set_init(w->sparse[id], size);
+        ecs_signature_add(&w->sparse_sig, (ComponentId)id);
+    }
+    EcsComponentInfo *info = &w->components[id];
+    snprintf(info->name, sizeof info->name, "%s", name);
+    info->size = size;
+    info->align = align;
+    info->storage = storage;
+    return w->component_count++;
+}
+
+int ecs_component_find(const EcsWorld *w, const char *name) {
+    if (!w || !name) return -1;
+    for (int i = 0; i < w->component_count; i++)
+        if (strcmp(w->components[i].name, name) == 0) return i;
+    return -1;
+}
+
+const EcsComponentInfo *ecs_component_info(const EcsWorld *w, ComponentId id) {
+    return w && id < w->component_count ? &w->components[id] : NULL;
+}
+
+int ecs_count(const EcsWorld *w) {
+    return w ? (int)w->entities.alive : 0;
+}
+
+SparseSet *ecs_sparse_pool(const EcsWorld *w, ComponentId id) {
+    return w && id < ECS_MAX_COMPONENTS ? w->sparse[id] : NULL;
+}
+
+/* ─── resources ─── */
+
+void *ecs_resource_emplace(EcsWorld *w, ResourceId id, Uint32 size) {
+    if (!w || id >= ECS_MAX_RESOURCES) return NULL;
+    void *data = calloc(1, size ? size : 1);
+    if (!data) {
+        LOG_ERROR("ECS: out of memory for resource %u", id);
+        return NULL;
+    }
+    ecs_resource_bind(w, id, NULL);
+    w->resources[id] = (EcsResource){data, size ? size : 1};
+    return data;
+}
+
+bool ecs_resource_bind(EcsWorld *w, ResourceId id, void *data) {
+    if (!w || id >= ECS_MAX_RESOURCES) return false;
+    EcsResource *r = &w->resources[id];
+    if (r->size) free(r->data);
+    *r = (EcsResource){data, 0};
+    return true;
+}
+
+void *ecs_resource(const EcsWorld *w, ResourceId id) {
+    return w && id < ECS_MAX_RESOURCES ? w->resources[id].data : NULL;
+}
+
+/* ─── change tracking ─── */
+
+Uint32 ecs_version_bump(EcsWorld *w) {
+    return w->version++;
+}
+
+void ecs_chunk_touch(EcsArchetype *a, EcsChunk *c, ComponentId id, Uint32 version) {
+    int col = a && c && id < ECS_MAX_COMPONENTS ? a->column[id] : -1;
+    if (col >= 0) c->versions[col] = version;
+}
+
+bool ecs_track(EcsWorld *w, ComponentId id, bool on) {
+    if (!w || id >= ECS_MAX_COMPONENTS) return false;
+    EcsEvents *ev = w->events[id];
+    if (!on) {
+        if (!ev) return true;
+        for (int s = 0; s < 2; s++) {
+            free(ev->added[s].items);
+            free(ev->removed[s].items);
+        }
+        free(ev);
+        w->events[id] = NULL;
+        return true;
+    }
+    if (!ev) w->events[id] = calloc(1, sizeof *ev);
+    return w->events[id] != NULL;
+}
+
+static void event_push(EcsEventStream *s, Entity e) {
+    if (s->count == s->capacity) {
+        int cap = s->capacity ? s->capacity * 2 : 64;
+        Entity *items = realloc(s->items, sizeof *items * cap);
+        if (!items) {
+            LOG_ERROR("ECS: out of memory, change event dropped");
+            return;
+        }
+        s->items = items;
+        s->capacity = cap;
+    }
+    s->items[s->count++] = e;
+}
+
+static void event_added(EcsWorld *w, ComponentId id, Entity e) {
+    if (w->events[id]) event_push(&w->events[id]->added[w->event_side], e);
+}
+
+static void event_removed(EcsWorld *w, ComponentId id, Entity e) {
+    if (w->events[id]) event_push(&w->events[id]->removed[w->event_side], e);
+}
+
+const Entity *ecs_added(const EcsWorld *w, ComponentId id, int *count) {
+    const EcsEvents *ev = w && id < ECS_MAX_COMPONENTS ? w->events[id] : NULL;
+    const EcsEventStream *s = ev ? &ev->added[!w->event_side] : NULL;
+    *count = s ? s->count : 0;
+    return s ? s->items : NULL;
+}
+
+const Entity *ecs_removed(const EcsWorld *w, ComponentId id, int *count) {
+    const EcsEvents *ev = w && id < ECS_MAX_COMPONENTS ? w->events[id] : NULL;
+    const EcsEventStream *s = ev ? &ev->removed[!w->event_side] : NULL;
+    *count = s ? s->count : 0;
+    return s ? s->items : NULL;
+}
+
+void ecs_events_swap(EcsWorld *w) {
+    if (!w) return;
+    w->event_side = !w->event_side;
+    for (int i = 0; i < ECS_MAX_COMPONENTS; i++) {
+        if (!w->events[i]) continue;
+        w->events[i]->added[w->event_side].count = 0;
+        w->events[i]->removed[w->event_side].count = 0;
+    }
+}
+
+/* ─── entities ─── */
+
+Entity ecs_create(EcsWorld *w) {
+    Entity e;
+    return ecs_create_many(w, NULL, 0, 1, &e) == 1 ? e : ENTITY_NULL;
+}
+
+int ecs_create_many(EcsWorld *w, const ComponentId *components, int component_count,
+                    int count, Entity *out) {
+    return ecs_create_from(w, components, NULL, component_count, count, out);
+}
+
+int ecs_create_from(EcsWorld *w, const ComponentId *components, const void *const *values,
+                    int component_count, int count, Entity *out) {
+    if (!w || count <= 0) return 0;
+    EcsArchetype *a = w->root;
+    for (int i = 0; i < component_count && a; i++) {
+        if (components[i] >= w->component_count) {
+            LOG_ERROR("ECS: unknown component %u", components[i]);
+            return 0;
+        }
+        if (!w->sparse[components[i]])
+            a = archetype_step(w, a, components[i], true);
+    }
+    if (!a) return 0;
+
+    const void *column_value[ECS_MAX_COMPONENTS] = {0};
+    for (int i = 0; values && i < component_count; i++)
+        if (!w->sparse[components[i]])
+            column_value[a->column[components[i]]] = values[i];
+
+    int made = 0;
+    while (made < count) {
+        EcsChunk *c = chunk_with_room(a);
+        if (!c) break;
+        int n = SDL_min(a->capacity - c->count, count - made);
+        int first = c->count, chunk = (int)(c - a->chunks);
+        rows_fill(w, a, c, first, n, column_value);
+        chunk_stamp(w, a, c);
+
+        Entity *ids = chunk_entities(c);
+        int placed = 0;
+        for (; placed < n; placed++) {
+            Entity e = entity_table_alloc(&w->entities);
+            if (e == ENTITY_NULL) break;
+            EntityRecord *r = &w->entities.records[entity_index(e)];
+            r->archetype = a;
+            r->chunk = (Uint32)chunk;
+            r->row = (Uint32)(first + placed);
+            ids[first + placed] = e;
+            if (out) out[made + placed] = e;
+            for (int i = 0; i < component_count; i++) {
+                SparseSet *pool = w->sparse[components[i]];
+                void *value = pool ? sparse_set_add(pool, e) : NULL;
+                if (value && values && values[i] && pool->size)
+                    memcpy(value, values[i], pool->size);
+                event_added(w, components[i], e);
+            }
+        }
+        c->count += placed;
+        a->entity_count += placed;
+        made += placed;
+        if (c->count == 0) a->chunk_count--;
+        if (placed < n) break;
+    }
+    return made;
+}
+
+bool ecs_destroy(EcsWorld *w, Entity e) {
+    EntityRecord *r = w ? entity_table_get(&w->entities, e) : NULL;
+    if (!r) return false;
+    for (int i = 0; i < r->archetype->component_count; i++)
+        event_removed(w, r->archetype->components[i], e);
+    row_remove(w, r->archetype, (int)r->chunk, (int)r->row);
+    for (int i = 0; i < w->component_count; i++)
+        if (w->sparse[i] && w->sparse[i]->count && sparse_set_remove(w->sparse[i], e))
+            event_removed(w, (ComponentId)i, e);
+    return entity_table_release(&w->entities, e);
+}
+
+bool ecs_alive(const EcsWorld *w, Entity e) {
+    return w && entity_table_get(&w->entities, e) != NULL;
+}
+
+bool ecs_has(const EcsWorld *w, Entity e, ComponentId id) {
+    EntityRecord *r = w ? entity_table_get(&w->entities, e) : NULL;
+    if (!r || id >= ECS_MAX_COMPONENTS) return false;
+    if (w->sparse[id]) return sparse_set_has(w->sparse[id], e);
+    return r->archetype->column[id] >= 0;
+}
+
+void *ecs_get(const EcsWorld *w, Entity e, ComponentId id) {
+    EntityRecord *r = w ? entity_table_get(&w->entities, e) : NULL;
+    if (!r || id >= ECS_MAX_COMPONENTS) return NULL;
+    if (w->sparse[id]) return sparse_set_get(w->sparse[id], e);
+    EcsArchetype *a = r->archetype;
+    int col = a->column[id];
+    if (col < 0) return NULL;
+    return a->chunks[r->chunk].data + a->offsets[col] +
+           (size_t)w->components[id].size * r->row;
+}
+
+void *ecs_add(EcsWorld *w, Entity e, ComponentId id) {
+    EntityRecord *r = w ? entity_table_get(&w->entities, e) : NULL;
+    if (!r || id >= w->component_count) return NULL;
+    if (w->sparse[id]) {
+        if (!sparse_set_has(w->sparse[id], e)) event_added(w, id, e);
+        return sparse_set_add(w->sparse[id], e);
+    }
+    if (r->archetype->column[id] < 0) {
+        EcsArchetype *to = archetype_step(w, r->archetype, id, true);
+        if (!to || !entity_move(w, r, e, to)) return NULL;
+        event_added(w, id, e);
+    }
+    return ecs_get(w, e, id);
+}
+
+void *ecs_get_mut(EcsWorld *w, Entity e, ComponentId id) {
+    void *data = ecs_get(w, e, id);
+    if (data && !w->sparse[id]) {
+        EntityRecord *r = entity_table_get(&w->entities, e);
+        ecs_chunk_touch(r->archetype, &r->archetype->chunks[r->chunk], id, w->version);
+    }
+    return data;
+}
+
+void *ecs_set(EcsWorld *w, Entity e, ComponentId id, const void *value) {
+    void *data = ecs_add(w, e, id) ? ecs_get_mut(w, e, id) : NULL;
+    if (data && value)
+        memcpy(data, value, w->components[id].size);
+    return data;
+}
+
+bool ecs_remove(EcsWorld *w, Entity e, ComponentId id) {
+    EntityRecord *r = w ? entity_table_get(&w->entities, e) : NULL;
+    if (!r || id >= ECS_MAX_COMPONENTS) return false;
+    if (w->sparse[id]) {
+        if (!sparse_set_remove(w->sparse[id], e)) return false;
+        event_removed(w, id, e);
+        return true;
+    }
+    if (r->archetype->column[id] < 0) return false;
+    EcsArchetype *to = archetype_step(w, r->archetype, id, false);
+    if (!to || !entity_move(w, r, e, to)) return false;
+    event_removed(w, id, e);
+    return true;
+}
+
+/* ─── queries ─── */
+
+void ecs_query_init(EcsQuery *q, const ComponentId *all, int all_count,
+                    const ComponentId *none, int none_count) {
+    memset(q, 0, sizeof *q);
+    for (int i = 0; i < all_count; i++) ecs_signature_add(&q->all, all[i]);
+    for (int i = 0; i < none_count; i++) ecs_signature_add(&q->none, none[i]);
+}
+
+void ecs_query_free(EcsQuery *q) {
+    if (!q) return;
+    free(q->matches);
+    memset(q, 0, sizeof *q);
+}
+
+void ecs_query_changed(EcsQuery *q, const ComponentId *ids, int count) {
+    memset(&q->changed, 0, sizeof q->changed);
+    for (int i = 0; i < count; i++) ecs_signature_add(&q->changed, ids[i]);
+}
+
+/* No "changed" terms, or one of them is newer than q->since in |c| */
+static bool chunk_changed(const EcsQuery *q, const EcsArchetype *a, const EcsChunk *c) {
+    bool any = false;
+    for (int i = 0; i < ECS_MAX_COMPONENTS / 64; i++) any |= q->changed.bits[i] != 0;
+    if (!any) return true;
+    for (int i = 0; i < a->component_count; i++)
+        if (c->versions[i] > q->since && ecs_signature_has(&q->changed, a->components[i]))
+            return true;
+    return false;
+}
+
+static bool query_matches(const EcsQuery *q, const EcsArchetype *a) {
+    return ecs_signature_contains(&a->signature, &q->all) &&
+           !ecs_signature_intersects(&a->signature, &q->none);
+}
+
+/* Move sparse terms out of the archetype signatures, once per query */
+static void query_split(EcsQuery *q, const EcsWorld *w) {
+    for (int i = 0; i < ECS_MAX_COMPONENTS / 64; i++) {
+        q->sparse_all.bits[i] = q->all.bits[i] & w->sparse_sig.bits[i];
+        q->sparse_none.bits[i] = q->none.bits[i] & w->sparse_sig.bits[i];
+        q->all.bits[i] &= ~w->sparse_sig.bits[i];
+        q->none.bits[i] &= ~w->sparse_sig.bits[i];
+    }
+    q->split = true;
+}
+
+static bool query_has_sparse(const EcsQuery *q) {
+    for (int i = 0; i < ECS_MAX_COMPONENTS / 64; i++)
+        if (q->sparse_all.bits[i] || q->sparse_none.bits[i]) return true;
+    return false;
+}
+
+/* Sparse terms of |q| hold for |e| */
+static bool sparse_pass(const EcsQuery *q, const EcsWorld *w, Entity e) {
+    for (int i = 0; i < w->component_count; i++) {
+        if (!w->sparse[i]) continue;
+        if (ecs_signature_has(&q->sparse_all, (ComponentId)i) &&
+            !sparse_set_has(w->sparse[i], e))
+            return false;
+        if (ecs_signature_has(&q->sparse_none, (ComponentId)i) &&
+            sparse_set_has(w->sparse[i], e))
+            return false;
+    }
+    return true;
+}
+
+void ecs_query_update(EcsQuery *q, EcsWorld *w) {
+    if (!q->split) query_split(q, w);
+    for (; q->tested < w->archetype_count; q->tested++) {
+        EcsArchetype *a = w->archetypes[q->tested];
+        if (!query_matches(q, a))
+            continue;
+        if (q->match_count == q->match_cap) {
+            int cap = q->match_cap ? q->match_cap * 2 : 8;
+            EcsArchetype **m = realloc(q->matches, sizeof *m * cap);
+            if (!m) {
+                LOG_ERROR("ECS: out of memory growing a query");
+                return;                       /* retried on the next update */
+            }
+            q->matches = m;
+            q->match_cap = cap;
+        }
+        q->matches[q->match_count++] = a;
+    }
+}
+
+int ecs_query_count(EcsQuery *q, EcsWorld *w) {
+    if (!q || !w) return 0;
+    ecs_query_update(q, w);
+    int n = 0;
+    if (query_has_sparse(q)) {
+        EcsIter it = ecs_query_iter(w, q);
+        while (ecs_iter_next(&it))
+            n += it.count;
+        return n;
+    }
+    for (int i = 0; i < q->match_count; i++)
+        n += q->matches[i]->entity_count;
+    return n;
+}
+
+EcsIter ecs_query_iter(EcsWorld *w, EcsQuery *q) {
+    EcsIter it = {0};
+    it.world = w;
+    it.query = q;
+    it.chunk = -1;
+    it.dense = -1;
+    it.chunks_left = -1;
+    if (!w || !q) return it;
+    it.version = w->version;
+    ecs_query_update(q, w);
+
+    /* a required sparse component drives: walk its (smallest) pool */
+    for (int i = 0; i < w->component_count; i++) {
+        SparseSet *pool = w->sparse[i];
+        if (pool && ecs_signature_has(&q->sparse_all, (ComponentId)i) &&
+            (!it.driver || pool->count < it.driver->count))
+            it.driver = pool;
+    }
+    return it;
+}
+
+int ecs_query_chunk_count(const EcsQuery *q) {
+    int n = 0;
+    for (int i = 0; i < q->match_count; i++)
+        n += q->matches[i]->chunk_count;
+    return n;
+}
+
+EcsIter ecs_query_iter_range(EcsWorld *w, EcsQuery *q, int begin, int end) {
+    EcsIter it = {0};
+    it.world = w;
+    it.query = q;
+    it.chunk = -1;
+    it.dense = -1;
+    if (!w || !q || end <= begin) return it;
+    it.version = w->version;
+    it.chunks_left = end - begin;
+    while (it.match < q->match_count && begin >= q->matches[it.match]->chunk_count)
+        begin -= q->matches[it.match++]->chunk_count;
+    it.chunk = begin - 1;             /* entered by the first ecs_iter_next */
+    return it;
+}
+
+static bool iter_end(EcsIter *it) {
+    it->archetype = NULL;
+    it->current = NULL;
+    it->row = it->count = 0;
+    it->entities = NULL;
+    return false;
+}
+
+/* One entity at a time from the driving pool */
+static bool iter_next_sparse(EcsIter *it) {
+    const EcsQuery *q = it->query;
+    while (++it->dense < it->driver->count) {
+        Entity e = it->driver->dense[it->dense];
+        EntityRecord *r = entity_table_get(&it->world->entities, e);
+        if (!r || !query_matches(q, r->archetype) || !sparse_pass(q, it->world, e) ||
+            !chunk_changed(q, r->archetype, &r->archetype->chunks[r->chunk]))
+            continue;
+        it->archetype = r->archetype;
+        it->current = &r->archetype->chunks[r->chunk];
+        it->row = (int)r->row;
+        it->count = 1;
+        it->entities = &it->driver->dense[it->dense];
+        return true;
+    }
+    return iter_end(it);
+}
+
+bool ecs_iter_next(EcsIter *it) {
+    if (!it->world || !it->query) return false;
+    if (it->driver) return iter_next_sparse(it);
+
+    EcsQuery *q = it->query;
+    bool filter = query_has_sparse(q);
+    while (it->match < q->match_count) {
+        EcsArchetype *a = q->matches[it->match];
+        EcsChunk *c = it->current;
+
+        /* excluded sparse components: hand out runs of rows that pass */
+        if (c && filter) {
+            Entity *ids = chunk_entities(c);
+            int row = it->row + it->count;
+            while (row < c->count && !sparse_pass(q, it->world, ids[row])) row++;
+            int end = row;
+            while (end < c->count && sparse_pass(q, it->world, ids[end])) end++;
+            if (row < c->count) {
+                it->row = row;
+                it->count = end - row;
+                it->entities = ids + row;
+                return true;
+            }
+        }
+
+        if (!it->chunks_left) break;
+        if (++it->chunk < a->chunk_count) {
+            if (it->chunks_left > 0) it->chunks_left--;
+            c = &a->chunks[it->chunk];
+            it->archetype = a;
+            it->current = c;
+            it->row = 0;
+            it->count = 0;
+            if (!c->count || !chunk_changed(q, a, c)) {
+                it->current = NULL;           /* nothing to hand out here */
+                continue;
+            }
+            if (filter) continue;
+            it->count = c->count;
+            it->entities = chunk_entities(c);
+            return true;
+        }
+        it->match++;
+        it->chunk = -1;
+        it->current = NULL;
+        it->row = it->count = 0;
+    }
+    return iter_end(it);
+}
+
+void *ecs_iter_column(const EcsIter *it, ComponentId id) {
+    if (!it->world || id >= ECS_MAX_COMPONENTS || !it->count) return NULL;
+    if (it->world->sparse[id])
+        return it->count == 1 ? sparse_set_get(it->world->sparse[id], it->entities[0]) : NULL;
+    Uint8 *col = ecs_chunk_column(it->archetype, it->current, id);
+    return col ? col + (size_t)it->world->components[id].size * it->row : NULL;
+}
+
+void *ecs_iter_column_mut(const EcsIter *it, ComponentId id) {
+    void *col = ecs_iter_column(it, id);
+    if (col && !it->world->sparse[id])
+        ecs_chunk_touch(it->archetype, it->current, id, it->version);
+    return col;
+}
+
+/* ─── stats ─── */
+
+EcsWorldStats ecs_world_stats(const EcsWorld *w) {
+    EcsWorldStats stats = {0};
+    if (!w) return stats;
+    stats.entities = (int)w->entities.alive;
+    stats.archetypes = w->archetype_count;
+    stats.components = w->component_count;
+    stats.version = w->version;
+    return stats;
+}
+
+/* Chunk slots with memory behind them: emptied chunks stay allocated */
+static int archetype_allocated(const EcsArchetype *a) {
+    int allocated = 0;
+    for (int i = 0; i < a->chunk_cap; i++)
+        allocated += a->chunks[i].data != NULL;
+    return allocated;
+}
+
+EcsArchetypeStats ecs_archetype_stats(const EcsWorld *w, int index) {
+    EcsArchetypeStats stats = {0};
+    if (!w || index < 0 || index >= w->archetype_count) return stats;
+    const EcsArchetype *a = w->archetypes[index];
+    stats.id = a->id;
+    stats.entities = a->entity_count;
+    stats.chunks = a->chunk_count;
+    stats.bytes = (size_t)archetype_allocated(a) * a->chunk_bytes;
+    stats.components = a->components;
+    stats.component_count = a->component_count;
+    return stats;
+}
+
+void ecs_component_stats(const EcsWorld *w, EcsComponentStats *out) {
+    if (!w || !out) return;
+    memset(out, 0, sizeof *out * w->component_count);
+    for (int i = 0; i < w->archetype_count; i++) {
+        const EcsArchetype *a = w->archetypes[i];
+        int allocated = archetype_allocated(a);
+        for (int c = 0; c < a->component_count; c++) {
+            ComponentId id = a->components[c];
+            out[id].entities += a->entity_count;
+            out[id].bytes += (size_t)allocated * a->capacity * w->components[id].size;
+        }
+    }
+    for (int id = 0; id < w->component_count; id++) {
+        if (!w->sparse[id]) continue;
+        out[id].entities = w->sparse[id]->count;
+        out[id].bytes = sparse_set_bytes(w->sparse[id]);
+        out[id].sparse = true;
+    }
+}
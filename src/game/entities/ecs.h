@@ -0,0 +1,305 @@
+#ifndef CONQUEST_ECS_H
+#define CONQUEST_ECS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "entity.h"
+#include "sparse_set.h"
+
+/*
+ * Archetype entity-component system.
+ *
+ * Components are plain data registered once per world. Every distinct set
+ * of components an entity has is an archetype; its entities live in
+ * fixed-size chunks laid out as structure-of-arrays – one entity column,
+ * then one tightly packed column per component – so a query walks matching
+ * chunks linearly and hands out whole columns.
+ *
+ * Adding or removing a component moves the entity to the neighbouring
+ * archetype (edges are cached); destroying one moves the archetype's last
+ * row into the hole, so chunks stay dense. Archetypes are never freed,
+ * which lets queries cache their matches and only test new archetypes.
+ *
+ * Components toggled often (status effects, AI targets) can be registered
+ * with sparse storage instead: they live in a SparseSet outside the
+ * archetypes, so adding or removing one never moves the entity. Queries
+ * with sparse terms step one entity at a time (driven by the smallest
+ * required pool), or – when sparse components are only excluded – hand out
+ * runs of rows that pass.
+ *
+ * Every chunk keeps a version per column, stamped from the world version
+ * when rows arrive or leave, on ecs_set/ecs_get_mut, and on
+ * ecs_iter_column_mut. Queries with "changed" terms skip chunks whose
+ * columns are no newer than q->since. Components can also be tracked, which
+ * records the entities that gained or lost them into double-buffered event
+ * streams. Both look at table components; sparse ones are not versioned.
+ *
+ * Resources are world-wide singletons (map, RNG, clock...) in a slot table
+ * indexed by compile-time ids (see world_resources.h): one load to reach,
+ * either owned by the world or borrowed from elsewhere.
+ *
+ * Structural changes (create, destroy, add, remove) must not happen while
+ * a query over the affected archetypes is being iterated.
+ */
+#define ECS_MAX_COMPONENTS 128
+#define ECS_CHUNK_BYTES    16384
+#define ECS_MAX_ALIGN      16
+#define ECS_MAX_RESOURCES  64
+
+typedef Uint16 ComponentId;
+typedef Uint8  ResourceId;
+
+typedef struct EcsSignature {
+    Uint64 bits[ECS_MAX_COMPONENTS / 64];
+} EcsSignature;
+
+typedef enum {
+    ECS_STORAGE_TABLE,            /* archetype chunk column */
+    ECS_STORAGE_SPARSE            /* SparseSet, O(1) add/remove */
+} EcsStorage;
+
+typedef struct EcsComponentInfo {
+    char       name[32];
+    Uint32     size, align;
+    EcsStorage storage;
+} EcsComponentInfo;
+
+typedef struct EcsChunk {
+    Uint8  *data;                 /* entities, then the component columns */
+    int     count;
+    Uint32 *versions;             /* per column, then entities: last change */
+} EcsChunk;
+
+typedef struct EcsArchetype {
+    int           id;
+    EcsSignature  signature;
+    ComponentId  *components;     /* ascending */
+    Uint32       *offsets;        /* column offset in a chunk, per component */
+    int           component_count;
+    Sint16        column[ECS_MAX_COMPONENTS];   /* component → index, -1 */
+    Uint32        row_bytes;
+    int           capacity;       /* rows per chunk */
+    Uint32        chunk_bytes;
+
+    EcsChunk     *chunks;         /* all full except the last */
+    int           chunk_count, chunk_cap;
+    int           entity_count;
+
+    struct EcsArchetype *edge_add[ECS_MAX_COMPONENTS];
+    struct EcsArchetype *edge_remove[ECS_MAX_COMPONENTS];
+} EcsArchetype;
+
+typedef struct EcsEventStream {
+    Entity *items;
+    int     count, capacity;
+} EcsEventStream;
+
+typedef struct EcsEvents {        /* per tracked component */
+    EcsEventStream added[2], removed[2];   /* [world->event_side] records */
+} EcsEvents;
+
+typedef struct EcsResource {
+    void  *data;
+    Uint32 size;                  /* 0 when borrowed */
+} EcsResource;
+
+typedef struct EcsWorld {
+    EcsComponentInfo components[ECS_MAX_COMPONENTS];
+    int              component_count;
+
+    EcsArchetype   **archetypes;
+    int              archetype_count, archetype_cap;
+    EcsArchetype    *root;        /* no components */
+
+    SparseSet       *sparse[ECS_MAX_COMPONENTS];   /* sparse components only */
+    EcsSignature     sparse_sig;
+
+    Uint32           version;     /* stamped on changes, starts at 1 */
+    EcsEvents       *events[ECS_MAX_COMPONENTS];   /* tracked components only */
+    int              event_side;
+
+    EcsResource      resources[ECS_MAX_RESOURCES];
+
+    EntityTable      entities;
+} EcsWorld;
+
+typedef struct EcsQuery {
+    EcsSignature   all, none;     /* table terms */
+    EcsSignature   sparse_all, sparse_none;
+    bool           split;         /* sparse terms moved out of all/none */
+    EcsSignature   changed;       /* any of these columns newer than since */
+    Uint32         since;
+    EcsArchetype **matches;
+    int            match_count, match_cap;
+    int            tested;        /* archetypes already matched against */
+} EcsQuery;
+
+struct EcsCommands;
+
+typedef struct EcsIter {
+    EcsWorld     *world;
+    EcsQuery     *query;
+    int           match, chunk;   /* position */
+    EcsArchetype *archetype;      /* current chunk's archetype */
+    EcsChunk     *current;
+    int           row;            /* first row of the current run */
+    int           count;          /* rows in the current run */
+    Entity       *entities;
+    SparseSet    *driver;         /* sparse-driven queries: pool walked */
+    int           dense;
+    int           chunks_left;    /* range iterators, -1: unbounded */
+    Uint32        version;        /* stamped by ecs_iter_column_mut */
+    struct EcsCommands *commands; /* set by the scheduler for systems */
+} EcsIter;
+
+/* ─── world ─── */
+
+EcsWorld *ecs_world_create(void);
+void      ecs_world_destroy(EcsWorld *world);
+
+/* Components must be registered before use. Returns the id or -1 */
+int  ecs_register_component(EcsWorld *world, const char *name, Uint32 size,
+                            Uint32 align, EcsStorage storage);
+#define ECS_REGISTER(world, T) \
+    ecs_register_component((world), #T, sizeof(T), _Alignof(T), ECS_STORAGE_TABLE)
+#define ECS_REGISTER_SPARSE(world, T) \
+    ecs_register_component((world), #T, sizeof(T), _Alignof(T), ECS_STORAGE_SPARSE)
+
+/* Id of a registered component, -1 if unknown */
+int  ecs_component_find(const EcsWorld *world, const char *name);
+const EcsComponentInfo *ecs_component_info(const EcsWorld *world, ComponentId id);
+
+int  ecs_count(const EcsWorld *world);
+
+/* Pool of a sparse component (NULL for table components): its dense
+   arrays can be walked directly */
+SparseSet *ecs_sparse_pool(const EcsWorld *world, ComponentId id);
+
+/* ─── entities ─── */
+
+Entity ecs_create(EcsWorld *world);
+/* |count| entities with zeroed |components|. Returns how many were made;
+   their ids go to |out| when it is not NULL */
+int    ecs_create_many(EcsWorld *world, const ComponentId *components,
+                       int component_count, int count, Entity *out);
+/* ecs_create_many with every entity's components copied from |values|
+   (one per component, NULL entries zeroed) */
+int    ecs_create_from(EcsWorld *world, const ComponentId *components,
+                       const void *const *values, int component_count,
+                       int count, Entity *out);
+bool   ecs_destroy(EcsWorld *world, Entity e);
+bool   ecs_alive(const EcsWorld *world, Entity e);
+
+bool   ecs_has(const EcsWorld *world, Entity e, ComponentId id);
+/* Component data, NULL if |e| is dead or lacks it */
+void  *ecs_get(const EcsWorld *world, Entity e, ComponentId id);
+/* Add |id| (zeroed) unless present; returns the component */
+void  *ecs_add(EcsWorld *world, Entity e, ComponentId id);
+/* ecs_get for writing: marks the component changed */
+void  *ecs_get_mut(EcsWorld *world, Entity e, ComponentId id);
+/* Add if needed and copy |value| in */
+void  *ecs_set(EcsWorld *world, Entity e, ComponentId id, const void *value);
+bool   ecs_remove(EcsWorld *world, Entity e, ComponentId id);
+
+/* ─── resources ─── */
+
+/* World-owned resource of |size| zeroed bytes, replacing any previous one */
+void  *ecs_resource_emplace(EcsWorld *world, ResourceId id, Uint32 size);
+/* Borrow |data| (owned elsewhere) as the resource; NULL clears the slot */
+bool   ecs_resource_bind(EcsWorld *world, ResourceId id, void *data);
+void  *ecs_resource(const EcsWorld *world, ResourceId id);
+#define ECS_RESOURCE(world, T, id) ((T *)(world)->resources[(id)].data)
+
+/* ─── change tracking ─── */
+
+/* Start a new world version; returns the one that ended, so "changed
+   since" that value covers everything from here on */
+Uint32 ecs_version_bump(EcsWorld *world);
+/* Stamp |id|'s column in |chunk| with |version| */
+void   ecs_chunk_touch(EcsArchetype *arch, EcsChunk *chunk, ComponentId id, Uint32 version);
+/* Record entities gaining and losing |id| from now on (or stop) */
+bool   ecs_track(EcsWorld *world, ComponentId id, bool on);
+/* Entities that gained / lost |id| before the last ecs_events_swap. Ones
+   destroyed since may be among them */
+const Entity *ecs_added(const EcsWorld *world, ComponentId id, int *count);
+const Entity *ecs_removed(const EcsWorld *world, ComponentId id, int *count);
+/* Publish what was recorded since the last swap, drop what was published */
+void   ecs_events_swap(EcsWorld *world);
+
+/* ─── signatures ─── */
+
+void ecs_signature_add(EcsSignature *sig, ComponentId id);
+void ecs_signature_remove(EcsSignature *sig, ComponentId id);
+bool ecs_signature_has(const EcsSignature *sig, ComponentId id);
+/* Every bit of |sub| is set in |sig| */
+bool ecs_signature_contains(const EcsSignature *sig, const EcsSignature *sub);
+bool ecs_signature_intersects(const EcsSignature *a, const EcsSignature *b);
+
+/* ─── queries ─── */
+
+/* Entities having every component of |all| and none of |none| */
+void ecs_query_init(EcsQuery *q, const ComponentId *all, int all_count,
+                    const ComponentId *none, int none_count);
+void ecs_query_free(EcsQuery *q);
+/* Only chunks where one of |ids| changed after q->since */
+void ecs_query_changed(EcsQuery *q, const ComponentId *ids, int count);
+/* Pick up archetypes created since the last call */
+void ecs_query_update(EcsQuery *q, EcsWorld *world);
+int  ecs_query_count(EcsQuery *q, EcsWorld *world);
+
+EcsIter ecs_query_iter(EcsWorld *world, EcsQuery *q);
+/* Advance to the next run of matching rows (a whole chunk unless the
+   query has sparse terms) */
+bool    ecs_iter_next(EcsIter *it);
+/* Chunks of every matched archetype, the index space of ranges */
+int     ecs_query_chunk_count(const EcsQuery *q);
+/* Iterate chunks [begin, end) of the query only, so disjoint ranges can run
+   on different threads. Call ecs_query_update first: this does not, and it
+   ignores a sparse driver (table and excluded-sparse terms still apply) */
+EcsIter ecs_query_iter_range(EcsWorld *world, EcsQuery *q, int begin, int end);
+/* Column of |id| for the current run, NULL if the rows lack it. Sparse
+   components resolve for single-entity runs only */
+void   *ecs_iter_column(const EcsIter *it, ComponentId id);
+#define ECS_COLUMN(it, T, id) ((T *)ecs_iter_column((it), (id)))
+/* ecs_iter_column for writing: stamps the chunk with it->version */
+void   *ecs_iter_column_mut(const EcsIter *it, ComponentId id);
+#define ECS_COLUMN_MUT(it, T, id) ((T *)ecs_iter_column_mut((it), (id)))
+
+/* ─── stats (debug tools) ─── */
+
+typedef struct EcsWorldStats {
+    int    entities;
+    int    archetypes;
+    int    components;
+    Uint32 version;
+} EcsWorldStats;
+
+typedef struct EcsArchetypeStats {
+    int                id;
+    int                entities;
+    int                chunks;          /* chunks holding rows            */
+    size_t             bytes;           /* allocated, emptied chunks too  */
+    const ComponentId *components;      /* ascending, |component_count|   */
+    int                component_count;
+} EcsArchetypeStats;
+
+typedef struct EcsComponentStats {
+    int    entities;
+    size_t bytes;                       /* its columns, or its sparse pool */
+    bool   sparse;
+} EcsComponentStats;
+
+EcsWorldStats     ecs_world_stats(const EcsWorld *world);
+/* |index| in 0..archetypes-1 of ecs_world_stats, in creation order */
+EcsArchetypeStats ecs_archetype_stats(const EcsWorld *world, int index);
+/* One entry per registered component into |out| (ecs_world_stats
+   components entries) */
+void              ecs_component_stats(const EcsWorld *world, EcsComponentStats *out);
+
+/* Allocate the first |chunks| chunk slots of |arch| (counts untouched) */
+bool    ecs_archetype_reserve(EcsArchetype *arch, int chunks);
+
+/* Column of |id| in |chunk| of |arch| (used by the iterators) */
+void   *ecs_chunk_column(const EcsArchetype *arch, const EcsChunk *chunk, ComponentId id);
+
+#endif // CONQUEST_ECS_H
@@ -3,8 +3,84 @@ We want to prioritze composition over inheritance.
 We want to use the entity component system (ECS) pattern.
 */
 
-// Imports
+#include "entity.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+#include <string.h>
 
-// Define what is an entity
-// This includes attributes and methods for all entities including
-// the player, enemies, items, etc.
\ No newline at end of file
+#define ENTITY_MIN_CAPACITY 1024
+
+void entity_table_init(EntityTable *table) {
+    memset(table, 0, sizeof *table);
+}
+
+void entity_table_free(EntityTable *table) {
+    if (!table) return;
+    free(table->records);
+    memset(table, 0, sizeof *table);
+}
+
+static bool table_grow(EntityTable *table, Uint32 need) {
+    if (need <= table->capacity) return true;
+    Uint32 cap = table->capacity ? table->capacity : ENTITY_MIN_CAPACITY;
+    while (cap < need) cap *= 2;
+    if (cap > ENTITY_MAX + 1) cap = ENTITY_MAX + 1;
+    if (cap < need) return false;
+    EntityRecord *records = realloc(table->records, sizeof *records * cap);
+    if (!records) return false;
+    memset(records + table->capacity, 0, sizeof *records * (cap - table->capacity));
+    table->records = records;
+    table->capacity = cap;
+    return true;
+}
+
+static Uint32 free_pop(EntityTable *table) {
+    Uint32 index = table->free_head;
+    table->free_head = table->records[index].next_free;
+    if (!table->free_head) table->free_tail = 0;
+    table->free_count--;
+    return index;
+}
+
+Entity entity_table_alloc(EntityTable *table) {
+    Uint32 index;
+    if (table->free_count >= ENTITY_FREE_MIN) {
+        index = free_pop(table);                    /* oldest release first */
+    } else {
+        if (!table->count) table->count = 1;          /* slot 0 stays null */
+        if (table_grow(table, table->count + 1)) {
+            index = table->count++;
+        } else if (table->free_head) {
+            index = free_pop(table);    /* at ENTITY_MAX: reuse what there is */
+        } else {
+            LOG_ERROR("Entity table full at %u entities", table->alive);
+            return ENTITY_NULL;
+        }
+    }
+    EntityRecord *r = &table->records[index];
+    r->next_free = 0;
+    table->alive++;
+    return (r->generation << ENTITY_INDEX_BITS) | index;
+}
+
+bool entity_table_release(EntityTable *table, Entity e) {
+    EntityRecord *r = entity_table_get(table, e);
+    if (!r) return false;
+    r->archetype = NULL;
+    r->generation = (r->generation + 1) % ENTITY_GEN_PENDING;
+    r->next_free = 0;
+    if (table->free_tail) table->records[table->free_tail].next_free = entity_index(e);
+    else                  table->free_head = entity_index(e);
+    table->free_tail = entity_index(e);
+    table->free_count++;
+    table->alive--;
+    return true;
+}
+
+EntityRecord *entity_table_get(const EntityTable *table, Entity e) {
+    Uint32 index = entity_index(e);
+    if (!table || index == 0 || index >= table->count) return NULL;
+    EntityRecord *r = &table->records[index];
+    if (r->generation != entity_generation(e) || !r->archetype) return NULL;
+    return r;
+}
@@ -0,0 +1,68 @@
+#ifndef CONQUEST_ENTITY_H
+#define CONQUEST_ENTITY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/*
+ * Entity handles.
+ *
+ * An Entity is a 32-bit id: the low ENTITY_INDEX_BITS pick a slot in the
+ * EntityTable, the high bits hold the slot's generation. Destroying an
+ * entity bumps the generation, so stale handles stop resolving instead of
+ * aliasing whatever reuses the slot. Slot 0 is never handed out, which
+ * keeps ENTITY_NULL invalid forever. The all-ones generation is never
+ * used either: command buffers mark their not-yet-created entities with it.
+ *
+ * With 10 generation bits a slot's generation wraps after 1023 reuses, and
+ * a handle that old resolves again. Released slots therefore go through a
+ * FIFO queue and are only reused once ENTITY_FREE_MIN slots are waiting, so
+ * a slot comes back at most once per ENTITY_FREE_MIN releases: a stale
+ * handle can only alias after 1023 × ENTITY_FREE_MIN (about a million)
+ * entities were destroyed while it was held. Only a table grown to
+ * ENTITY_MAX reuses slots earlier.
+ */
+typedef Uint32 Entity;
+
+#define ENTITY_NULL       0u
+#define ENTITY_INDEX_BITS 22
+#define ENTITY_INDEX_MASK ((1u << ENTITY_INDEX_BITS) - 1)
+#define ENTITY_GEN_MASK   ((1u << (32 - ENTITY_INDEX_BITS)) - 1)
+#define ENTITY_MAX        ENTITY_INDEX_MASK      /* live entities at most */
+#define ENTITY_GEN_PENDING ENTITY_GEN_MASK       /* reserved, see above */
+#define ENTITY_FREE_MIN    1024                  /* queued slots before reuse */
+
+#define entity_index(e)      ((Uint32)(e) & ENTITY_INDEX_MASK)
+#define entity_generation(e) ((Uint32)(e) >> ENTITY_INDEX_BITS)
+
+struct EcsArchetype;
+
+/* Where a live entity's components are; archetype NULL marks a free slot */
+typedef struct EntityRecord {
+    struct EcsArchetype *archetype;
+    Uint32               chunk, row;
+    Uint32               generation;
+    Uint32               next_free;
+} EntityRecord;
+
+typedef struct EntityTable {
+    EntityRecord *records;
+    Uint32        count, capacity;   /* slots used / allocated, slot 0 included */
+    Uint32        free_head;         /* oldest released slot, 0: none */
+    Uint32        free_tail;         /* newest released slot          */
+    Uint32        free_count;
+    Uint32        alive;
+} EntityTable;
+
+void   entity_table_init(EntityTable *table);
+void   entity_table_free(EntityTable *table);
+
+/* New handle; its record still has to be placed by the caller */
+Entity entity_table_alloc(EntityTable *table);
+/* Release |e|'s slot. False if |e| was already stale */
+bool   entity_table_release(EntityTable *table, Entity e);
+
+/* Record of a live entity, NULL for stale or null handles */
+EntityRecord *entity_table_get(const EntityTable *table, Entity e);
+
+#endif // CONQUEST_ENTITY_H
@@ -0,0 +1,210 @@
+#include "hierarchy.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool hierarchy_init(Hierarchy *h, EcsWorld *w) {
+    memset(h, 0, sizeof *h);
+    h->world = w;
+    int id = ecs_component_find(w, "ChildOf");
+    if (id < 0) id = ECS_REGISTER(w, ChildOf);
+    if (id < 0) return false;
+    h->child_of = (ComponentId)id;
+    ecs_query_init(&h->links, &h->child_of, 1, NULL, 0);
+    ecs_query_init(&h->changed, &h->child_of, 1, NULL, 0);
+    ecs_query_changed(&h->changed, &h->child_of, 1);
+    return true;
+}
+
+void hierarchy_free(Hierarchy *h) {
+    if (!h) return;
+    ecs_query_free(&h->links);
+    ecs_query_free(&h->changed);
+    free(h->nodes);
+    free(h->position);
+    free(h->pairs);
+    free(h->stack);
+    memset(h, 0, sizeof *h);
+}
+
+Entity hierarchy_parent(const Hierarchy *h, Entity child) {
+    const ChildOf *link = ecs_get(h->world, child, h->child_of);
+    return link ? link->parent : ENTITY_NULL;
+}
+
+bool hierarchy_attach(Hierarchy *h, Entity child, Entity parent) {
+    if (!ecs_alive(h->world, child) || !ecs_alive(h->world, parent)) return false;
+    /* |child| must not be |parent| or one of its ancestors */
+    Uint32 steps = h->world->entities.alive;
+    for (Entity up = parent; up != ENTITY_NULL && steps--; up = hierarchy_parent(h, up)) {
+        if (up == child) {
+            LOG_WARN("Hierarchy: attaching %u under %u would make a cycle", child, parent);
+            return false;
+        }
+    }
+    return ecs_set(h->world, child, h->child_of, &(ChildOf){parent}) != NULL;
+}
+
+void hierarchy_detach(Hierarchy *h, Entity child) {
+    ecs_remove(h->world, child, h->child_of);
+}
+
+/* ─── flattening ─── */
+
+static int link_compare(const void *a, const void *b) {
+    const HierarchyLink *x = a, *y = b;
+    if (x->parent != y->parent) return x->parent < y->parent ? -1 : 1;
+    return x->child < y->child ? -1 : x->child > y->child;
+}
+
+/* First link whose parent is >= |parent| */
+static int links_lower(const Hierarchy *h, Entity parent) {
+    int lo = 0, hi = h->link_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (h->pairs[mid].parent < parent) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static bool links_has_children(const Hierarchy *h, Entity e) {
+    int at = links_lower(h, e);
+    return at < h->link_count && h->pairs[at].parent == e;
+}
+
+/* Root nodes have no parent, or a parent that died */
+static bool is_root(const Hierarchy *h, Entity e) {
+    Entity parent = hierarchy_parent(h, e);
+    return parent == ENTITY_NULL || !ecs_alive(h->world, parent);
+}
+
+static bool scratch_reserve(Hierarchy *h, int links) {
+    if (links > h->link_cap) {
+        HierarchyLink *buf = realloc(h->pairs, sizeof *buf * links);
+        if (buf) h->pairs = buf;
+        int *stack = realloc(h->stack, sizeof *stack * 3 * (links + 1));
+        if (stack) h->stack = stack;
+        if (!buf || !stack) return false;
+        h->link_cap = links;
+    }
+    if (2 * links > h->capacity) {
+        HierarchyNode *nodes = realloc(h->nodes, sizeof *nodes * 2 * links);
+        if (!nodes) return false;
+        h->nodes = nodes;
+        h->capacity = 2 * links;
+    }
+    Uint32 slots = h->world->entities.count;
+    if (slots > h->position_cap) {
+        Uint32 *position = realloc(h->position, sizeof *position * slots);
+        if (!position) return false;
+        memset(position + h->position_cap, 0, sizeof *position * (slots - h->position_cap));
+        h->position = position;
+        h->position_cap = slots;
+    }
+    return true;
+}
+
+/* Emit |root| and its subtree depth-first; children come in entity order */
+static void emit_tree(Hierarchy *h, Entity root) {
+    int *stack = h->stack, top = 0;
+    int first = h->count++;
+    h->nodes[first] = (HierarchyNode){root, -1, 0, 0};
+    int lo = links_lower(h, root);
+    stack[0] = first, stack[1] = lo, stack[2] = lo;
+    while (stack[2] < h->link_count && h->pairs[stack[2]].parent == root) stack[2]++;
+    top = 1;
+
+    while (top) {
+        int *frame = &stack[3 * (top - 1)];
+        if (frame[1] == frame[2]) {
+            h->nodes[frame[0]].descendants = h->count - frame[0] - 1;
+            top--;
+            continue;
+        }
+        Entity child = h->pairs[frame[1]++].child;
+        int node = h->count++;
+        h->nodes[node] = (HierarchyNode){child, frame[0], h->nodes[frame[0]].depth + 1, 0};
+
+        int begin = links_lower(h, child), end = begin;
+        while (end < h->link_count && h->pairs[end].parent == child) end++;
+        int *next = &stack[3 * top++];
+        next[0] = node, next[1] = begin, next[2] = end;
+    }
+}
+
+static void hierarchy_rebuild(Hierarchy *h) {
+    EcsWorld *w = h->world;
+    for (int i = 0; i < h->count; i++)
+        h->position[entity_index(h->nodes[i].entity)] = 0;
+    h->count = 0;
+    h->link_count = 0;
+
+    int rows = ecs_query_count(&h->links, w);
+    if (!scratch_reserve(h, rows)) {
+        LOG_ERROR("Hierarchy: out of memory for %d links", rows);
+        return;
+    }
+    EcsIter it = ecs_query_iter(w, &h->links);
+    while (ecs_iter_next(&it)) {
+        const ChildOf *link = ecs_iter_column(&it, h->child_of);
+        for (int k = 0; k < it.count; k++)
+            h->pairs[h->link_count++] = (HierarchyLink){it.entities[k], link[k].parent};
+    }
+    qsort(h->pairs, h->link_count, sizeof *h->pairs, link_compare);
+
+    /* roots: live parents without a parent of their own, then children
+       whose parent died (unless they are parents, already covered) */
+    for (int i = 0; i < h->link_count; i++) {
+        Entity p = h->pairs[i].parent;
+        if (i && p == h->pairs[i - 1].parent) continue;
+        if (ecs_alive(w, p) && is_root(h, p)) emit_tree(h, p);
+    }
+    for (int i = 0; i < h->link_count; i++) {
+        const HierarchyLink *l = &h->pairs[i];
+        if (!ecs_alive(w, l->parent) && !links_has_children(h, l->child))
+            emit_tree(h, l->child);
+    }
+
+    for (int i = 0; i < h->count; i++)
+        h->position[entity_index(h->nodes[i].entity)] = (Uint32)i + 1;
+}
+
+void hierarchy_update(Hierarchy *h) {
+    if (!h || !h->world) return;
+    EcsWorld *w = h->world;
+
+    bool dirty = ecs_query_count(&h->links, w) != h->link_count;
+    if (!dirty) {
+        h->changed.since = h->since;
+        EcsIter it = ecs_query_iter(w, &h->changed);
+        dirty = ecs_iter_next(&it);
+    }
+    /* a dead root leaves its children's rows untouched */
+    for (int i = 0; !dirty && i < h->count; i += h->nodes[i].descendants + 1)
+        dirty = !ecs_alive(w, h->nodes[i].entity);
+    if (!dirty) return;
+
+    h->since = ecs_version_bump(w);
+    hierarchy_rebuild(h);
+}
+
+/* ─── lookups ─── */
+
+const HierarchyNode *hierarchy_nodes(const Hierarchy *h, int *count) {
+    *count = h ? h->count : 0;
+    return h ? h->nodes : NULL;
+}
+
+int hierarchy_find(const Hierarchy *h, Entity e) {
+    Uint32 index = entity_index(e);
+    if (!h || index >= h->position_cap || !h->position[index]) return -1;
+    int node = (int)h->position[index] - 1;
+    return h->nodes[node].entity == e ? node : -1;
+}
+
+const HierarchyNode *hierarchy_descendants(const Hierarchy *h, Entity e, int *count) {
+    int node = hierarchy_find(h, e);
+    *count = node < 0 ? 0 : h->nodes[node].descendants;
+    return node < 0 ? NULL : &h->nodes[node + 1];
+}
@@ -0,0 +1,74 @@
+#ifndef CONQUEST_HIERARCHY_H
+#define CONQUEST_HIERARCHY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "ecs.h"
+
+/*
+ * Parent/child relationships.
+ *
+ * A child carries a ChildOf component naming its parent; that component is
+ * the only source of truth and can be set like any other. The Hierarchy
+ * keeps a flattened copy of the forest in pre-order: every parent comes
+ * before its children and each subtree is one contiguous run, so
+ * propagating transforms or ownership is a single linear pass and "all
+ * descendants" is a slice.
+ *
+ * The flat order is rebuilt by hierarchy_update only when ChildOf rows
+ * changed (seen through the chunk versions). Children whose parent died
+ * become roots until they are re-attached or destroyed.
+ */
+typedef struct ChildOf {
+    Entity parent;
+} ChildOf;
+
+typedef struct HierarchyNode {
+    Entity entity;
+    int    parent;                /* node index, -1 for roots */
+    int    depth;
+    int    descendants;           /* nodes following in this subtree */
+} HierarchyNode;
+
+typedef struct HierarchyLink {
+    Entity child, parent;
+} HierarchyLink;
+
+typedef struct Hierarchy {
+    EcsWorld      *world;
+    ComponentId    child_of;
+    EcsQuery       links;         /* every ChildOf row */
+    EcsQuery       changed;       /* ChildOf rows stamped since |since| */
+    Uint32         since;
+    int            link_count;    /* ChildOf rows at the last rebuild */
+
+    HierarchyNode *nodes;         /* pre-order */
+    int            count, capacity;
+    Uint32        *position;      /* entity index → node index + 1 */
+    Uint32         position_cap;
+
+    HierarchyLink *pairs;         /* rebuild scratch, kept */
+    int           *stack;
+    int            link_cap;
+} Hierarchy;
+
+/* Registers ChildOf in |world| (or reuses it) */
+bool hierarchy_init(Hierarchy *h, EcsWorld *world);
+void hierarchy_free(Hierarchy *h);
+
+/* Set |child|'s parent. Fails if that would make a cycle */
+bool   hierarchy_attach(Hierarchy *h, Entity child, Entity parent);
+void   hierarchy_detach(Hierarchy *h, Entity child);
+Entity hierarchy_parent(const Hierarchy *h, Entity child);
+
+/* Rebuild the flat order if any link changed since the last call */
+void hierarchy_update(Hierarchy *h);
+
+/* Every node with a parent or children, parents first */
+const HierarchyNode *hierarchy_nodes(const Hierarchy *h, int *count);
+/* Node index of |e|, -1 if it has neither parent nor children */
+int  hierarchy_find(const Hierarchy *h, Entity e);
+/* Contiguous run of |e|'s descendants (children, grandchildren, ...) */
+const HierarchyNode *hierarchy_descendants(const Hierarchy *h, Entity e, int *count);
+
+#endif // CONQUEST_HIERARCHY_H
@@ -0,0 +1,237 @@
+#include "scheduler.h"
+#include "../../utils/log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+EcsScheduler *ecs_scheduler_create(EcsWorld *world, WorkerPool *workers) {
+    if (!world) return NULL;
+    EcsScheduler *s = calloc(1, sizeof *s);
+    if (!s) return NULL;
+    s->world = world;
+    s->workers = workers;
+    if (!s->workers)
+        LOG_WARN("Scheduler: no worker pool, systems run inline");
+    return s;
+}
+
+void ecs_scheduler_destroy(EcsScheduler *s) {
+    if (!s) return;
+    for (int i = 0; i < s->system_count; i++) {
+        ecs_query_free(&s->systems[i].query);
+        for (int j = 0; j < ECS_MAX_SPLITS; j++)
+            ecs_commands_free(&s->systems[i].jobs[j].commands);
+    }
+    free(s);
+}
+
+int ecs_scheduler_add(EcsScheduler *s, const EcsSystemDesc *desc) {
+    if (!s || !desc || !desc->fn) return -1;
+    if (s->system_count == ECS_MAX_SYSTEMS) {
+        LOG_ERROR("Scheduler: more than %d systems", ECS_MAX_SYSTEMS);
+        return -1;
+    }
+    EcsSystem *sys = &s->systems[s->system_count];
+    memset(sys, 0, sizeof *sys);
+    for (int j = 0; j < ECS_MAX_SPLITS; j++)
+        ecs_commands_init(&sys->jobs[j].commands);
+    snprintf(sys->name, sizeof sys->name, "%s", desc->name ? desc->name : "system");
+    ecs_query_init(&sys->query, desc->all, desc->all_count, desc->none, desc->none_count);
+    ecs_query_changed(&sys->query, desc->changed, desc->changed_count);
+
+    /* query terms are read: they decide which rows the system sees */
+    for (int i = 0; i < desc->all_count; i++)  ecs_signature_add(&sys->reads, desc->all[i]);
+    for (int i = 0; i < desc->none_count; i++) ecs_signature_add(&sys->reads, desc->none[i]);
+    for (int i = 0; i < desc->read_count; i++) ecs_signature_add(&sys->reads, desc->reads[i]);
+    for (int i = 0; i < desc->write_count; i++) ecs_signature_add(&sys->writes, desc->writes[i]);
+    for (int i = 0; i < desc->resource_read_count; i++)
+        if (desc->resource_reads[i] < ECS_MAX_RESOURCES)
+            sys->resource_reads |= (Uint64)1 << desc->resource_reads[i];
+    for (int i = 0; i < desc->resource_write_count; i++)
+        if (desc->resource_writes[i] < ECS_MAX_RESOURCES)
+            sys->resource_writes |= (Uint64)1 << desc->resource_writes[i];
+
+    sys->fn = desc->fn;
+    sys->userdata = desc->userdata;
+    sys->serial = desc->serial;
+    sys->enabled = true;
+    return s->system_count++;
+}
+
+void ecs_scheduler_set_enabled(EcsScheduler *s, SystemId id, bool enabled) {
+    if (s && id < s->system_count) s->systems[id].enabled = enabled;
+}
+
+/* ─── execution ─── */
+
+static bool systems_conflict(const EcsSystem *a, const EcsSystem *b) {
+    return ecs_signature_intersects(&a->writes, &b->writes) ||
+           ecs_signature_intersects(&a->writes, &b->reads) ||
+           ecs_signature_intersects(&a->reads, &b->writes) ||
+           (a->resource_writes & (b->resource_writes | b->resource_reads)) ||
+           (a->resource_reads & b->resource_writes);
+}
+
+static void system_launch(EcsScheduler *s, EcsSystem *sys);
+
+static int elapsed_us(Uint64 start) {
+    Uint64 ticks = SDL_GetPerformanceCounter() - start;
+    return (int)(ticks * 1000000 / SDL_GetPerformanceFrequency());
+}
+
+/* Move this run's callback time into every system's ring */
+static void timings_record(EcsScheduler *s) {
+    int slot = (int)(s->runs++ % ECS_TIMING_FRAMES);
+    for (int i = 0; i < s->system_count; i++) {
+        EcsSystem *sys = &s->systems[i];
+        sys->timings[slot] = SDL_AtomicSet(&sys->busy_us, 0) / 1000.0f;
+    }
+}
+
+static void system_done(EcsScheduler *s, EcsSystem *sys) {
+    for (Uint64 m = sys->unlocks; m; m &= m - 1) {
+        EcsSystem *next = &s->systems[__builtin_ctzll(m)];
+        if (SDL_AtomicAdd(&next->waiting, -1) == 1)
+            system_launch(s, next);
+    }
+}
+
+static void system_job(void *userdata) {
+    EcsJob *job = userdata;
+    EcsScheduler *s = job->scheduler;
+    EcsSystem *sys = &s->systems[job->system];
+    EcsIter it = job->end < 0
+        ? ecs_query_iter(s->world, &sys->query)
+        : ecs_query_iter_range(s->world, &sys->query, job->begin, job->end);
+    it.commands = &job->commands;
+    it.version = sys->version;
+    Uint64 start = SDL_GetPerformanceCounter();
+    while (ecs_iter_next(&it))
+        sys->fn(&it, s->dt, sys->userdata);
+    SDL_AtomicAdd(&sys->busy_us, elapsed_us(start));
+    if (SDL_AtomicAdd(&sys->jobs_left, -1) == 1)
+        system_done(s, sys);
+}
+
+static void system_launch(EcsScheduler *s, EcsSystem *sys) {
+    if (!sys->job_count) {
+        system_done(s, sys);
+        return;
+    }
+    /* the last job may finish (and release dependents) before the loop ends */
+    int count = sys->job_count;
+    for (int i = 0; i < count; i++)
+        if (worker_pool_submit_batch(s->workers, &s->jobs, system_job, &sys->jobs[i]) != 0)
+            system_job(&sys->jobs[i]);
+}
+
+/* Chunk ranges of roughly equal size, one job each */
+static void system_plan(EcsScheduler *s, SystemId id) {
+    EcsSystem *sys = &s->systems[id];
+    ecs_query_update(&sys->query, s->world);
+    EcsIter probe = ecs_query_iter(s->world, &sys->query);
+    int chunks = ecs_query_chunk_count(&sys->query);
+
+    int splits = chunks / ECS_SPLIT_MIN_CHUNKS;
+    int most = worker_pool_thread_count(s->workers) * 4;
+    if (splits > most) splits = most;
+    if (splits > ECS_MAX_SPLITS) splits = ECS_MAX_SPLITS;
+    if (splits < 1 || sys->serial || probe.driver) splits = 1;
+
+    sys->job_count = chunks || probe.driver ? splits : 0;
+    for (int i = 0; i < sys->job_count; i++) {
+        EcsJob *job = &sys->jobs[i];
+        job->scheduler = s;
+        job->system = id;
+        job->begin = (int)((Sint64)chunks * i / splits);
+        job->end = probe.driver ? -1 : (int)((Sint64)chunks * (i + 1) / splits);
+    }
+    SDL_AtomicSet(&sys->jobs_left, sys->job_count);
+}
+
+/* Ranges are in chunk order, so this is the order a single thread would
+   have recorded in */
+static void commands_play(EcsScheduler *s) {
+    for (int i = 0; i < s->system_count; i++) {
+        EcsSystem *sys = &s->systems[i];
+        for (int j = 0; j < sys->job_count; j++)
+            if (sys->jobs[j].commands.count)
+                ecs_commands_play(&sys->jobs[j].commands, s->world);
+    }
+}
+
+/* Changes since the system's previous run, stamped with a new version */
+static void system_version(EcsScheduler *s, EcsSystem *sys) {
+    sys->query.since = sys->version;
+    sys->version = ++s->world->version;
+}
+
+void ecs_scheduler_run(EcsScheduler *s, float dt) {
+    if (!s || !s->system_count) return;
+    s->dt = dt;
+    ecs_events_swap(s->world);
+
+    if (!s->workers) {
+        for (int i = 0; i < s->system_count; i++) {
+            EcsSystem *sys = &s->systems[i];
+            sys->job_count = 0;
+            if (!sys->enabled) continue;
+            system_version(s, sys);
+            EcsIter it = ecs_query_iter(s->world, &sys->query);
+            it.commands = &sys->jobs[0].commands;
+            it.version = sys->version;
+            Uint64 start = SDL_GetPerformanceCounter();
+            while (ecs_iter_next(&it))
+                sys->fn(&it, dt, sys->userdata);
+            SDL_AtomicSet(&sys->busy_us, elapsed_us(start));
+            sys->job_count = 1;
+        }
+        timings_record(s);
+        s->world->version++;              /* playback onwards is newer than every run */
+        commands_play(s);
+        return;
+    }
+
+    /* an edge from every earlier conflicting system keeps their order */
+    for (int i = 0; i < s->system_count; i++) {
+        EcsSystem *sys = &s->systems[i];
+        sys->unlocks = 0;
+        sys->job_count = 0;
+        if (!sys->enabled) continue;
+        int waiting = 0;
+        for (int j = 0; j < i; j++) {
+            EcsSystem *prev = &s->systems[j];
+            if (prev->enabled && systems_conflict(prev, sys)) {
+                prev->unlocks |= (Uint64)1 << i;
+                waiting++;
+            }
+        }
+        SDL_AtomicSet(&sys->waiting, waiting);
+        system_version(s, sys);
+        system_plan(s, (SystemId)i);
+    }
+
+    /* roots are picked before any job can bring another count to zero */
+    Uint64 roots = 0;
+    for (int i = 0; i < s->system_count; i++)
+        if (s->systems[i].enabled && SDL_AtomicGet(&s->systems[i].waiting) == 0)
+            roots |= (Uint64)1 << i;
+    for (Uint64 m = roots; m; m &= m - 1)
+        system_launch(s, &s->systems[__builtin_ctzll(m)]);
+    worker_pool_wait_batch(s->workers, &s->jobs);   /* not the asset decodes */
+    timings_record(s);
+    s->world->version++;
+    commands_play(s);
+}
+
+void ecs_scheduler_timing(const EcsScheduler *s, SystemId id, float *avg, float *peak) {
+    *avg = *peak = 0.0f;
+    if (!s || id >= s->system_count || !s->runs) return;
+    const EcsSystem *sys = &s->systems[id];
+    int n = s->runs < ECS_TIMING_FRAMES ? (int)s->runs : ECS_TIMING_FRAMES;
+    for (int i = 0; i < n; i++) {
+        *avg += sys->timings[i];
+        if (sys->timings[i] > *peak) *peak = sys->timings[i];
+    }
+    *avg /= n;
+}
@@ -0,0 +1,117 @@
+#ifndef CONQUEST_SCHEDULER_H
+#define CONQUEST_SCHEDULER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "ecs.h"
+#include "command_buffer.h"
+#include "../../core/jobs/worker_pool.h"
+
+/*
+ * Parallel system scheduler.
+ *
+ * A system is a query plus a callback run on every matching run of rows.
+ * Each declares the components and world resources it reads and writes;
+ * two systems conflict when one writes what the other touches. Every
+ * frame the scheduler links each system to the earlier-registered systems
+ * it conflicts with, starts the ones with nothing to wait for on the
+ * worker pool, and a system's last job releases its dependents – so
+ * non-conflicting systems overlap and conflicting ones keep registration
+ * order.
+ *
+ * Each run gets a fresh world version per system: columns written through
+ * ECS_COLUMN_MUT are stamped with it, and a system's "changed" terms see
+ * chunks stamped since its own previous run. Added/removed event streams
+ * are swapped at the start of a run, so systems see what the previous
+ * frame's command buffers (and anything in between) did.
+ *
+ * Queries over many chunks are split into chunk ranges, one job each.
+ * Systems only touch component data while running; structural changes go
+ * through it->commands, a buffer per job played back once every system has
+ * finished.
+ *
+ * The time spent in each system's callbacks (summed over its jobs) is kept
+ * for the last ECS_TIMING_FRAMES runs, for profiling overlays.
+ */
+_Static_assert(ECS_MAX_RESOURCES <= 64, "resource access is a 64-bit mask");
+
+#define ECS_MAX_SYSTEMS      64
+#define ECS_MAX_SPLITS       64   /* jobs per system */
+#define ECS_SPLIT_MIN_CHUNKS 4    /* chunks worth a job of their own */
+#define ECS_TIMING_FRAMES    120  /* runs kept per system */
+
+typedef Uint8 SystemId;
+
+typedef void (*EcsSystemFn)(EcsIter *it, float dt, void *userdata);
+
+typedef struct EcsSystemDesc {
+    const char        *name;
+    const ComponentId *all;    int all_count;      /* query terms, read */
+    const ComponentId *none;   int none_count;
+    const ComponentId *writes; int write_count;    /* changed components */
+    const ComponentId *reads;  int read_count;     /* read outside the query */
+    const ComponentId *changed; int changed_count; /* skip chunks without */
+    const ResourceId  *resource_reads;  int resource_read_count;
+    const ResourceId  *resource_writes; int resource_write_count;
+    EcsSystemFn        fn;
+    void              *userdata;
+    bool               serial;    /* never split across threads */
+} EcsSystemDesc;
+
+typedef struct EcsScheduler EcsScheduler;
+
+typedef struct EcsJob {
+    EcsScheduler *scheduler;
+    SystemId      system;
+    int           begin, end;     /* chunk range, end < 0: whole query */
+    EcsCommands   commands;
+} EcsJob;
+
+typedef struct EcsSystem {
+    char         name[32];
+    EcsQuery     query;
+    EcsSignature reads, writes;
+    Uint64       resource_reads, resource_writes;   /* bit per ResourceId */
+    EcsSystemFn  fn;
+    void        *userdata;
+    bool         serial, enabled;
+    Uint32       version;         /* world version of the latest run */
+    float        timings[ECS_TIMING_FRAMES];   /* ms per run, ring */
+
+    /* rebuilt every run */
+    Uint64       unlocks;         /* systems waiting on this one */
+    SDL_atomic_t waiting;         /* unfinished systems this waits on */
+    SDL_atomic_t jobs_left;
+    SDL_atomic_t busy_us;         /* callback time over all jobs */
+    int          job_count;
+    EcsJob       jobs[ECS_MAX_SPLITS];
+} EcsSystem;
+
+struct EcsScheduler {
+    EcsWorld   *world;
+    WorkerPool *workers;          /* borrowed; NULL: systems run in order inline */
+    WorkerBatch jobs;             /* this run's jobs in that shared pool */
+    EcsSystem   systems[ECS_MAX_SYSTEMS];
+    int         system_count;
+    float       dt;               /* of the current run */
+    Uint32      runs;             /* completed, indexes the timing rings */
+};
+
+/* Systems run on |workers| (borrowed, e.g. the RenderService pool, and
+   outliving the scheduler) or inline in order when it is NULL */
+EcsScheduler *ecs_scheduler_create(EcsWorld *world, WorkerPool *workers);
+void          ecs_scheduler_destroy(EcsScheduler *s);
+
+/* Returns the id or -1 when full */
+int  ecs_scheduler_add(EcsScheduler *s, const EcsSystemDesc *desc);
+void ecs_scheduler_set_enabled(EcsScheduler *s, SystemId id, bool enabled);
+
+/* Run every enabled system once, wait for them all, then play their
+   command buffers in system order. Does nothing, event swap included,
+   while no system is registered */
+void ecs_scheduler_run(EcsScheduler *s, float dt);
+
+/* Average and worst time (ms) of |id| over the runs still in its ring */
+void ecs_scheduler_timing(const EcsScheduler *s, SystemId id, float *avg, float *peak);
+
+#endif // CONQUEST_SCHEDULER_H
@@ -0,0 +1,236 @@
+#include "snapshot.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+void ecs_snapshot_init(EcsSnapshot *s, EcsWorld *world) {
+    memset(s, 0, sizeof *s);
+    s->world = world;
+}
+
+void ecs_snapshot_free(EcsSnapshot *s) {
+    if (!s) return;
+    for (int i = 0; i < s->archetype_cap; i++) {      /* a failed take may reach past count */
+        SnapshotArchetype *sa = &s->archetypes[i];
+        for (int c = 0; c < sa->chunk_cap; c++)
+            free(sa->chunks[c]);
+        free(sa->chunks);
+        free(sa->counts);
+    }
+    free(s->archetypes);
+    for (int i = 0; i < ECS_MAX_COMPONENTS; i++) {
+        free(s->pools[i].dense);
+        free(s->pools[i].data);
+    }
+    for (int i = 0; i < ECS_MAX_RESOURCES; i++)
+        free(s->resources[i]);
+    entity_table_free(&s->entities);
+    memset(s, 0, sizeof *s);
+}
+
+/* Newest version of any column of |c|, the entity column included */
+static Uint32 chunk_version(const EcsArchetype *a, const EcsChunk *c) {
+    Uint32 newest = 0;
+    for (int i = 0; i <= a->component_count; i++)
+        if (c->versions[i] > newest) newest = c->versions[i];
+    return newest;
+}
+
+/* |c| still holds what the snapshot copied as |count| rows */
+static bool chunk_unchanged(const EcsSnapshot *s, const EcsArchetype *a,
+                            const EcsChunk *c, int count) {
+    return c->count == count && chunk_version(a, c) <= s->since;
+}
+
+static bool table_copy(EntityTable *dst, const EntityTable *src) {
+    if (src->count > dst->capacity) {
+        EntityRecord *records = realloc(dst->records, sizeof *records * src->count);
+        if (!records) return false;
+        dst->records = records;
+        dst->capacity = src->count;
+    }
+    if (src->count) memcpy(dst->records, src->records, sizeof *src->records * src->count);
+    dst->count = src->count;
+    dst->free_head = src->free_head;
+    dst->free_tail = src->free_tail;
+    dst->free_count = src->free_count;
+    dst->alive = src->alive;
+    return true;
+}
+
+/* ─── taking ─── */
+
+static bool archetypes_reserve(EcsSnapshot *s, int count) {
+    if (count <= s->archetype_cap) return true;
+    int cap = s->archetype_cap ? s->archetype_cap * 2 : 16;
+    while (cap < count) cap *= 2;
+    SnapshotArchetype *list = realloc(s->archetypes, sizeof *list * cap);
+    if (!list) return false;
+    memset(list + s->archetype_cap, 0, sizeof *list * (cap - s->archetype_cap));
+    s->archetypes = list;
+    s->archetype_cap = cap;
+    return true;
+}
+
+static bool chunks_reserve(SnapshotArchetype *sa, int count, Uint32 bytes) {
+    if (count > sa->chunk_cap) {
+        int cap = sa->chunk_cap ? sa->chunk_cap * 2 : 4;
+        while (cap < count) cap *= 2;
+        Uint8 **chunks = realloc(sa->chunks, sizeof *chunks * cap);
+        if (chunks) sa->chunks = chunks;
+        int *counts = realloc(sa->counts, sizeof *counts * cap);
+        if (counts) sa->counts = counts;
+        if (!chunks || !counts) return false;
+        memset(chunks + sa->chunk_cap, 0, sizeof *chunks * (cap - sa->chunk_cap));
+        memset(counts + sa->chunk_cap, 0, sizeof *counts * (cap - sa->chunk_cap));
+        sa->chunk_cap = cap;
+    }
+    for (int i = 0; i < count; i++)
+        if (!sa->chunks[i] && !(sa->chunks[i] = malloc(bytes))) return false;
+    return true;
+}
+
+static bool archetype_take(EcsSnapshot *s, const EcsArchetype *a, SnapshotArchetype *sa,
+                           bool incremental) {
+    if (!chunks_reserve(sa, a->chunk_count, a->chunk_bytes)) return false;
+    for (int i = 0; i < a->chunk_count; i++) {
+        const EcsChunk *c = &a->chunks[i];
+        if (incremental && i < sa->chunk_count && chunk_unchanged(s, a, c, sa->counts[i]))
+            continue;
+        memcpy(sa->chunks[i], c->data, a->chunk_bytes);
+        sa->counts[i] = c->count;
+        s->copied++;
+    }
+    sa->chunk_count = a->chunk_count;
+    sa->entity_count = a->entity_count;
+    return true;
+}
+
+static bool pool_take(SnapshotPool *p, const SparseSet *set) {
+    if (set->count > p->capacity) {
+        Entity *dense = realloc(p->dense, sizeof *dense * set->count);
+        if (dense) p->dense = dense;
+        Uint8 *data = realloc(p->data, (size_t)set->size * set->count + 1);
+        if (data) p->data = data;
+        if (!dense || !data) return false;
+        p->capacity = set->count;
+    }
+    if (set->count) {
+        memcpy(p->dense, set->dense, sizeof *p->dense * set->count);
+        memcpy(p->data, set->data, (size_t)set->size * set->count);
+    }
+    p->count = set->count;
+    p->used = true;
+    return true;
+}
+
+static bool resource_take(EcsSnapshot *s, const EcsWorld *w, int id) {
+    const EcsResource *r = &w->resources[id];
+    if (!r->size) {                       /* borrowed or empty */
+        free(s->resources[id]);
+        s->resources[id] = NULL;
+        s->resource_sizes[id] = 0;
+        return true;
+    }
+    if (s->resource_sizes[id] != r->size) {
+        void *copy = realloc(s->resources[id], r->size);
+        if (!copy) return false;
+        s->resources[id] = copy;
+        s->resource_sizes[id] = r->size;
+    }
+    memcpy(s->resources[id], r->data, r->size);
+    return true;
+}
+
+bool ecs_snapshot_take(EcsSnapshot *s) {
+    if (!s || !s->world) return false;
+    EcsWorld *w = s->world;
+    bool incremental = s->taken;
+    s->taken = false;
+    s->copied = 0;
+
+    bool ok = table_copy(&s->entities, &w->entities) &&
+              archetypes_reserve(s, w->archetype_count);
+    for (int i = 0; ok && i < w->archetype_count; i++)
+        ok = archetype_take(s, w->archetypes[i], &s->archetypes[i], incremental);
+    if (ok) s->archetype_count = w->archetype_count;
+    for (int i = 0; ok && i < ECS_MAX_COMPONENTS; i++) {
+        s->pools[i].used = false;
+        if (w->sparse[i]) ok = pool_take(&s->pools[i], w->sparse[i]);
+    }
+    for (int i = 0; ok && i < ECS_MAX_RESOURCES; i++)
+        ok = resource_take(s, w, i);
+    if (!ok) {
+        LOG_ERROR("Snapshot: out of memory taking %u entities", w->entities.alive);
+        return false;
+    }
+
+    s->since = ecs_version_bump(w);
+    s->taken = true;
+    return true;
+}
+
+/* ─── restoring ─── */
+
+static bool archetype_restore(EcsSnapshot *s, EcsArchetype *a, const SnapshotArchetype *sa) {
+    EcsWorld *w = s->world;
+    if (!ecs_archetype_reserve(a, sa->chunk_count)) return false;
+    for (int i = 0; i < sa->chunk_count; i++) {
+        EcsChunk *c = &a->chunks[i];
+        if (i < a->chunk_count && chunk_unchanged(s, a, c, sa->counts[i])) continue;
+        memcpy(c->data, sa->chunks[i], a->chunk_bytes);
+        c->count = sa->counts[i];
+        for (int k = 0; k <= a->component_count; k++)
+            c->versions[k] = w->version;
+        s->copied++;
+    }
+    a->chunk_count = sa->chunk_count;
+    a->entity_count = sa->entity_count;
+    return true;
+}
+
+static bool pool_restore(SparseSet *set, const SnapshotPool *p) {
+    sparse_set_clear(set);
+    if (!p->used) return true;            /* registered after the take */
+    for (int i = 0; i < p->count; i++) {
+        void *slot = sparse_set_add(set, p->dense[i]);
+        if (!slot) return false;
+        memcpy(slot, p->data + (size_t)set->size * i, set->size);
+    }
+    return true;
+}
+
+bool ecs_snapshot_restore(EcsSnapshot *s) {
+    if (!s || !s->world || !s->taken) return false;
+    EcsWorld *w = s->world;
+    s->copied = 0;
+    ecs_version_bump(w);                  /* stamp for the restored chunks */
+
+    bool ok = table_copy(&w->entities, &s->entities);
+    for (int i = 0; ok && i < w->archetype_count; i++) {
+        EcsArchetype *a = w->archetypes[i];
+        if (i < s->archetype_count) {
+            ok = archetype_restore(s, a, &s->archetypes[i]);
+        } else {                          /* created after the take */
+            a->chunk_count = 0;
+            a->entity_count = 0;
+        }
+    }
+    for (int i = 0; ok && i < ECS_MAX_COMPONENTS; i++)
+        if (w->sparse[i]) ok = pool_restore(w->sparse[i], &s->pools[i]);
+    if (!ok) {
+        LOG_ERROR("Snapshot: out of memory restoring %u entities", s->entities.alive);
+        return false;
+    }
+
+    for (int i = 0; i < ECS_MAX_RESOURCES; i++)
+        if (s->resources[i] && w->resources[i].size == s->resource_sizes[i])
+            memcpy(w->resources[i].data, s->resources[i], s->resource_sizes[i]);
+    ecs_events_swap(w);                   /* both sides emptied */
+    ecs_events_swap(w);
+
+    /* the world matches the snapshot again, restored chunks included, so
+       the next take or restore can skip everything left untouched */
+    s->since = ecs_version_bump(w);
+    return true;
+}
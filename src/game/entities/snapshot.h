@@ -0,0 +1,64 @@
+#ifndef CONQUEST_SNAPSHOT_H
+#define CONQUEST_SNAPSHOT_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "ecs.h"
+
+/*
+ * World snapshots for rollback.
+ *
+ * A snapshot holds a copy of every archetype chunk, the entity table, the
+ * sparse pools and the world-owned resources. Taking one again into the same
+ * EcsSnapshot is incremental: a chunk whose versions are no newer than the
+ * previous take and whose row count is the same still matches its copy and
+ * is skipped. Restoring works the same way in reverse, copying back only the
+ * chunks that moved on since the snapshot, then stamping them with a fresh
+ * world version so "changed" queries and the hierarchy see the rollback.
+ *
+ * Only stamped writes are seen (ecs_set, ecs_get_mut, ECS_COLUMN_MUT and
+ * structural changes); bytes written through ecs_get or ECS_COLUMN go
+ * unnoticed until the chunk is stamped for another reason. Borrowed
+ * resources belong to someone else and are left alone, and event streams
+ * are emptied on restore since they describe the abandoned frames.
+ */
+typedef struct SnapshotArchetype {
+    Uint8 **chunks;               /* chunk_bytes each, kept between takes */
+    int    *counts;
+    int     chunk_count, chunk_cap;
+    int     entity_count;
+} SnapshotArchetype;
+
+typedef struct SnapshotPool {
+    bool    used;                 /* the component was sparse when taken */
+    Entity *dense;
+    Uint8  *data;
+    int     count, capacity;
+} SnapshotPool;
+
+typedef struct EcsSnapshot {
+    EcsWorld          *world;
+    bool               taken;
+    Uint32             since;     /* world version when taken */
+
+    EntityTable        entities;  /* copy of the table, records included */
+    SnapshotArchetype *archetypes;
+    int                archetype_count, archetype_cap;
+    SnapshotPool       pools[ECS_MAX_COMPONENTS];
+    void              *resources[ECS_MAX_RESOURCES];   /* owned ones only */
+    Uint32             resource_sizes[ECS_MAX_RESOURCES];
+
+    int                copied;    /* chunks copied by the last take/restore */
+} EcsSnapshot;
+
+void ecs_snapshot_init(EcsSnapshot *s, EcsWorld *world);
+void ecs_snapshot_free(EcsSnapshot *s);
+
+/* Capture the world; only what changed is copied after the first take.
+   False when out of memory, which leaves the snapshot unusable until the
+   next successful take */
+bool ecs_snapshot_take(EcsSnapshot *s);
+/* Put the world back as it was at the last take. Not during a query */
+bool ecs_snapshot_restore(EcsSnapshot *s);
+
+#endif // CONQUEST_SNAPSHOT_H
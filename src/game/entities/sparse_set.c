@@ -0,0 +1,123 @@
+#include "sparse_set.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SPARSE_MIN_CAPACITY 64
+
+void sparse_set_init(SparseSet *set, Uint32 size) {
+    memset(set, 0, sizeof *set);
+    set->size = size;
+}
+
+void sparse_set_free(SparseSet *set) {
+    if (!set) return;
+    for (int i = 0; i < set->page_count; i++)
+        free(set->pages[i]);
+    free(set->pages);
+    free(set->dense);
+    free(set->data);
+    memset(set, 0, sizeof *set);
+}
+
+static Uint32 *sparse_slot(const SparseSet *set, Uint32 index) {
+    int page = (int)(index >> SPARSE_PAGE_BITS);
+    if (page >= set->page_count || !set->pages[page]) return NULL;
+    return &set->pages[page][index & (SPARSE_PAGE_SIZE - 1)];
+}
+
+static Uint32 *sparse_slot_make(SparseSet *set, Uint32 index) {
+    int page = (int)(index >> SPARSE_PAGE_BITS);
+    if (page >= set->page_count) {
+        int count = page + 1;
+        Uint32 **pages = realloc(set->pages, sizeof *pages * count);
+        if (!pages) return NULL;
+        memset(pages + set->page_count, 0, sizeof *pages * (count - set->page_count));
+        set->pages = pages;
+        set->page_count = count;
+    }
+    if (!set->pages[page]) {
+        set->pages[page] = calloc(SPARSE_PAGE_SIZE, sizeof **set->pages);
+        if (!set->pages[page]) return NULL;
+    }
+    return &set->pages[page][index & (SPARSE_PAGE_SIZE - 1)];
+}
+
+/* Tags (size 0) have no data; the dense entry stands in as a non-NULL slot */
+static void *value_at(const SparseSet *set, int at) {
+    return set->size ? (void *)(set->data + (size_t)set->size * at)
+                     : (void *)&set->dense[at];
+}
+
+static bool dense_grow(SparseSet *set) {
+    if (set->count < set->capacity) return true;
+    int cap = set->capacity ? set->capacity * 2 : SPARSE_MIN_CAPACITY;
+    Entity *dense = realloc(set->dense, sizeof *dense * cap);
+    if (dense) set->dense = dense;
+    Uint8 *data = set->size ? realloc(set->data, (size_t)set->size * cap) : set->data;
+    if (data) set->data = data;
+    if (!dense || (set->size && !data)) {
+        LOG_ERROR("SparseSet: out of memory growing to %d", cap);
+        return false;
+    }
+    set->capacity = cap;
+    return true;
+}
+
+void *sparse_set_add(SparseSet *set, Entity e) {
+    Uint32 index = entity_index(e);
+    Uint32 *slot = sparse_slot_make(set, index);
+    if (!slot) return NULL;
+    if (*slot) {
+        set->dense[*slot - 1] = e;
+        return value_at(set, (int)*slot - 1);
+    }
+    if (!dense_grow(set)) return NULL;
+    int at = set->count++;
+    set->dense[at] = e;
+    *slot = (Uint32)at + 1;
+    void *value = value_at(set, at);
+    if (set->size) memset(value, 0, set->size);
+    return value;
+}
+
+bool sparse_set_remove(SparseSet *set, Entity e) {
+    Uint32 *slot = sparse_slot(set, entity_index(e));
+    if (!slot || !*slot) return false;
+    int at = (int)*slot - 1, last = set->count - 1;
+    if (at != last) {
+        Entity moved = set->dense[last];
+        set->dense[at] = moved;
+        if (set->size)
+            memcpy(set->data + (size_t)set->size * at,
+                   set->data + (size_t)set->size * last, set->size);
+        *sparse_slot(set, entity_index(moved)) = (Uint32)at + 1;
+    }
+    *slot = 0;
+    set->count--;
+    return true;
+}
+
+void *sparse_set_get(const SparseSet *set, Entity e) {
+    Uint32 *slot = sparse_slot(set, entity_index(e));
+    if (!slot || !*slot) return NULL;
+    return value_at(set, (int)*slot - 1);
+}
+
+bool sparse_set_has(const SparseSet *set, Entity e) {
+    Uint32 *slot = sparse_slot(set, entity_index(e));
+    return slot && *slot;
+}
+
+void sparse_set_clear(SparseSet *set) {
+    for (int i = 0; i < set->count; i++)
+        *sparse_slot(set, entity_index(set->dense[i])) = 0;
+    set->count = 0;
+}
+
+size_t sparse_set_bytes(const SparseSet *set) {
+    size_t bytes = (size_t)set->capacity * (sizeof(Entity) + set->size);
+    for (int i = 0; i < set->page_count; i++)
+        if (set->pages[i]) bytes += SPARSE_PAGE_SIZE * sizeof(Uint32);
+    return bytes;
+}
@@ -0,0 +1,43 @@
+#ifndef CONQUEST_SPARSE_SET_H
+#define CONQUEST_SPARSE_SET_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "entity.h"
+
+/*
+ * Sparse-set component pool.
+ *
+ * A paged sparse array maps an entity's slot index to a position in the
+ * dense arrays, which hold the owning entities and their component values
+ * packed together. Add and remove are O(1) – removal moves the last dense
+ * element into the hole – and iterating walks the dense arrays linearly.
+ * Memory follows the number of components, not the highest entity index.
+ */
+#define SPARSE_PAGE_BITS 12
+#define SPARSE_PAGE_SIZE (1 << SPARSE_PAGE_BITS)
+
+typedef struct SparseSet {
+    Uint32 **pages;          /* entity index → dense index + 1, 0: absent */
+    int      page_count;
+    Entity  *dense;
+    Uint8   *data;           /* |size| bytes per dense entry */
+    Uint32   size;
+    int      count, capacity;
+} SparseSet;
+
+void  sparse_set_init(SparseSet *set, Uint32 size);
+void  sparse_set_free(SparseSet *set);
+
+/* Slot for |e| (zeroed if new), NULL when out of memory */
+void *sparse_set_add(SparseSet *set, Entity e);
+bool  sparse_set_remove(SparseSet *set, Entity e);
+/* Component of |e|, NULL if absent. Only the slot index is compared: the
+   owner keeps stale handles out */
+void *sparse_set_get(const SparseSet *set, Entity e);
+bool  sparse_set_has(const SparseSet *set, Entity e);
+void  sparse_set_clear(SparseSet *set);
+/* Memory held: dense arrays at capacity plus the allocated pages */
+size_t sparse_set_bytes(const SparseSet *set);
+
+#endif // CONQUEST_SPARSE_SET_H
@@ -0,0 +1,51 @@
+#include "world_components.h"
+#include "world_resources.h"
+#include "blueprint.h"
+#include "../../utils/log.h"
+#include <stdlib.h>
+
+/* Ids must come out as the enum values: nothing may register before us */
+static bool register_as(EcsWorld *w, int expected, const char *name, Uint32 size,
+                        Uint32 align) {
+    int id = ecs_register_component(w, name, size, align, ECS_STORAGE_TABLE);
+    if (id != expected) {
+        LOG_ERROR("World: component %s registered as %d, expected %d", name, id, expected);
+        return false;
+    }
+    return true;
+}
+
+static void register_fields(BlueprintLibrary *lib) {
+    BLUEPRINT_FIELD(lib, COMP_POSITION, Position, x, FIELD_FLOAT);
+    BLUEPRINT_FIELD(lib, COMP_POSITION, Position, y, FIELD_FLOAT);
+    BLUEPRINT_FIELD(lib, COMP_HEALTH, Health, hp, FIELD_INT);
+    BLUEPRINT_FIELD(lib, COMP_HEALTH, Health, max, FIELD_INT);
+    BLUEPRINT_FIELD(lib, COMP_GLYPH, Glyph, ch, FIELD_U8);
+    BLUEPRINT_FIELD(lib, COMP_GLYPH, Glyph, fg, FIELD_U32);
+}
+
+bool world_components_init(EcsWorld *world, const char *blueprint_path) {
+    if (!world) return false;
+    bool ok = register_as(world, COMP_POSITION, "Position", sizeof(Position),
+                          _Alignof(Position)) &&
+              register_as(world, COMP_HEALTH, "Health", sizeof(Health), _Alignof(Health)) &&
+              register_as(world, COMP_GLYPH, "Glyph", sizeof(Glyph), _Alignof(Glyph)) &&
+              register_as(world, COMP_HOSTILE, "Hostile", 0, 1);
+    if (!ok) return false;
+
+    BlueprintLibrary *lib = malloc(sizeof *lib);
+    if (!lib) return false;
+    blueprint_library_init(lib, world);
+    register_fields(lib);
+    ecs_resource_bind(world, RES_BLUEPRINTS, lib);
+    if (blueprint_path) blueprint_load_file(lib, blueprint_path);
+    return true;
+}
+
+void world_components_shutdown(EcsWorld *world) {
+    BlueprintLibrary *lib = world ? ecs_resource(world, RES_BLUEPRINTS) : NULL;
+    if (!lib) return;
+    ecs_resource_bind(world, RES_BLUEPRINTS, NULL);
+    blueprint_library_free(lib);
+    free(lib);
+}
@@ -0,0 +1,38 @@
+#ifndef CONQUEST_WORLD_COMPONENTS_H
+#define CONQUEST_WORLD_COMPONENTS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "ecs.h"
+
+/*
+ * Components of the game world. They are registered first and in this
+ * order when the world is created, so their ids are the enum values below,
+ * together with the fields the blueprint files may set. The world's
+ * BlueprintLibrary is then loaded and bound as RES_BLUEPRINTS.
+ */
+
+/* Add new world components here, and register them in world_components.c */
+typedef enum {
+    COMP_POSITION,
+    COMP_HEALTH,
+    COMP_GLYPH,
+    COMP_HOSTILE,                 /* tag, no data */
+    COMP_COUNT
+} WorldComponent;
+
+_Static_assert(COMP_COUNT <= ECS_MAX_COMPONENTS, "too many world components");
+
+typedef struct Position { float x, y; } Position;    /* map cells */
+typedef struct Health   { int hp, max; } Health;
+typedef struct Glyph    { Uint8 ch; Uint32 fg; } Glyph;   /* CP437 code, RGBA */
+
+/* Register the components and their blueprint fields on a fresh |world|,
+   then load the blueprints at |blueprint_path|. False only if a component
+   could not be registered; a missing or broken file is logged and leaves
+   the library empty or partial */
+bool world_components_init(EcsWorld *world, const char *blueprint_path);
+/* Free the blueprint library; before ecs_world_destroy */
+void world_components_shutdown(EcsWorld *world);
+
+#endif // CONQUEST_WORLD_COMPONENTS_H
@@ -0,0 +1,21 @@
+#ifndef CONQUEST_WORLD_RESOURCES_H
+#define CONQUEST_WORLD_RESOURCES_H
+
+#include "ecs.h"
+
+/*
+ * Resource ids of the game world. Gameplay systems reach these through
+ * ECS_RESOURCE (one indexed load) instead of svc_get, and list the ones
+ * they touch in their scheduler access declarations.
+ */
+
+/* Add new world resources here as gameplay grows */
+typedef enum {
+    RES_CLOCK,                    /* ClockService, borrowed from the services */
+    RES_BLUEPRINTS,               /* BlueprintLibrary, see world_components.h */
+    RES_COUNT
+} WorldResource;
+
+_Static_assert(RES_COUNT <= ECS_MAX_RESOURCES, "too many world resources");
+
+#endif // CONQUEST_WORLD_RESOURCES_H
@@ -18,11 +18,16 @@ This file is part of the game engine project.
 #include <SDL2/SDL.h>
 #include <string.h>
 #include "../core/resources/resource_manager.h"
+#include "../core/resources/hot_reload.h"
 #include "../core/event/event_bus.h"
 #include "../core/event/event_signals.h"
 #include "../core/cursor/cursor.h"
 #include "../core/clock/clock_service.h"
 #include "../core/render/render_service.h"
+#include "../game/entities/scheduler.h"
+#include "../game/entities/world_resources.h"
+#include "../game/entities/world_components.h"
+#include "../gui/debug/ecs_inspector.h"
 
 // Initialize core game services and register them with the service manager
 int initialize_core_services(GameHandle *gh) {
@@ -46,12 +51,18 @@ int initialize_core_services(GameHandle *gh) {
     SettingsManager *settings = sm_settings_create();
     EventBus *bus = malloc(sizeof(EventBus));
     ResourceManager *resource_manager = resource_manager_create();
-    StateManager *sm = sm_create(ren, win_w, win_h, resource_manager);
+    resource_manager->loader = renderer ? renderer->workers : NULL;   // one pool for all
+    resource_manager->glyphs = renderer_glyphs(renderer);
+    resource_manager_build_atlas(resource_manager, ren);
+    StateManager *sm = sm_create(ren, renderer_glyphs(renderer), win_w, win_h,
+                                 resource_manager);
     InputManager *im = input_create();
     AudioManager *am = am_create(10); // 10 is the max number of audios
     ClockService *clock = clock_service_init();
+    EcsWorld *world = ecs_world_create();
+    EcsScheduler *sched = ecs_scheduler_create(world, renderer ? renderer->workers : NULL);
     
-    if (!sm || !im || !am || !settings || !bus || !renderer) {
+    if (!sm || !im || !am || !settings || !bus || !renderer || !sched) {
         LOG_ERROR("Failed to create game subsystems\n");
         return 0;
     }
@@ -74,6 +85,34 @@ int initialize_core_services(GameHandle *gh) {
     svc_register(gh->services, RESOURCE_MANAGER_SERVICE, resource_manager);
     svc_register(gh->services, CLOCK_SERVICE, clock);
     svc_register(gh->services, RENDER_SERVICE, renderer);
+    svc_register(gh->services, SIMULATION_SERVICE, sched);
+
+    // Gameplay systems reach shared state as world resources
+    ecs_resource_bind(world, RES_CLOCK, clock);
+
+    // Game components first, so their ids match WorldComponent, then the
+    // blueprints that set them
+    if (!world_components_init(world, get_resource_path("data/blueprints.txt"))) {
+        LOG_ERROR("Failed to register the world components\n");
+        return 0;
+    }
+
+    // Post-processing: the vignette is the filter the settings configure
+    float vignette = sm_get_float(settings, "vignette");
+    if (vignette > 0.0f) {
+        post_process_set_vignette(renderer_post(renderer), vignette, 0.5f);
+        post_process_set_enabled(renderer_post(renderer), POST_VIGNETTE, true);
+    }
+
+    // Debug overlay over every state, hidden until toggled
+    EcsInspector *inspector = ecs_inspector_create(renderer, resource_manager, sched);
+    if (inspector) svc_register(gh->services, INSPECTOR_SERVICE, inspector);
+
+    // Developer mode: watch resources/ and swap changed assets in place
+    if (sm_get_bool(settings, "hot_reload")) {
+        HotReload *hr = hot_reload_start(resource_manager);
+        if (hr) svc_register(gh->services, HOT_RELOAD_SERVICE, hr);
+    }
     
     // Set the services for the state manager
     sm_set_services(sm, gh->services);
@@ -81,6 +120,9 @@ int initialize_core_services(GameHandle *gh) {
     // Enter the menu state
     sm_enter(sm, GS_MENU);
     
+    // One-shot sounds share decoded chunks through the resource cache
+    am_set_resource_manager(am, resource_manager);
+
     // Set the audio manager for the state manager's menu
     sm_set_audio_manager(sm, am);
     
@@ -97,15 +139,20 @@ void game_loop(GameHandle *gh) {
     // Access to the services without requesting them every loop?
     InputManager *im = svc_get(gh->services, INPUT_SERVICE);
     StateManager *sm = svc_get(gh->services, STATE_MANAGER_SERVICE);
+    RenderService *R = svc_get(gh->services, RENDER_SERVICE);
 
     SDL_Event e;
-    while (SDL_PollEvent(&e))
+    while (SDL_PollEvent(&e)) {
         // Replace im with getting gh service
         input_handle_event(im, &e);
+        renderer_handle_event(R, &e);
+    }
 
     /* global hot-keys */
     if (input_pressed(im, ACTION_QUIT))
         sm->current_state = get_state_object(sm->states, GS_QUIT);
+    if (input_pressed(im, ACTION_TOGGLE_INSPECTOR))
+        ecs_inspector_toggle(svc_get(gh->services, INSPECTOR_SERVICE));
 
     // Iterate through the computation stack and execute each layer
     comp_stack_execute(gh->stack, gh);
@@ -3,6 +3,7 @@
 #include "../core/cursor/cursor.h"
 #include "../core/services/service_manager.h"
 #include "../core/event/event_bus.h"
+#include "../core/resources/resource_paths.h"
 #include "../utils/log.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
@@ -43,10 +44,11 @@ GameHandle *game_init(void) {
     // Initialize SDL & check for errors
     SDL_CheckErrors();
 
+    // Resolve the base path once and index resources/ for path lookups
+    resource_paths_init();
+
     // Set the working directory to the base path of game
-    char *base = SDL_GetBasePath();
-    chdir(base);
-    SDL_free(base);
+    chdir(resource_paths_base());
 
     /* allocate and populate the handle */
     GameHandle *gh = malloc(sizeof *gh);
@@ -0,0 +1,160 @@
+#include "ecs_inspector.h"
+#include "../../utils/log.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PANEL_X   8.0f
+#define PANEL_Y   8.0f
+#define PANEL_PAD 6.0f
+#define PANEL_LAYER (-1)   /* batch layer under the text (layer 0) */
+
+static const SDL_Color HEADING = {255, 210, 90, 255};
+static const SDL_Color TEXT    = {220, 220, 220, 255};
+static const SDL_Color DIM     = {150, 150, 150, 255};
+static const SDL_Color PANEL   = {0, 0, 0, 190};
+
+typedef struct Pen {
+    float y, width;
+    int   skip;
+} Pen;
+
+/* Queue one formatted line; the batch is flushed after the layer returns */
+static void pen_line(EcsInspector *in, Pen *pen, SDL_Color color, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(in->line, sizeof in->line, fmt, args);
+    va_end(args);
+    float w = glyph_cache_draw(renderer_glyphs(in->renderer), renderer_sprites(in->renderer),
+                               in->font, in->line, PANEL_X + PANEL_PAD, pen->y, color, 0);
+    if (w > pen->width) pen->width = w;
+    pen->y += pen->skip;
+}
+
+/* Indices of the most populated archetypes, largest first. Returns how many */
+static int gather_largest(EcsInspector *in, const EcsWorld *w, int archetypes,
+                          int *populated) {
+    int n = 0, counts[ECS_INSPECTOR_ARCHETYPES];
+    *populated = 0;
+    for (int i = 0; i < archetypes; i++) {
+        int count = ecs_archetype_stats(w, i).entities;
+        if (!count) continue;
+        (*populated)++;
+        int at = n < ECS_INSPECTOR_ARCHETYPES ? n++ : ECS_INSPECTOR_ARCHETYPES;
+        while (at > 0 && counts[at - 1] < count) {
+            if (at < ECS_INSPECTOR_ARCHETYPES) {
+                in->largest[at] = in->largest[at - 1];
+                counts[at] = counts[at - 1];
+            }
+            at--;
+        }
+        if (at < ECS_INSPECTOR_ARCHETYPES) {
+            in->largest[at] = i;
+            counts[at] = count;
+        }
+    }
+    return n;
+}
+
+static void archetype_names(const EcsWorld *w, const EcsArchetypeStats *a,
+                            char *out, size_t size) {
+    size_t used = 0;
+    out[0] = '\0';
+    for (int c = 0; c < a->component_count && used < size; c++) {
+        int n = snprintf(out + used, size - used, "%s%s", c ? " " : "",
+                         ecs_component_info(w, a->components[c])->name);
+        if (n < 0) break;
+        used += (size_t)n;
+    }
+    if (!a->component_count) snprintf(out, size, "(empty)");
+}
+
+static void inspector_render(SDL_Renderer *ren, void *userdata) {
+    (void)ren;
+    EcsInspector *in = userdata;
+    EcsScheduler *s = in->scheduler;
+    const EcsWorld *w = s->world;
+    EcsWorldStats ws = ecs_world_stats(w);
+    Pen pen = {PANEL_Y + PANEL_PAD, 0.0f, TTF_FontLineSkip(in->font)};
+
+    pen_line(in, &pen, HEADING, "ECS  %d entities  %d archetypes  version %u",
+             ws.entities, ws.archetypes, ws.version);
+    const RenderStats *rs = renderer_stats(in->renderer);
+    pen_line(in, &pen, DIM, "Render  %d layers  %d items drawn  %d culled",
+             rs->layers, rs->items_drawn, rs->items_culled);
+
+    /* archetypes */
+    int populated;
+    int shown = gather_largest(in, w, ws.archetypes, &populated);
+    pen_line(in, &pen, HEADING, "Archetypes      entities  chunks      KB");
+    char names[96];
+    for (int i = 0; i < shown; i++) {
+        EcsArchetypeStats a = ecs_archetype_stats(w, in->largest[i]);
+        archetype_names(w, &a, names, sizeof names);
+        pen_line(in, &pen, TEXT, "  #%-4d %9d %7d %7zu   %s", a.id, a.entities,
+                 a.chunks, a.bytes / 1024, names);
+    }
+    if (populated > shown)
+        pen_line(in, &pen, DIM, "  ... %d more", populated - shown);
+
+    /* pools */
+    ecs_component_stats(w, in->components);
+    pen_line(in, &pen, HEADING, "Components      entities      KB");
+    for (int id = 0; id < ws.components; id++) {
+        const EcsComponentStats *c = &in->components[id];
+        pen_line(in, &pen, c->sparse ? DIM : TEXT, "  %-14.14s %8d %7zu%s",
+                 ecs_component_info(w, (ComponentId)id)->name, c->entities,
+                 c->bytes / 1024, c->sparse ? "  sparse" : "");
+    }
+
+    /* systems */
+    int frames = s->runs < ECS_TIMING_FRAMES ? (int)s->runs : ECS_TIMING_FRAMES;
+    pen_line(in, &pen, HEADING, "Systems         avg ms  max ms   (last %d runs)", frames);
+    for (int i = 0; i < s->system_count; i++) {
+        float avg, peak;
+        ecs_scheduler_timing(s, (SystemId)i, &avg, &peak);
+        pen_line(in, &pen, s->systems[i].enabled ? TEXT : DIM, "  %-14.14s %6.3f  %6.3f",
+                 s->systems[i].name, avg, peak);
+    }
+
+    /* the panel goes in the same batch one layer below the glyphs, so it
+       is under them whatever order the two were queued in */
+    SDL_FRect panel = {PANEL_X, PANEL_Y, pen.width + 2 * PANEL_PAD,
+                       pen.y - PANEL_Y + PANEL_PAD};
+    sprite_batch_fill(renderer_sprites(in->renderer), &panel, PANEL, PANEL_LAYER);
+}
+
+/* ─── lifecycle ─── */
+
+EcsInspector *ecs_inspector_create(RenderService *R, ResourceManager *rm,
+                                   EcsScheduler *scheduler) {
+    if (!R || !rm || !scheduler) return NULL;
+    TTF_Font *font = load_font(rm, "OpenSans-Regular.ttf", ECS_INSPECTOR_FONT_SIZE);
+    if (!font) {
+        LOG_WARN("Inspector: no font, overlay disabled");
+        return NULL;
+    }
+    EcsInspector *in = calloc(1, sizeof *in);
+    if (!in) return NULL;
+    in->renderer = R;
+    in->scheduler = scheduler;
+    in->font = font;
+    in->layer = renderer_insert_layer(R, inspector_render, in, "ecs_inspector",
+                                      ECS_INSPECTOR_Z);
+    renderer_set_layer_enabled(R, in->layer, false);
+    return in;
+}
+
+void ecs_inspector_destroy(EcsInspector *in) {
+    if (!in) return;
+    if (renderer_layer_exists(in->renderer, in->layer))
+        renderer_remove_layer(in->renderer, in->layer);
+    free(in);
+}
+
+void ecs_inspector_toggle(EcsInspector *in) {
+    if (!in) return;
+    in->visible = !in->visible;
+    renderer_set_layer_enabled(in->renderer, in->layer, in->visible);
+}
@@ -0,0 +1,50 @@
+#ifndef CONQUEST_ECS_INSPECTOR_H
+#define CONQUEST_ECS_INSPECTOR_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "../../core/render/render_service.h"
+#include "../../core/resources/resource_manager.h"
+#include "../../game/entities/scheduler.h"
+
+/*
+ * ECS debug overlay.
+ *
+ * A render layer above every state's layers listing the renderer's drawn
+ * and culled items of the last frame, the world's archetypes (entities,
+ * chunks, memory), the entity count and memory of every component pool,
+ * and each system's average and worst time over the scheduler's timing
+ * ring. It is registered once and only toggled, so it
+ * shows in the menu and in play alike.
+ *
+ * Everything is gathered each frame through the ECS stats accessors into
+ * fixed scratch arrays and drawn through the shared glyph cache and sprite
+ * batch: nothing is allocated while it is visible.
+ */
+#define ECS_INSPECTOR_Z            1000
+#define ECS_INSPECTOR_ARCHETYPES   16   /* rows shown, largest first */
+#define ECS_INSPECTOR_FONT_SIZE    14
+
+typedef struct EcsInspector {
+    RenderService *renderer;
+    EcsScheduler  *scheduler;
+    TTF_Font      *font;          /* owned by the resource cache */
+    RenderLayerId  layer;
+    bool           visible;
+
+    /* per-frame scratch */
+    EcsComponentStats components[ECS_MAX_COMPONENTS];
+    int            largest[ECS_INSPECTOR_ARCHETYPES];  /* archetype indices */
+    char           line[192];
+} EcsInspector;
+
+/* Hidden until toggled. NULL without a font */
+EcsInspector *ecs_inspector_create(RenderService *R, ResourceManager *rm,
+                                   EcsScheduler *scheduler);
+void          ecs_inspector_destroy(EcsInspector *in);
+
+void          ecs_inspector_toggle(EcsInspector *in);
+
+#endif // CONQUEST_ECS_INSPECTOR_H
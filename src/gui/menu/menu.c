@@ -19,6 +19,7 @@ void menu_clear_buttons(Menu *m) {
     free(m->buttons);
     m->buttons = NULL;
     m->btn_count = 0;
+    dirty_region_invalidate(&m->dirty);
 }
 
 void menu_add_button(Menu *m, const char *lbl, MenuSignal signal, int y) {
@@ -26,8 +27,9 @@ void menu_add_button(Menu *m, const char *lbl, MenuSignal signal, int y) {
     int real_y = clamp(y + m->off_y, 0, m->win_h - 90);
     m->buttons = realloc(m->buttons, sizeof(Button) * (m->btn_count + 1));
     m->buttons[m->btn_count++] =
-        button_make(m->ren, m->font, lbl, signal, m->win_w / 2, real_y,
+        button_make(m->glyphs, m->font, lbl, signal, m->win_w / 2, real_y,
                     (SDL_Color){100, 100, 100, 255});
+    dirty_region_add(&m->dirty, &m->buttons[m->btn_count - 1].box);
 }
 int menu_center_x(Menu *m) { return m->win_w / 2; }
 void menu_get_fonts(Menu *m, void **title, void **body) {
@@ -58,10 +60,11 @@ void menu_set_event_bus(Menu *m, EventBus *bus) {
     m->event_bus = bus;
 }
 
-Menu *menu_create(SDL_Renderer *ren, int w, int h, 
+Menu *menu_create(SDL_Renderer *ren, GlyphCache *glyphs, int w, int h,
                  AudioManager *audio_manager, ResourceManager *resource_manager) {
     Menu *m = calloc(1, sizeof *m);
     m->ren = ren;
+    m->glyphs = glyphs;
     m->win_w = w;
     m->win_h = h;
     m->off_x = 0;
@@ -83,24 +86,25 @@ Menu *menu_create(SDL_Renderer *ren, int w, int h,
     m->last_signal = MENU_SIGNAL_NONE;
     
     if (m->title_font) {
-        SDL_Surface *s = TTF_RenderUTF8_Solid(m->title_font, "CONQUEST",
-                                            (SDL_Color){255, 255, 255, 255});
-        m->title_tex = SDL_CreateTextureFromSurface(ren, s);
-        SDL_FreeSurface(s);
+        m->title = "CONQUEST";
+        int tw = 0, th = 0;
+        glyph_cache_measure(m->glyphs, m->title_font, m->title, &tw, &th);
+        m->title_dst = (SDL_Rect){(m->win_w - tw) / 2, m->off_y, tw, th};
     } else {
-        m->title_tex = NULL;
-        SDL_Log("Error: Failed to create title texture due to missing font");
+        m->title = NULL;
+        SDL_Log("Error: No title drawn due to missing font");
     }
     
     // Use resource manager to load the background texture with proper path
     if (m->resource_manager) {
-            m->bg_tex = load_texture(resource_manager, "ui/main_bg.png", ren);
+            m->bg = load_texture_region(resource_manager, "ui/main_bg.png", ren);
     } else {
         SDL_Log("Warning: No resource manager provided to menu. Background texture won't be loaded.");
-        m->bg_tex = NULL;
+        m->bg = (AtlasRegion){0};
     }
     
     menu_build_main(m);
+    dirty_region_invalidate(&m->dirty);
     return m;
 }
 
@@ -112,9 +116,14 @@ void menu_handle_input(Menu *m, const InputManager *im) {
     // Remove or comment out debug print
     // printf("Mouse position: %d, %d\n", mx, my);
 
-    /* 1. hover colouring */
-    for (int i = 0; i < m->btn_count; ++i)
-        button_hover(&m->buttons[i], mx, my);
+    /* 1. hover colouring – only buttons whose colour flips get redrawn */
+    for (int i = 0; i < m->btn_count; ++i) {
+        Button *b = &m->buttons[i];
+        SDL_Color before = b->current_background_color;
+        button_hover(b, mx, my);
+        if (memcmp(&before, &b->current_background_color, sizeof before) != 0)
+            dirty_region_add(&m->dirty, &b->box);
+    }
 
     /* 2. click → emit signal event */
     if (input_pressed(im, ACTION_CONFIRM)) {
@@ -145,17 +154,19 @@ void menu_handle_input(Menu *m, const InputManager *im) {
     }
 }
 
+// Drawn into a retained layer: clipped to the dirty rectangles, so no
+// SDL_RenderClear (it ignores the clip rect)
 void menu_render(Menu *m, SDL_Renderer *ren) {
-    if (m->bg_tex)
-        SDL_RenderCopy(ren, m->bg_tex, NULL, NULL);
+    if (m->bg.texture)
+        SDL_RenderCopy(ren, m->bg.texture, &m->bg.rect, NULL);
     else
-        SDL_SetRenderDrawColor(ren, 10, 10, 30, 255), SDL_RenderClear(ren);
-    int tw, th;
-    SDL_QueryTexture(m->title_tex, NULL, NULL, &tw, &th);
-    m->title_dst = (SDL_Rect){(m->win_w - tw) / 2, m->off_y, tw, th};
-    SDL_RenderCopy(ren, m->title_tex, NULL, &m->title_dst);
+        SDL_SetRenderDrawColor(ren, 10, 10, 30, 255), SDL_RenderFillRect(ren, NULL);
+    if (m->title)
+        glyph_cache_draw_now(m->glyphs, m->title_font, m->title,
+                             m->title_dst.x, m->title_dst.y,
+                             (SDL_Color){255, 255, 255, 255});
     for (int i = 0; i < m->btn_count; i++)
-        button_render(&m->buttons[i], ren);
+        button_render(&m->buttons[i], ren, m->glyphs);
 }
 
 MenuSignal menu_get_last_signal(Menu *m) {
@@ -166,14 +177,7 @@ void menu_destroy(Menu *m) {
     if (!m)
         return;
     menu_clear_buttons(m);
-    if (m->title_tex)
-        SDL_DestroyTexture(m->title_tex);
-    if (m->bg_tex)
-        SDL_DestroyTexture(m->bg_tex);
-    if (m->title_font)
-        TTF_CloseFont(m->title_font);
-    if (m->font)
-        TTF_CloseFont(m->font);
+    /* fonts are owned by the resource cache */
     free(m);
 }
 
@@ -5,6 +5,8 @@
 #include "menu_items.h"
 #include "../../core/event/event_bus.h"
 #include "../../core/resources/resource_manager.h"
+#include "../../core/render/dirty_region.h"
+#include "../../core/render/glyph_cache.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
@@ -22,7 +24,9 @@ typedef struct Menu {
   int off_x, off_y;
   SDL_Renderer *ren;
   TTF_Font *title_font, *font;
-  SDL_Texture *title_tex, *bg_tex;
+  GlyphCache *glyphs; /* owned by the render service */
+  const char *title;
+  AtlasRegion bg; /* owned by the resource manager */
   SDL_Rect title_dst;
   Button *buttons;
   int btn_count;
@@ -30,6 +34,7 @@ typedef struct Menu {
   EventBus *event_bus; // Reference to the event bus
   struct AudioManager *audio_manager; // Reference to the audio manager
   ResourceManager *resource_manager; // Reference to the resource manager
+  DirtyRegion dirty; // areas to redraw; the menu is a retained layer
 } Menu;
 
 typedef enum {
@@ -41,7 +46,7 @@ typedef enum {
 } MenuScreenID;
 
 /* lifecycle */
-Menu *menu_create(SDL_Renderer *ren, int win_w, int win_h, struct AudioManager *audio_manager, ResourceManager *resource_manager);
+Menu *menu_create(SDL_Renderer *ren, GlyphCache *glyphs, int win_w, int win_h, struct AudioManager *audio_manager, ResourceManager *resource_manager);
 void menu_destroy(Menu *m);
 
 /* frame */
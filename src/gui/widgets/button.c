@@ -1,31 +1,32 @@
 #include "button.h"
 #include "../../utils/math_utils.h"
+#include "../../utils/log.h"
+#include <stdio.h>
 #include <string.h>
 
-Button button_make(SDL_Renderer *ren, TTF_Font *font, const char *text,
+Button button_make(GlyphCache *glyphs, TTF_Font *font, const char *text,
                    MenuSignal signal, int center_x, int y,
                    SDL_Color base_background_color) {
-    SDL_Surface *s =
-        TTF_RenderUTF8_Solid(font, text, (SDL_Color){255, 255, 255, base_background_color.a});
-    if (!s)
-        return (Button){0};
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(ren, s);
-    SDL_FreeSurface(s);
-    if (!tex)
+    if (!font || !text || !*text)
         return (Button){0};
 
+    Button b = {.font = font,
+                .signal = signal,
+                .base_background_color = base_background_color,
+                .current_background_color = base_background_color};
+    if (snprintf(b.label, sizeof b.label, "%s", text) >= (int)sizeof b.label)
+        LOG_WARN("Button label cut to %d bytes: \"%s\"", BUTTON_LABEL_MAX - 1, text);
+
+    /* sized for what is drawn, so a cut label still fits its box */
     int w, h;
-    SDL_QueryTexture(tex, NULL, NULL, &w, &h);
-    return (Button){.box = {center_x - (w + 20) / 2, y, w + 20, h + 20},
-                    .label = tex,
-                    .signal = signal,
-                    .base_background_color = base_background_color,
-                    .current_background_color = base_background_color};
+    glyph_cache_measure(glyphs, font, b.label, &w, &h);
+    b.box = (SDL_Rect){center_x - (w + 20) / 2, y, w + 20, h + 20};
+    return b;
 }
 
 int button_hover(Button *b, int mx, int my) {
     // If the label is null, return false
-    if (!b->label)
+    if (!b->label[0])
         return 0;
 
     int is_hover = (mx >= b->box.x && mx <= b->box.x + b->box.w &&
@@ -53,7 +54,7 @@ int button_hover(Button *b, int mx, int my) {
     return is_hover;
 }
 
-void button_render(Button *b, SDL_Renderer *ren) {
+void button_render(Button *b, SDL_Renderer *ren, GlyphCache *glyphs) {
     // Render the button with the base
     SDL_SetRenderDrawColor(
         ren, b->current_background_color.r, b->current_background_color.g,
@@ -67,13 +68,10 @@ void button_render(Button *b, SDL_Renderer *ren) {
         clamp(b->current_background_color.b - 30, 0, 255),
         b->current_background_color.a);
     SDL_RenderDrawRect(ren, &b->box);
-    SDL_Rect txt_dst = {b->box.x + 10, b->box.y + 10, b->box.w - 20,
-                        b->box.h - 20};
-    SDL_RenderCopy(ren, b->label, NULL, &txt_dst);
+    glyph_cache_draw_now(glyphs, b->font, b->label, b->box.x + 10, b->box.y + 10,
+                         (SDL_Color){255, 255, 255, b->base_background_color.a});
 }
 
 void button_destroy(Button *b) {
-    if (b->label)
-        SDL_DestroyTexture(b->label);
     memset(b, 0, sizeof *b);
 }
\ No newline at end of file
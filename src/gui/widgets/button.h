@@ -3,20 +3,24 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include "../../core/event/event_signals.h"
+#include "../../core/render/glyph_cache.h"
+
+#define BUTTON_LABEL_MAX 64
 
 /** Lightweight clickable button */
 typedef struct Button {
   SDL_Rect box;
-  SDL_Texture *label; /* text rendered into texture */
+  char label[BUTTON_LABEL_MAX]; /* drawn through the glyph cache */
+  TTF_Font *font;
   SDL_Color base_background_color; /* color of the button */
   SDL_Color current_background_color; /* color of the button */
   MenuSignal signal; /* event enum to send on click */
 } Button;
 
-Button button_make(SDL_Renderer *ren, TTF_Font *font, const char *text,
+Button button_make(GlyphCache *glyphs, TTF_Font *font, const char *text,
                    MenuSignal signal, int center_x, int y,
                    SDL_Color base_background_color);
 int button_hover(Button *b, int mx, int my);
-void button_render(Button *b, SDL_Renderer *ren);
+void button_render(Button *b, SDL_Renderer *ren, GlyphCache *glyphs);
 void button_destroy(Button *b);
 #endif
\ No newline at end of file
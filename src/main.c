@@ -9,12 +9,16 @@
 #include "core/cursor/cursor.h"
 #include "core/input/input_manager.h"
 #include "core/resources/resource_paths.h"
+#include "core/resources/hot_reload.h"
 #include "core/services/service_manager.h"
 #include "core/settings/settings_manager.h"
 #include "core/settings/default_settings.h"
 #include "core/render/render_service.h"
 #include "core/state/state_manager.h"
 #include "core/state/state_functions/state_functions.h"
+#include "game/entities/scheduler.h"
+#include "game/entities/world_components.h"
+#include "gui/debug/ecs_inspector.h"
 #include "game_loop/game_loop.h"
 #include "game_loop/initialization.h"
 #include "utils/game_structs.h"
@@ -96,15 +100,35 @@ void game_shutdown(GameHandle *gh) {
         SettingsManager *settings = svc_get(gh->services, SETTINGS_MANAGER_SERVICE);
         if (settings) {
             // Save settings before shutting down
-            char* base_path = SDL_GetBasePath();
             char settings_path[512];
-            LOG_INFO("Saving settings to: %ssettings.ini", base_path ? base_path : "");
-            SDL_free(base_path);
+            snprintf(settings_path, sizeof(settings_path), "%ssettings.ini",
+                     resource_paths_base());
+            LOG_INFO("Saving settings to: %s", settings_path);
             
             sm_save_settings(settings, settings_path);
             sm_settings_destroy(settings);
         }
 
+        /* Stop the hot reload watcher (frees retired textures) */
+        HotReload *hr = svc_get(gh->services, HOT_RELOAD_SERVICE);
+        if (hr)
+            hot_reload_stop(hr);
+
+        /* Remove the inspector overlay before what it inspects goes away */
+        EcsInspector *inspector = svc_get(gh->services, INSPECTOR_SERVICE);
+        if (inspector)
+            ecs_inspector_destroy(inspector);
+
+        /* Stop the system scheduler, then free the world it ran on; both
+           before the render service, whose worker pool the systems used */
+        EcsScheduler *sched = svc_get(gh->services, SIMULATION_SERVICE);
+        if (sched) {
+            EcsWorld *world = sched->world;
+            ecs_scheduler_destroy(sched);
+            world_components_shutdown(world);
+            ecs_world_destroy(world);
+        }
+
         /* Get and clean up render service */
         RenderService *renderer = svc_get(gh->services, RENDER_SERVICE);
         if (renderer) {
@@ -115,6 +139,9 @@ void game_shutdown(GameHandle *gh) {
         svc_destroy(gh->services);
     }
 
+    /* Release interned resource paths */
+    resource_paths_shutdown();
+
     /* Shutdown SDL subsystems */
     TTF_Quit();
     IMG_Quit();
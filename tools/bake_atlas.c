@@ -0,0 +1,64 @@
+/*
+ * Atlas bake: packs every image under resources/images/ that the game would
+ * pack at startup and writes the pages and table with atlas_save(), so
+ * resource_manager_build_atlas() loads them instead of packing each run.
+ *
+ * The output is resources/atlas/images_<n>.png plus images.atlas. Re-run it
+ * after changing images: while a baked table exists the game uses it and
+ * does not look at images/ for atlas regions.
+ *
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -std=gnu11 -Isrc tools/bake_atlas.c src/core/resources/texture_atlas.c \
+ *       src/core/resources/resource_paths.c src/core/resources/resource_cache.c \
+ *       $(sdl2-config --cflags --libs) -lSDL2_image -lSDL2_ttf -o bake_atlas
+ *   ./bake_atlas [resources root, default src]
+ */
+#define CONQUEST_LOG_IMPLEMENTATION
+#include "utils/log.h"
+#include "core/resources/resource_paths.h"
+#include "core/resources/texture_atlas.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define make_dir(path) _mkdir(path)
+#else
+#define make_dir(path) mkdir((path), 0755)
+#endif
+
+int main(int argc, char **argv) {
+    const char *root = argc > 1 ? argv[1] : "src";
+    log_init(NULL);
+    log_set_level(LOG_LEVEL_INFO);
+
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        LOG_ERROR("Bake: IMG_Init failed: %s", IMG_GetError());
+        return 1;
+    }
+    resource_paths_add_root(root);
+
+    char dir[1024];
+    snprintf(dir, sizeof dir, "%s/resources/atlas", root);
+    make_dir(dir);
+
+    int status = 1;
+    TextureAtlas *atlas = atlas_create(ATLAS_DEFAULT_PAGE_SIZE, ATLAS_DEFAULT_PAGE_SIZE);
+    if (atlas) {
+        int queued = atlas_add_images(atlas, "", ATLAS_MAX_IMAGE);
+        if (atlas_build(atlas, NULL) == 0 && atlas_save(atlas, dir, ATLAS_BAKED_STEM) == 0) {
+            printf("baked %d of %d images into %d page(s) in %s\n", atlas->region_count,
+                   queued, atlas->page_count, dir);
+            status = 0;
+        }
+        atlas_destroy(atlas);
+    }
+
+    resource_paths_shutdown();
+    IMG_Quit();
+    log_shutdown();
+    return status;
+}
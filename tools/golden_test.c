@@ -0,0 +1,167 @@
+/*
+ * Golden image test: renders the menu and the play state headless and
+ * compares each frame with a PNG checked in next to it (tools/golden_*.png).
+ *
+ * Everything runs on SDL's software renderer over an offscreen surface, the
+ * same way the game wires its services but without a window, audio or
+ * input. Frames come from renderer_capture() and are checked with
+ * image_diff_golden(); on a mismatch the frame and a difference mask are
+ * written next to the golden (<name>.actual.png, <name>.diff.png) and the
+ * exit status is 1.
+ *
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -std=gnu11 -Isrc tools/golden_test.c $(find src -name '*.c' ! -name main.c) \
+ *       $(sdl2-config --cflags --libs) -lSDL2_image -lSDL2_ttf -lSDL2_mixer -lm \
+ *       -o golden_test
+ *   ./golden_test [--update]
+ *
+ * --update writes every golden from this run instead of comparing; look at
+ * the new PNGs before committing them. Without it a missing golden fails
+ * like a mismatch, so the goldens have to be checked in for the test to pass.
+ */
+#define CONQUEST_LOG_IMPLEMENTATION
+#include "utils/log.h"
+#include "core/event/event_bus.h"
+#include "core/render/image_diff.h"
+#include "core/render/render_service.h"
+#include "core/resources/resource_manager.h"
+#include "core/resources/resource_paths.h"
+#include "core/services/service_manager.h"
+#include "core/state/state_manager.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GOLDEN_W          1280
+#define GOLDEN_H          720
+#define GOLDEN_TOLERANCE  8                           /* per channel */
+#define GOLDEN_MAX_PIXELS (GOLDEN_W * GOLDEN_H / 1000) /* font hinting drift */
+#define GOLDEN_RESOURCES  "src"                       /* holds resources/ */
+
+typedef struct GoldenCase {
+    enum GameState state;
+    const char    *golden;
+} GoldenCase;
+
+static const GoldenCase CASES[] = {
+    {GS_MENU, "tools/golden_menu.png"},
+    {GS_PLAY, "tools/golden_play.png"},
+};
+
+typedef struct Harness {
+    SDL_Surface     *screen;
+    RenderService   *renderer;
+    ResourceManager *resources;
+    EventBus        *bus;
+    ServiceManager  *services;
+    StateManager    *states;
+} Harness;
+
+/* ─── setup ─── */
+
+static bool harness_init(Harness *h) {
+    memset(h, 0, sizeof *h);
+    h->screen = SDL_CreateRGBSurfaceWithFormat(0, GOLDEN_W, GOLDEN_H, 32,
+                                               SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *ren = h->screen ? SDL_CreateSoftwareRenderer(h->screen) : NULL;
+    if (!ren) {
+        LOG_ERROR("Golden: no software renderer: %s", SDL_GetError());
+        return false;
+    }
+    h->renderer = renderer_init(ren, NULL);
+    h->resources = resource_manager_create();
+    h->bus = calloc(1, sizeof *h->bus);
+    h->services = svc_create();
+    if (!h->renderer || !h->resources || !h->bus || !h->services) return false;
+    bus_init(h->bus);
+
+    h->resources->loader = h->renderer->workers;
+    h->resources->glyphs = renderer_glyphs(h->renderer);
+    resource_manager_build_atlas(h->resources, ren);
+    h->states = sm_create(ren, renderer_glyphs(h->renderer), GOLDEN_W, GOLDEN_H,
+                          h->resources);
+    if (!h->states) return false;
+
+    svc_register(h->services, EVENT_BUS_SERVICE, h->bus);
+    svc_register(h->services, RESOURCE_MANAGER_SERVICE, h->resources);
+    svc_register(h->services, RENDER_SERVICE, h->renderer);
+    svc_register(h->services, STATE_MANAGER_SERVICE, h->states);
+    sm_set_services(h->states, h->services);
+    return true;
+}
+
+static void harness_shutdown(Harness *h) {
+    sm_destroy(h->states);
+    if (h->bus) {
+        bus_destroy(h->bus);
+        free(h->bus);
+    }
+    if (h->services) svc_destroy(h->services);
+    /* textures before the renderer that owns them, layers after the states */
+    if (h->resources) resource_manager_destroy(h->resources);
+    renderer_shutdown(h->renderer);
+    if (h->screen) SDL_FreeSurface(h->screen);
+}
+
+/* ─── cases ─── */
+
+static bool run_case(Harness *h, const GoldenCase *c, bool update) {
+    sm_enter(h->states, c->state);
+    renderer_begin_frame(h->renderer);  /* camera follows the output size */
+    SDL_Surface *frame = renderer_capture(h->renderer);
+    if (!frame) {
+        printf("FAIL  %s  (no frame)\n", c->golden);
+        return false;
+    }
+
+    if (update) {
+        bool written = IMG_SavePNG(frame, c->golden) == 0;
+        SDL_FreeSurface(frame);
+        printf("%s  %s\n", written ? "wrote" : "FAIL ", c->golden);
+        return written;
+    }
+    ImageDiff d;
+    bool match = image_diff_golden(frame, c->golden, GOLDEN_TOLERANCE,
+                                   GOLDEN_MAX_PIXELS, &d);
+    SDL_FreeSurface(frame);
+    printf("%s  %s  %d pixels over %d, max delta %d, mean %.3f\n",
+           match ? "ok  " : "FAIL", c->golden, d.pixels_over, GOLDEN_TOLERANCE,
+           d.max_delta, d.mean_delta);
+    return match;
+}
+
+int main(int argc, char **argv) {
+    bool update = argc > 1 && strcmp(argv[1], "--update") == 0;
+    log_init(NULL);
+    log_set_level(LOG_LEVEL_WARN);
+
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    if (SDL_Init(SDL_INIT_VIDEO) != 0 || TTF_Init() != 0 ||
+        !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        LOG_ERROR("Golden: SDL init failed: %s", SDL_GetError());
+        return 2;
+    }
+    resource_paths_add_root(GOLDEN_RESOURCES);
+
+    Harness h;
+    int failed = 0;
+    if (!harness_init(&h)) {
+        LOG_ERROR("Golden: could not set up the services");
+        failed = 1;
+    } else {
+        for (size_t i = 0; i < sizeof CASES / sizeof CASES[0]; i++)
+            failed += !run_case(&h, &CASES[i], update);
+    }
+
+    harness_shutdown(&h);
+    resource_paths_shutdown();
+    IMG_Quit();
+    TTF_Quit();
+    SDL_Quit();
+    log_shutdown();
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+"""Generate the console's CP437 font sheet.
+
+Writes a 16x16 grid of 8x8 glyphs in code page 437 order, white on
+transparent, as an RGBA PNG (128x128). The printable ASCII glyphs are the
+public-domain font8x8 set (IBM PC BIOS style); box drawing is generated
+from the arm weights of each glyph; the rest is drawn below. Only the
+standard library is needed:
+
+    python3 tools/make_cp437_sheet.py src/resources/images/fonts/cp437_8x8.png
+"""
+import struct
+import sys
+import zlib
+
+# Rows top to bottom, bit 0 is the leftmost pixel (font8x8 layout)
+ASCII = {
+    0x21: [0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00],
+    0x22: [0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00],
+    0x23: [0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00],
+    0x24: [0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00],
+    0x25: [0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00],
+    0x26: [0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00],
+    0x27: [0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00],
+    0x28: [0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00],
+    0x29: [0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00],
+    0x2A: [0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00],
+    0x2B: [0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00],
+    0x2C: [0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06],
+    0x2D: [0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00],
+    0x2E: [0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00],
+    0x2F: [0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00],
+    0x30: [0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00],
+    0x31: [0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00],
+    0x32: [0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00],
+    0x33: [0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00],
+    0x34: [0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00],
+    0x35: [0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00],
+    0x36: [0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00],
+    0x37: [0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00],
+    0x38: [0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00],
+    0x39: [0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00],
+    0x3A: [0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00],
+    0x3B: [0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06],
+    0x3C: [0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00],
+    0x3D: [0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00],
+    0x3E: [0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00],
+    0x3F: [0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00],
+    0x40: [0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00],
+    0x41: [0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00],
+    0x42: [0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00],
+    0x43: [0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00],
+    0x44: [0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00],
+    0x45: [0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00],
+    0x46: [0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00],
+    0x47: [0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00],
+    0x48: [0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00],
+    0x49: [0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00],
+    0x4A: [0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00],
+    0x4B: [0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00],
+    0x4C: [0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00],
+    0x4D: [0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00],
+    0x4E: [0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00],
+    0x4F: [0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00],
+    0x50: [0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00],
+    0x51: [0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00],
+    0x52: [0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00],
+    0x53: [0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00],
+    0x54: [0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00],
+    0x55: [0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00],
+    0x56: [0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00],
+    0x57: [0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00],
+    0x58: [0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00],
+    0x59: [0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00],
+    0x5A: [0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00],
+    0x5B: [0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00],
+    0x5C: [0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00],
+    0x5D: [0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00],
+    0x5E: [0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00],
+    0x5F: [0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF],
+    0x60: [0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00],
+    0x61: [0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00],
+    0x62: [0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00],
+    0x63: [0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00],
+    0x64: [0x38, 0x30, 0x30, 0x3E, 0x33, 0x33, 0x6E, 0x00],
+    0x65: [0x00, 0x00, 0x1E, 0x33, 0x3F, 0x03, 0x1E, 0x00],
+    0x66: [0x1C, 0x36, 0x06, 0x0F, 0x06, 0x06, 0x0F, 0x00],
+    0x67: [0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F],
+    0x68: [0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00],
+    0x69: [0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00],
+    0x6A: [0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E],
+    0x6B: [0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00],
+    0x6C: [0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00],
+    0x6D: [0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00],
+    0x6E: [0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00],
+    0x6F: [0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00],
+    0x70: [0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F],
+    0x71: [0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78],
+    0x72: [0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00],
+    0x73: [0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00],
+    0x74: [0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00],
+    0x75: [0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00],
+    0x76: [0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00],
+    0x77: [0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00],
+    0x78: [0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00],
+    0x79: [0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F],
+    0x7A: [0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00],
+    0x7B: [0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00],
+    0x7C: [0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00],
+    0x7D: [0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00],
+    0x7E: [0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00],
+}
+
+SYMBOLS = {
+    0x01: [0x7E, 0x81, 0xA5, 0x81, 0xBD, 0x99, 0x81, 0x7E],   # ☺
+    0x02: [0x7E, 0xFF, 0xDB, 0xFF, 0xC3, 0xE7, 0xFF, 0x7E],   # ☻
+    0x03: [0x36, 0x7F, 0x7F, 0x7F, 0x3E, 0x1C, 0x08, 0x00],   # ♥
+    0x04: [0x08, 0x1C, 0x3E, 0x7F, 0x3E, 0x1C, 0x08, 0x00],   # ♦
+    0x05: [0x1C, 0x3E, 0x1C, 0x7F, 0x7F, 0x2A, 0x08, 0x1C],   # ♣
+    0x06: [0x08, 0x1C, 0x3E, 0x7F, 0x7F, 0x3E, 0x08, 0x1C],   # ♠
+    0x07: [0x00, 0x00, 0x18, 0x3C, 0x3C, 0x18, 0x00, 0x00],   # •
+    0x08: [0xFF, 0xFF, 0xE7, 0xC3, 0xC3, 0xE7, 0xFF, 0xFF],   # ◘
+    0x09: [0x00, 0x3C, 0x66, 0x42, 0x42, 0x66, 0x3C, 0x00],   # ○
+    0x0A: [0xFF, 0xC3, 0x99, 0xBD, 0xBD, 0x99, 0xC3, 0xFF],   # ◙
+    0x0B: [0xF0, 0xE0, 0xB0, 0x1E, 0x33, 0x33, 0x33, 0x1E],   # ♂
+    0x0C: [0x1E, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x3F, 0x0C],   # ♀
+    0x0D: [0xFC, 0xCC, 0xFC, 0x0C, 0x0C, 0x0E, 0x0F, 0x07],   # ♪
+    0x0E: [0xFE, 0xC6, 0xFE, 0xC6, 0xC6, 0xE6, 0x67, 0x03],   # ♫
+    0x0F: [0x99, 0x5A, 0x3C, 0xE7, 0xE7, 0x3C, 0x5A, 0x99],   # ☼
+    0x10: [0x01, 0x07, 0x1F, 0x7F, 0x1F, 0x07, 0x01, 0x00],   # ►
+    0x11: [0x40, 0x70, 0x7C, 0x7F, 0x7C, 0x70, 0x40, 0x00],   # ◄
+    0x12: [0x18, 0x3C, 0x7E, 0x18, 0x18, 0x7E, 0x3C, 0x18],   # ↕
+    0x13: [0x66, 0x66, 0x66, 0x66, 0x66, 0x00, 0x66, 0x00],   # ‼
+    0x14: [0xFE, 0xDB, 0xDB, 0xDE, 0xD8, 0xD8, 0xD8, 0x00],   # ¶
+    0x15: [0x7C, 0xC6, 0x1C, 0x36, 0x36, 0x1C, 0x33, 0x1E],   # §
+    0x16: [0x00, 0x00, 0x00, 0x00, 0x7E, 0x7E, 0x7E, 0x00],   # ▬
+    0x17: [0x18, 0x3C, 0x7E, 0x18, 0x7E, 0x3C, 0x18, 0xFF],   # ↨
+    0x18: [0x18, 0x3C, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x00],   # ↑
+    0x19: [0x18, 0x18, 0x18, 0x18, 0x7E, 0x3C, 0x18, 0x00],   # ↓
+    0x1A: [0x00, 0x18, 0x30, 0x7F, 0x30, 0x18, 0x00, 0x00],   # →
+    0x1B: [0x00, 0x0C, 0x06, 0x7F, 0x06, 0x0C, 0x00, 0x00],   # ←
+    0x1C: [0x00, 0x00, 0x03, 0x03, 0x03, 0x7F, 0x00, 0x00],   # ∟
+    0x1D: [0x00, 0x24, 0x66, 0xFF, 0x66, 0x24, 0x00, 0x00],   # ↔
+    0x1E: [0x00, 0x18, 0x3C, 0x7E, 0xFF, 0xFF, 0x00, 0x00],   # ▲
+    0x1F: [0x00, 0xFF, 0xFF, 0x7E, 0x3C, 0x18, 0x00, 0x00],   # ▼
+    0x7F: [0x00, 0x08, 0x1C, 0x36, 0x63, 0x63, 0x7F, 0x00],   # ⌂
+    0xB0: [0x11, 0x44, 0x11, 0x44, 0x11, 0x44, 0x11, 0x44],   # ░
+    0xB1: [0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA],   # ▒
+    0xB2: [0xDD, 0x77, 0xDD, 0x77, 0xDD, 0x77, 0xDD, 0x77],   # ▓
+    0xDB: [0xFF] * 8,                                          # █
+    0xDC: [0x00] * 4 + [0xFF] * 4,                             # ▄
+    0xDD: [0x0F] * 8,                                          # ▌
+    0xDE: [0xF0] * 8,                                          # ▐
+    0xDF: [0xFF] * 4 + [0x00] * 4,                             # ▀
+    0xFE: [0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00],   # ■
+}
+
+# Drawn glyphs, '#' on; left column first
+DRAWN = {
+    0x80: """.####... ##..##.. ##...... ##...... ##..##.. .####... ...##... ..##....""",  # Ç
+    0x87: """........ .####... ##..##.. ##...... ##..##.. .####... ...##... ..##....""",  # ç
+    0x8E: """##..##.. ........ ..##.... .####... ##..##.. ######.. ##..##.. ##..##..""",  # Ä
+    0x8F: """..##.... ..##.... ........ .####... ##..##.. ######.. ##..##.. ##..##..""",  # Å
+    0x90: """...###.. ........ ######.. ##...... #####... ##...... ######.. ........""",  # É
+    0x91: """........ ........ .##.###. ...##.## .######. ##.##... .##.###. ........""",  # æ
+    0x92: """..###### .##.##.. ##..##.. #######. ##..##.. ##..##.. ##..#### ........""",  # Æ
+    0x99: """##...##. ........ ..###... .##.##.. ##...##. .##.##.. ..###... ........""",  # Ö
+    0x9A: """##..##.. ........ ##..##.. ##..##.. ##..##.. ##..##.. .####... ........""",  # Ü
+    0x9B: """...##... ...##... .######. ##...... ##...... .######. ...##... ...##...""",  # ¢
+    0x9C: """..###... .##.##.. .##..... ####.... .##..... .##..##. ######.. ........""",  # £
+    0x9D: """##..##.. ##..##.. .####... ######.. ..##.... ######.. ..##.... ........""",  # ¥
+    0x9E: """#####... ##..##.. ##..##.. #####.#. ##...### ##..#.#. ##....#. ........""",  # ₧
+    0x9F: """....###. ...##.## ...##... .######. ...##... ...##... ##.##... .###....""",  # ƒ
+    0xA4: """........ #####... ........ #####... ##..##.. ##..##.. ##..##.. ........""",  # ñ
+    0xA5: """######.. ........ ##..##.. ###.##.. ######.. ##.###.. ##..##.. ........""",  # Ñ
+    0xA6: """..####.. .##.##.. ..#####. ........ .######. ........ ........ ........""",  # ª
+    0xA7: """..###... .##.##.. .##.##.. ..###... ........ .#####.. ........ ........""",  # º
+    0xA8: """..##.... ........ ..##.... .##..... ##...... ##..##.. .####... ........""",  # ¿
+    0xA9: """........ ........ ######.. ##...... ##...... ........ ........ ........""",  # ⌐
+    0xAA: """........ ........ ######.. ....##.. ....##.. ........ ........ ........""",  # ¬
+    0xAB: """##....## ##...##. ##..##.. ##.####. ..##..## .##..##. ##..##.. ....####""",  # ½
+    0xAC: """##....## ##...##. ##..##.. ##.##.## ..##.### .##.#### ##..#### ......##""",  # ¼
+    0xAD: """...##... ...##... ........ ...##... ...##... ..####.. ..####.. ...##...""",  # ¡
+    0xAE: """........ ..##..## .##..##. ##..##.. .##..##. ..##..## ........ ........""",  # «
+    0xAF: """........ ##..##.. .##..##. ..##..## .##..##. ##..##.. ........ ........""",  # »
+    0xE0: """........ ........ .###.##. ##.###.. ##..#... ##.###.. .###.##. ........""",  # α
+    0xE1: """.####... ##..##.. ##..##.. #####... ##..##.. #####... ##...... ##......""",  # ß
+    0xE2: """######.. ##..##.. ##...... ##...... ##...... ##...... ##...... ........""",  # Γ
+    0xE3: """........ #######. .##.##.. .##.##.. .##.##.. .##.##.. .##.##.. ........""",  # π
+    0xE4: """######.. ##..##.. .##..... ..##.... .##..... ##..##.. ######.. ........""",  # Σ
+    0xE5: """........ ........ .######. ##.##... ##.##... ##.##... .###.... ........""",  # σ
+    0xE6: """........ .##..##. .##..##. .##..##. .#####.. .##..... ##...... ........""",  # µ
+    0xE7: """........ .###.##. ##.###.. ...##... ...##... ...##... ...##... ........""",  # τ
+    0xE8: """######.. ..##.... .####... ##..##.. ##..##.. .####... ..##.... ######..""",  # Φ
+    0xE9: """..###... .##.##.. ##...##. #######. ##...##. .##.##.. ..###... ........""",  # Θ
+    0xEA: """..###... .##.##.. ##...##. ##...##. .##.##.. .##.##.. ###.###. ........""",  # Ω
+    0xEB: """...###.. ..##.... ...##... .#####.. ##..##.. ##..##.. .####... ........""",  # δ
+    0xEC: """........ ........ .######. ##.##.## ##.##.## .######. ........ ........""",  # ∞
+    0xED: """.....##. ....##.. .######. ##.##.## ##.##.## .######. .##..... ##......""",  # φ
+    0xEE: """..###... .##..... ##...... #####... ##...... .##..... ..###... ........""",  # ε
+    0xEF: """.####... ##..##.. ##..##.. ##..##.. ##..##.. ##..##.. ##..##.. ........""",  # ∩
+    0xF0: """........ ######.. ........ ######.. ........ ######.. ........ ........""",  # ≡
+    0xF1: """..##.... ..##.... ######.. ..##.... ..##.... ........ ######.. ........""",  # ±
+    0xF2: """.##..... ..##.... ...##... ..##.... .##..... ........ ######.. ........""",  # ≥
+    0xF3: """...##... ..##.... .##..... ..##.... ...##... ........ ######.. ........""",  # ≤
+    0xF4: """....###. ...##.## ...##.## ...##... ...##... ...##... ...##... ...##...""",  # ⌠
+    0xF5: """...##... ...##... ...##... ...##... ##.##... ##.##... .###.... ........""",  # ⌡
+    0xF6: """..##.... ..##.... ........ ######.. ........ ..##.... ..##.... ........""",  # ÷
+    0xF7: """........ .###.##. ##.###.. ........ .###.##. ##.###.. ........ ........""",  # ≈
+    0xF8: """..###... .##.##.. .##.##.. ..###... ........ ........ ........ ........""",  # °
+    0xF9: """........ ........ ........ ...##... ...##... ........ ........ ........""",  # ∙
+    0xFA: """........ ........ ........ ........ ...#.... ........ ........ ........""",  # ·
+    0xFB: """....#### ....##.. ....##.. ....##.. ###.##.. .##.##.. ..####.. ...###..""",  # √
+    0xFC: """.####... .##.##.. .##.##.. .##.##.. ........ ........ ........ ........""",  # ⁿ
+    0xFD: """.###.... ...##... ..##.... .####... ........ ........ ........ ........""",  # ²
+}
+
+# Accented lowercase: (base letter, accent row 0 / row 1)
+ACCENT = {
+    "acute": [0x38, 0x00], "grave": [0x07, 0x00], "circ": [0x0C, 0x33],
+    "uml": [0x33, 0x00], "ring": [0x0C, 0x0C],
+}
+DOTLESS_I = [0x00, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00]
+COMPOSED = {
+    0x81: ("u", "uml"), 0x82: ("e", "acute"), 0x83: ("a", "circ"), 0x84: ("a", "uml"),
+    0x85: ("a", "grave"), 0x86: ("a", "ring"), 0x88: ("e", "circ"), 0x89: ("e", "uml"),
+    0x8A: ("e", "grave"), 0x8B: ("i", "uml"), 0x8C: ("i", "circ"), 0x8D: ("i", "grave"),
+    0x93: ("o", "circ"), 0x94: ("o", "uml"), 0x95: ("o", "grave"), 0x96: ("u", "circ"),
+    0x97: ("u", "grave"), 0x98: ("y", "uml"), 0xA0: ("a", "acute"), 0xA1: ("i", "acute"),
+    0xA2: ("o", "acute"), 0xA3: ("u", "acute"),
+}
+
+# Box drawing arm weights (up, down, left, right): 1 single, 2 double
+BOX = {
+    0xB3: (1, 1, 0, 0), 0xB4: (1, 1, 1, 0), 0xB5: (1, 1, 2, 0), 0xB6: (2, 2, 1, 0),
+    0xB7: (0, 2, 1, 0), 0xB8: (0, 1, 2, 0), 0xB9: (2, 2, 2, 0), 0xBA: (2, 2, 0, 0),
+    0xBB: (0, 2, 2, 0), 0xBC: (2, 0, 2, 0), 0xBD: (2, 0, 1, 0), 0xBE: (1, 0, 2, 0),
+    0xBF: (0, 1, 1, 0), 0xC0: (1, 0, 0, 1), 0xC1: (1, 0, 1, 1), 0xC2: (0, 1, 1, 1),
+    0xC3: (1, 1, 0, 1), 0xC4: (0, 0, 1, 1), 0xC5: (1, 1, 1, 1), 0xC6: (1, 1, 0, 2),
+    0xC7: (2, 2, 0, 1), 0xC8: (2, 0, 0, 2), 0xC9: (0, 2, 0, 2), 0xCA: (2, 0, 2, 2),
+    0xCB: (0, 2, 2, 2), 0xCC: (2, 2, 0, 2), 0xCD: (0, 0, 2, 2), 0xCE: (2, 2, 2, 2),
+    0xCF: (1, 0, 2, 2), 0xD0: (2, 0, 1, 1), 0xD1: (0, 1, 2, 2), 0xD2: (0, 2, 1, 1),
+    0xD3: (2, 0, 0, 1), 0xD4: (1, 0, 0, 2), 0xD5: (0, 1, 0, 2), 0xD6: (0, 2, 0, 1),
+    0xD7: (2, 2, 1, 1), 0xD8: (1, 1, 2, 2), 0xD9: (1, 0, 1, 0), 0xDA: (0, 1, 0, 1),
+}
+
+
+def rows_from_drawing(text):
+    return [sum(1 << x for x, ch in enumerate(row) if ch == "#") for row in text.split()]
+
+
+def box_glyph(up, down, left, right):
+    """Single lines are 2px wide through the centre, double lines are 1px
+    lines on either side of it. A double arm is drawn as a band with its
+    middle carved out. A single arm reaches the far line of a double corner
+    but stops at the near line of a double that runs straight through."""
+    band, gap, single = set(), set(), set()
+    vertical = (up, down)
+    horizontal = (left, right)
+
+    # (weight, along the vertical axis, starts at the top/left edge,
+    #  opposite arm, crossed arms)
+    arms = ((up, True, True, down, horizontal), (down, True, False, up, horizontal),
+            (left, False, True, right, vertical), (right, False, False, left, vertical))
+    for weight, on_vertical, first, opposite, crossed in arms:
+        if not weight:
+            continue
+        crossed_double = 2 in crossed
+        lo, hi = (0, 5 if crossed_double else 4) if first else (2 if crossed_double else 3, 7)
+        if weight == 1 and crossed_double and not opposite and all(crossed):
+            lo, hi = (0, 2) if first else (5, 7)
+        for t in range(lo, hi + 1):
+            cells = range(2, 6) if weight == 2 else (3, 4)
+            target = band if weight == 2 else single
+            target.update((c, t) if on_vertical else (t, c) for c in cells)
+            # the gap stops short of the crossing double's outer line
+            if weight == 2 and not (crossed_double and t == (hi if first else lo)):
+                gap.update((c, t) if on_vertical else (t, c) for c in (3, 4))
+
+    rows = [0] * 8
+    for x, y in (band - gap) | single:
+        rows[y] |= 1 << x
+    return rows
+
+
+def build():
+    glyphs = [[0] * 8 for _ in range(256)]
+    for code, rows in ASCII.items():
+        glyphs[code] = rows
+    for code, rows in SYMBOLS.items():
+        glyphs[code] = rows
+    for code, text in DRAWN.items():
+        glyphs[code] = rows_from_drawing(text)
+    for code, (letter, accent) in COMPOSED.items():
+        base = DOTLESS_I if letter == "i" else ASCII[ord(letter)]
+        glyphs[code] = ACCENT[accent] + base[2:]
+    for code, arms in BOX.items():
+        glyphs[code] = box_glyph(*arms)
+    return glyphs
+
+
+def write_png(path, glyphs):
+    size = 16 * 8
+    raw = bytearray()
+    for y in range(size):
+        raw.append(0)
+        for x in range(size):
+            rows = glyphs[(y // 8) * 16 + x // 8]
+            lit = rows[y % 8] >> (x % 8) & 1
+            raw += bytes((255, 255, 255, 255)) if lit else bytes(4)
+
+    def chunk(tag, data):
+        return (struct.pack(">I", len(data)) + tag + data +
+                struct.pack(">I", zlib.crc32(tag + data) & 0xFFFFFFFF))
+
+    header = struct.pack(">IIBBBBB", size, size, 8, 6, 0, 0, 0)
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n" + chunk(b"IHDR", header) +
+                chunk(b"IDAT", zlib.compress(bytes(raw), 9)) + chunk(b"IEND", b""))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        sys.exit("usage: make_cp437_sheet.py OUT.png")
+    write_png(sys.argv[1], build())